@@ -0,0 +1,236 @@
+/**
+ * @brief AVR 사이클 벤치마크 진입점 (env:bench, simavr 에서 실행)
+ *
+ * Arduino 코어의 main() 은 setup() 전에 initVariant() 를 부르므로, 이 함수를 대신 정의하여
+ * 펌웨어의 setup()/loop() 와 명령/텔레메트리 경로를 그대로 호출하며 사이클과 스택을 잽니다.
+ * 결과는 UART0 에 {"bench":...} JSON 줄로 출력하고, 끝나면 인터럽트를 막고 sleep 하여
+ * simavr 를 종료시킵니다. scripts/avr_bench.py 가 출력을 모아 bench.json 으로 저장합니다.
+ *
+ * 실행 예) pio run -e bench -t bench
+ */
+#include <Arduino.h>
+#include <avr/interrupt.h>
+#include <avr/sleep.h>
+#include <SerialCommand.h>
+#include <SensorMonitor.h>
+#include "BenchProbe.h"
+
+// ===== 벤치마크 설정 =====
+#define BENCH_ITERATIONS 16          // 함수별 반복 측정 횟수
+#define BENCH_LOOP_ITERATIONS 2000   // loop() 측정 횟수 (만기 타이머가 있는 회차 포함)
+#define BENCH_COMMAND_LINE "W2.5"    // 파싱 벤치마크에 쓰는 명령 줄
+
+// ===== 펌웨어 전역 (src/main.cpp) =====
+extern SerialCommand serialCommand;
+extern SensorMonitor sensorMonitor;
+void sendSensorData(uint8_t reportBits, uint8_t changedBits);
+
+namespace {
+    BenchProbe probe;
+
+    /**
+     * @brief 반복 측정 결과 (최소/최대 사이클, 최대 스택)
+     */
+    struct BenchResult {
+        uint32_t minCycles;
+        uint32_t maxCycles;
+        uint32_t totalCycles;
+        uint16_t maxStack;
+        uint16_t iterations;
+    };
+
+    void resetResult(BenchResult& result) {
+        result.minCycles = 0xFFFFFFFFUL;
+        result.maxCycles = 0;
+        result.totalCycles = 0;
+        result.maxStack = 0;
+        result.iterations = 0;
+    }
+
+    void recordResult(BenchResult& result) {
+        uint32_t cycles = probe.getCycles();
+        if (cycles < result.minCycles) result.minCycles = cycles;
+        if (cycles > result.maxCycles) result.maxCycles = cycles;
+        result.totalCycles += cycles;
+        if (probe.getStackBytes() > result.maxStack) result.maxStack = probe.getStackBytes();
+        result.iterations++;
+    }
+
+    /**
+     * @brief 결과 한 줄 출력
+     * 예) {"bench":"extractValue","n":16,"min":1234,"max":1240,"avg":1236,"us":77.3,"stack":24}
+     */
+    void printResult(const __FlashStringHelper* name, const BenchResult& result) {
+        uint32_t average = result.iterations ? result.totalCycles / result.iterations : 0;
+        Serial.print(F("{\"bench\":\""));
+        Serial.print(name);
+        Serial.print(F("\",\"n\":"));
+        Serial.print(result.iterations);
+        Serial.print(F(",\"min\":"));
+        Serial.print(result.minCycles);
+        Serial.print(F(",\"max\":"));
+        Serial.print(result.maxCycles);
+        Serial.print(F(",\"avg\":"));
+        Serial.print(average);
+        Serial.print(F(",\"us\":"));
+        Serial.print(average / (F_CPU / 1000000.0f), 1);
+        Serial.print(F(",\"stack\":"));
+        Serial.print(result.maxStack);
+        Serial.println(F("}"));
+        Serial.flush();  // 다음 측정에 출력 전송이 섞이지 않게 합니다.
+    }
+
+    // ===== 개별 벤치마크 =====
+    // 순수 파싱 함수는 인터럽트를 막고 재어 매번 같은 사이클이 나오게 합니다.
+
+    void benchGetCommandType() {
+        BenchResult result;
+        resetResult(result);
+        for (uint8_t i = 0; i < BENCH_ITERATIONS; i++) {
+            cli();
+            probe.start();
+            volatile CommandType type = serialCommand.getCommandType(BENCH_COMMAND_LINE);
+            probe.stop();
+            sei();
+            (void)type;
+            recordResult(result);
+        }
+        printResult(F("getCommandType"), result);
+    }
+
+    void benchExtractValue() {
+        BenchResult result;
+        resetResult(result);
+        for (uint8_t i = 0; i < BENCH_ITERATIONS; i++) {
+            cli();
+            probe.start();
+            volatile float value = SerialCommand::extractValue(BENCH_COMMAND_LINE);
+            probe.stop();
+            sei();
+            (void)value;
+            recordResult(result);
+        }
+        printResult(F("extractValue"), result);
+    }
+
+    void benchValidateCommand() {
+        Command command = serialCommand.parseCommand(BENCH_COMMAND_LINE);
+        BenchResult result;
+        resetResult(result);
+        for (uint8_t i = 0; i < BENCH_ITERATIONS; i++) {
+            cli();
+            probe.start();
+            volatile bool isValid = serialCommand.validateCommand(command);
+            probe.stop();
+            sei();
+            (void)isValid;
+            recordResult(result);
+        }
+        printResult(F("validateCommand"), result);
+    }
+
+    void benchReadCommand() {
+        // simavr 에는 UART 입력을 넣는 경로가 없어서, readCommand() 는 수신 바이트가 없는 평상시 호출을 재고
+        // 줄이 완성되었을 때 readCommand() 가 부르는 parseCommand() 를 따로 잽니다.
+        BenchResult result;
+        resetResult(result);
+        for (uint8_t i = 0; i < BENCH_ITERATIONS; i++) {
+            cli();
+            probe.start();
+            Command command = serialCommand.readCommand();
+            probe.stop();
+            sei();
+            (void)command;
+            recordResult(result);
+        }
+        printResult(F("readCommand_idle"), result);
+
+        resetResult(result);
+        for (uint8_t i = 0; i < BENCH_ITERATIONS; i++) {
+            cli();
+            probe.start();
+            Command command = serialCommand.parseCommand(BENCH_COMMAND_LINE);
+            probe.stop();
+            sei();
+            (void)command;
+            recordResult(result);
+        }
+        printResult(F("readCommand_line"), result);
+    }
+
+    void benchSendSensorData() {
+        // 하트비트(전체 키) JSON 직렬화 + 송신 대기열에 쌓기. 대기열이 빈 상태에서 시작합니다.
+        BenchResult result;
+        resetResult(result);
+        for (uint8_t i = 0; i < BENCH_ITERATIONS; i++) {
+            serialCommand.getOutput().flush();
+            probe.start();
+            sendSensorData(sensorMonitor.getSensorMask(), 0);
+            probe.stop();
+            recordResult(result);
+        }
+        serialCommand.getOutput().flush();
+        printResult(F("sendSensorData"), result);
+    }
+
+    void benchLoop() {
+        // 만기 타이머가 없는 회차(최소)와 센서/하트비트 태스크가 도는 회차(최대)를 함께 봅니다.
+        BenchResult result;
+        resetResult(result);
+        for (uint16_t i = 0; i < BENCH_LOOP_ITERATIONS; i++) {
+            probe.start();
+            loop();
+            probe.stop();
+            recordResult(result);
+        }
+        serialCommand.getOutput().flush();
+        printResult(F("loop"), result);
+    }
+
+    void printMemory(uint16_t bootStackPeak) {
+        uint16_t staticSram = BenchProbe::getStaticSram();
+        Serial.print(F("{\"bench\":\"memory\",\"sram\":"));
+        Serial.print(RAMEND - RAMSTART + 1);
+        Serial.print(F(",\"static\":"));
+        Serial.print(staticSram);
+        Serial.print(F(",\"stack_peak\":"));
+        Serial.print(bootStackPeak);
+        Serial.print(F(",\"free\":"));
+        Serial.print((int)(RAMEND - RAMSTART + 1) - (int)staticSram - (int)bootStackPeak);
+        Serial.println(F("}"));
+        Serial.flush();
+    }
+}
+
+/**
+ * @brief Arduino 코어가 setup() 전에 호출하는 훅 (벤치마크 실행 후 돌아오지 않음)
+ */
+void initVariant() {
+    BenchProbe::paintAll();
+    setup();
+
+    // 측정 전에 loop() 를 충분히 돌려 부팅 직후 상태를 벗어나고, 그동안의 스택 최고치를 잽니다.
+    for (uint16_t i = 0; i < BENCH_LOOP_ITERATIONS; i++) {
+        loop();
+    }
+    uint16_t bootStackPeak = BenchProbe::getStackPeak();
+    serialCommand.getOutput().flush();  // 결과 줄이 펌웨어 출력과 섞이지 않게 합니다.
+
+    probe.begin();
+    benchGetCommandType();
+    benchExtractValue();
+    benchValidateCommand();
+    benchReadCommand();
+    benchSendSensorData();
+    benchLoop();
+    printMemory(bootStackPeak);
+    Serial.println(F("{\"bench\":\"done\"}"));
+    Serial.flush();
+
+    // 인터럽트를 막고 잠들면 simavr 가 시뮬레이션을 끝냅니다.
+    cli();
+    sleep_enable();
+    sleep_cpu();
+    for (;;) {
+    }
+}
@@ -0,0 +1,111 @@
+#include "BenchProbe.h"
+
+#include <avr/io.h>
+#include <avr/interrupt.h>
+
+extern uint8_t __heap_start;    // 링커 심볼: .bss 끝 (힙을 쓰지 않으므로 여기부터 스택 여유 공간)
+
+namespace {
+    volatile uint16_t timer1Overflows = 0;  // Timer1 오버플로 횟수 (사이클 상위 16비트)
+}
+
+ISR(TIMER1_OVF_vect) {
+    timer1Overflows++;
+}
+
+BenchProbe::BenchProbe()
+    : startCycles(0), startSp(0), cycles(0), stackBytes(0), overheadCycles(0), overheadStack(0) {
+}
+
+void BenchProbe::begin() {
+    // Timer1 일반 모드, 분주비 1 (16MHz 에서 1틱 = 1사이클). Timer1 은 펌웨어가 쓰지 않습니다
+    // (millis(): Timer0, 서보: Timer5, 분배 종료 타이머: Timer4).
+    uint8_t oldSreg = SREG;
+    cli();
+    TCCR1A = 0;
+    TCCR1B = _BV(CS10);
+    TCNT1 = 0;
+    TIFR1 = _BV(TOV1);
+    TIMSK1 = _BV(TOIE1);
+    timer1Overflows = 0;
+    SREG = oldSreg;
+
+    // 빈 구간을 여러 번 재어 가장 작은 값을 오버헤드로 씁니다.
+    overheadCycles = 0;
+    overheadStack = 0;
+    uint32_t minCycles = 0xFFFFFFFFUL;
+    uint16_t minStack = 0xFFFF;
+    for (uint8_t i = 0; i < 8; i++) {
+        start();
+        stop();
+        if (cycles < minCycles) minCycles = cycles;
+        if (stackBytes < minStack) minStack = stackBytes;
+    }
+    overheadCycles = minCycles;
+    overheadStack = minStack;
+}
+
+void BenchProbe::start() {
+    // 현재 SP 아래(BENCH_STACK_GUARD 만큼 띄움)부터 힙 시작까지 칠합니다.
+    startSp = SP;
+    uint8_t* end = (uint8_t*)(startSp - BENCH_STACK_GUARD);
+    for (uint8_t* p = &__heap_start; p < end; p++) {
+        *p = BENCH_STACK_PAINT;
+    }
+    startCycles = readCycles();
+}
+
+void BenchProbe::stop() {
+    uint32_t stopCycles = readCycles();
+    uint32_t elapsed = stopCycles - startCycles;
+    cycles = elapsed > overheadCycles ? elapsed - overheadCycles : 0;
+
+    uint16_t lowest = findLowestTouched();
+    uint16_t depth = lowest < startSp ? startSp - lowest : 0;
+    stackBytes = depth > overheadStack ? depth - overheadStack : 0;
+}
+
+uint32_t BenchProbe::getCycles() const {
+    return cycles;
+}
+
+uint16_t BenchProbe::getStackBytes() const {
+    return stackBytes;
+}
+
+uint32_t BenchProbe::readCycles() {
+    uint8_t oldSreg = SREG;
+    cli();
+    uint16_t low = TCNT1;
+    uint16_t high = timer1Overflows;
+    // 인터럽트를 막은 사이에 오버플로가 났으면 (플래그 대기 중, 카운터는 이미 0 근처) 한 번 더합니다.
+    if ((TIFR1 & _BV(TOV1)) && low < 0x8000) {
+        high++;
+    }
+    SREG = oldSreg;
+    return ((uint32_t)high << 16) | low;
+}
+
+uint16_t BenchProbe::getStaticSram() {
+    return (uint16_t)&__heap_start - RAMSTART;
+}
+
+void BenchProbe::paintAll() {
+    uint8_t* end = (uint8_t*)(SP - BENCH_STACK_GUARD);
+    for (uint8_t* p = &__heap_start; p < end; p++) {
+        *p = BENCH_STACK_PAINT;
+    }
+}
+
+uint16_t BenchProbe::getStackPeak() {
+    return RAMEND - findLowestTouched();
+}
+
+uint16_t BenchProbe::findLowestTouched() {
+    uint8_t* p = &__heap_start;
+    uint8_t* end = (uint8_t*)SP;
+    while (p < end && *p == BENCH_STACK_PAINT) {
+        p++;
+    }
+    return (uint16_t)p;
+}
@@ -0,0 +1,87 @@
+#ifndef BENCHPROBE_H
+#define BENCHPROBE_H
+
+#include <Arduino.h>
+
+// ===== 측정 설정 =====
+#define BENCH_STACK_PAINT 0xA5       // 스택 여유 공간을 칠하는 값 (이 값이 남아 있으면 사용되지 않은 바이트)
+#define BENCH_STACK_GUARD 16         // 칠하기 시작할 때 현재 SP 아래로 건너뛸 바이트 (칠하는 코드 자신의 스택)
+
+/**
+ * @brief AVR 사이클/스택 측정기 (env:bench 전용)
+ *
+ * Timer1 을 분주비 1 로 자유 실행시키고 오버플로를 세어 32비트 CPU 사이클 카운터를 만듭니다.
+ * start() 에서 힙 시작(__heap_start)부터 현재 SP 바로 아래까지를 BENCH_STACK_PAINT 로 칠하고,
+ * stop() 에서 가장 낮게 덮어쓴 주소를 찾아 측정 구간의 스택 최고 사용량을 구합니다.
+ * 측정 구간에서 실행된 인터럽트의 사이클과 스택도 함께 포함됩니다.
+ */
+class BenchProbe {
+public:
+    /**
+     * @brief 생성자
+     */
+    BenchProbe();
+
+    // ===== 초기화 메서드 =====
+    /**
+     * @brief Timer1 을 사이클 카운터로 설정하고 빈 구간의 측정 오버헤드를 잽니다
+     */
+    void begin();
+
+    // ===== 측정 메서드 =====
+    /**
+     * @brief 측정 시작 (스택 칠하기 후 사이클 기록)
+     */
+    void start();
+
+    /**
+     * @brief 측정 종료 (사이클 기록 후 스택 사용량 계산, 오버헤드는 뺌)
+     */
+    void stop();
+
+    /**
+     * @brief 마지막 측정 구간의 CPU 사이클
+     */
+    uint32_t getCycles() const;
+
+    /**
+     * @brief 마지막 측정 구간의 스택 최고 사용량 (바이트)
+     */
+    uint16_t getStackBytes() const;
+
+    /**
+     * @brief 현재 CPU 사이클 카운터 (오버플로 안전)
+     */
+    static uint32_t readCycles();
+
+    // ===== 메모리 조회 메서드 =====
+    /**
+     * @brief 정적 SRAM 사용량 (.data + .bss)
+     */
+    static uint16_t getStaticSram();
+
+    /**
+     * @brief 힙 시작부터 RAMEND 까지 전체를 칠합니다 (부팅 직후 한 번)
+     */
+    static void paintAll();
+
+    /**
+     * @brief paintAll() 이후 스택이 내려간 가장 깊은 지점까지의 사용량 (RAMEND 기준, 바이트)
+     */
+    static uint16_t getStackPeak();
+
+private:
+    /**
+     * @brief 힙 시작부터 가장 낮게 덮어쓴 주소 찾기
+     */
+    static uint16_t findLowestTouched();
+
+    uint32_t startCycles;       // 구간 시작 사이클
+    uint16_t startSp;           // 구간 시작 SP
+    uint32_t cycles;            // 마지막 구간 사이클
+    uint16_t stackBytes;        // 마지막 구간 스택 사용량
+    uint32_t overheadCycles;    // 빈 구간 측정값 (start/stop 호출 비용)
+    uint16_t overheadStack;     // 빈 구간 스택 사용량
+};
+
+#endif // BENCHPROBE_H
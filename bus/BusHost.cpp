@@ -0,0 +1,182 @@
+#include "BusHost.h"
+#include <SerialCommand.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+namespace {
+
+    const uint64_t POLL_MARGIN_US = 1000;   // 마지막 슬롯 뒤 늦은 응답을 기다리는 여유 (노드 loop() 지연)
+
+}  // namespace
+
+BusHost::BusHost(const BusHostConfig& config)
+    : config(config), result(), phase(PHASE_IDLE), round(0), readyUs(0), requestEndUs(0), deadlineUs(0),
+      lastStatusUs(0), statusSeen(config.nodeCount + 1, false), target(0), turnEnded(false),
+      nextSequence(1), rxGarbled(false) {
+    // BusLink 와 같이 바이트 시간을 올림하여 슬롯 길이를 계산합니다.
+    uint64_t firmwareByteUs = (BUS_BITS_PER_BYTE * 1000000ULL + config.baudRate - 1) / config.baudRate;
+    slotUs = BUS_GUARD_US + BUS_SLOT_BYTES * firmwareByteUs;
+}
+
+void BusHost::update(uint64_t now, VirtualBus& bus) {
+    // ===== 응답 수신 =====
+    uint8_t c;
+    while (bus.hostRead(now, c)) {
+        if (readyUs < now + config.turnaroundUs) {
+            readyUs = now + config.turnaroundUs;
+        }
+        if (c == '\n') {
+            if (!rxGarbled) {
+                handleLine(rxText, now);
+            } else {
+                result.garbledLines++;
+                if (config.trace) {
+                    fprintf(stderr, "[%12.3f ms] << (garbled) %s\n", now / 1000.0, rxText.c_str());
+                }
+            }
+            rxText.clear();
+            rxGarbled = false;
+        } else if (c == BUS_GARBLED_BYTE) {
+            rxGarbled = true;
+        } else if (c != '\r') {
+            rxText += (char)c;
+        }
+    }
+
+    // ===== 다음 요청 =====
+    switch (phase) {
+        case PHASE_IDLE:
+            if (now >= readyUs) {
+                std::string poll = std::string(1, BUS_ADDRESS_PREFIX) + BUS_BROADCAST_CHAR + " " + CMD_PREFIX_STATUS + "\n";
+                requestEndUs = bus.hostSend(poll, now);
+                deadlineUs = requestEndUs + getPollBudgetUs() + bus.getByteMicros() + POLL_MARGIN_US;
+                statusSeen.assign(config.nodeCount + 1, false);
+                lastStatusUs = 0;
+                result.polls++;
+                phase = PHASE_POLL;
+                if (config.trace) {
+                    fprintf(stderr, "[%12.3f ms] >> %s", now / 1000.0, poll.c_str());
+                }
+            }
+            break;
+
+        case PHASE_POLL:
+            if (now >= deadlineUs) {
+                finishPoll();
+                target = 1;
+                turnEnded = false;
+                if (config.commandText.empty()) {
+                    target = config.nodeCount + 1;
+                }
+                phase = PHASE_UNICAST;
+                deadlineUs = 0;
+            }
+            break;
+
+        case PHASE_UNICAST:
+            if (deadlineUs != 0) {
+                if (!turnEnded && now < deadlineUs) {
+                    break;
+                }
+                if (!turnEnded) {
+                    result.timeouts++;
+                }
+                target++;
+                deadlineUs = 0;
+            }
+            if (target > config.nodeCount) {
+                round++;
+                phase = round >= config.rounds ? PHASE_FINISHED : PHASE_IDLE;
+                readyUs = now + config.roundGapUs;
+            } else if (now >= readyUs) {
+                sendUnicast(now, bus);
+            }
+            break;
+
+        case PHASE_FINISHED:
+            break;
+    }
+}
+
+bool BusHost::isFinished() const {
+    return phase == PHASE_FINISHED;
+}
+
+uint64_t BusHost::getPollBudgetUs() const {
+    return (uint64_t)config.nodeCount * slotUs;
+}
+
+const BusHostResult& BusHost::getResult() const {
+    return result;
+}
+
+void BusHost::handleLine(const std::string& line, uint64_t now) {
+    if (config.trace) {
+        fprintf(stderr, "[%12.3f ms] << %s\n", now / 1000.0, line.c_str());
+    }
+
+    // 노드의 차례 표시/상태 응답: "#N,END", "#N,P,FF,BB,SS,QQ"
+    if (!line.empty() && line[0] == BUS_RESPONSE_PREFIX) {
+        char* rest = nullptr;
+        unsigned long node = strtoul(line.c_str() + 1, &rest, 10);
+        if (node == 0 || node > config.nodeCount || *rest != ',') {
+            return;
+        }
+        rest++;
+        if (strcmp(rest, "END") == 0) {
+            if (phase == PHASE_UNICAST && node == target && deadlineUs != 0 && !turnEnded) {
+                turnEnded = true;
+                result.turnsEnded++;
+                result.turnaroundUs.push_back((double)(now - requestEndUs));
+            }
+        } else if (rest[0] == CMD_PREFIX_STATUS && rest[1] == ',' && phase == PHASE_POLL) {
+            if (!statusSeen[node]) {
+                statusSeen[node] = true;
+                result.statusReplies++;
+                lastStatusUs = now;
+                if (strtoul(rest + 2, nullptr, 16) & NODE_STATUS_BUSY) {
+                    result.busyReplies++;
+                }
+            }
+        }
+        return;
+    }
+
+    if (line.compare(0, 4, "ACK,") == 0) {
+        result.acks++;
+    } else if (line.compare(0, 5, "DONE,") == 0) {
+        result.done++;
+    } else if (line.compare(0, 5, "FAIL,") == 0 || line.compare(0, 4, "NAK,") == 0) {
+        result.failed++;
+    } else if (line.compare(0, 5, "ERROR") == 0) {
+        result.errors++;
+    }
+}
+
+void BusHost::finishPoll() {
+    uint8_t replies = 0;
+    for (uint8_t node = 1; node <= config.nodeCount; node++) {
+        if (statusSeen[node]) {
+            replies++;
+        }
+    }
+    if (replies == config.nodeCount) {
+        result.completePolls++;
+        result.pollCycleUs.push_back((double)(lastStatusUs - requestEndUs));
+    }
+}
+
+void BusHost::sendUnicast(uint64_t now, VirtualBus& bus) {
+    if (nextSequence == 0) {
+        nextSequence = 1;  // 0 은 순서 번호 없음
+    }
+    char line[96];
+    snprintf(line, sizeof(line), "%c%u %u:%s\n", BUS_ADDRESS_PREFIX, target, nextSequence++, config.commandText.c_str());
+    requestEndUs = bus.hostSend(line, now);
+    deadlineUs = requestEndUs + config.timeoutUs;
+    turnEnded = false;
+    result.unicasts++;
+    if (config.trace) {
+        fprintf(stderr, "[%12.3f ms] >> %s", now / 1000.0, line);
+    }
+}
@@ -0,0 +1,100 @@
+#ifndef BUSHOST_H
+#define BUSHOST_H
+
+#include "VirtualBus.h"
+#include <string>
+#include <vector>
+
+/**
+ * @brief 버스 호스트 설정
+ */
+struct BusHostConfig {
+    uint8_t nodeCount;          // 버스의 노드 수 (주소 1 ~ N)
+    uint32_t baudRate;
+    uint32_t rounds;            // 방송 상태 폴링 + 노드별 1:1 명령을 한 바퀴로 반복할 횟수
+    std::string commandText;    // 노드마다 보낼 명령 (빈 문자열: 폴링만)
+    uint32_t timeoutUs;         // 1:1 요청 뒤 차례 끝(#N,END)을 기다리는 시간
+    uint32_t turnaroundUs;      // 마지막 수신 바이트 뒤 호스트가 송신을 시작하기까지의 시간
+    uint32_t roundGapUs;        // 바퀴 사이 쉬는 시간
+    bool trace;                 // 버스 내용을 표준 에러로 출력
+};
+
+/**
+ * @brief 버스 호스트 결과
+ */
+struct BusHostResult {
+    uint32_t polls;
+    uint32_t completePolls;             // 모든 노드의 상태를 받은 폴링 수
+    uint32_t statusReplies;
+    uint32_t busyReplies;               // NODE_STATUS_BUSY 가 켜진 상태 응답 수
+    std::vector<double> pollCycleUs;    // 모든 상태를 받은 폴링: 폴링 요청 끝 → 마지막 상태 도착
+    uint32_t unicasts;
+    uint32_t turnsEnded;                // #N,END 를 받은 1:1 요청 수
+    uint32_t timeouts;
+    std::vector<double> turnaroundUs;   // 요청 끝 → #N,END 도착
+    uint32_t acks;
+    uint32_t done;
+    uint32_t failed;                    // FAIL/NAK
+    uint32_t errors;                    // ERROR
+    uint32_t garbledLines;              // 충돌로 깨진 바이트가 섞인 줄
+};
+
+/**
+ * @brief 가상 버스의 스크립트 호스트 (마스터)
+ *
+ * 한 바퀴마다 "@* P" 로 방송 상태 폴링을 보내고 모든 슬롯이 지날 때까지 "#N,P,..." 응답을 모은 뒤,
+ * 노드마다 "@N 순서:명령" 을 보내고 그 노드의 "#N,END" 를 받으면 다음 노드로 넘어갑니다.
+ */
+class BusHost {
+public:
+    explicit BusHost(const BusHostConfig& config);
+
+    /**
+     * @brief 응답 수신과 다음 요청 전송 (가상 버스 한 걸음마다 호출)
+     * @param now 현재 시각
+     * @param bus 가상 버스
+     */
+    void update(uint64_t now, VirtualBus& bus);
+
+    /**
+     * @brief 모든 바퀴를 마쳤는지 확인
+     */
+    bool isFinished() const;
+
+    /**
+     * @brief 폴링 한 번이 끝나는 시각 (요청 끝 기준, 마지막 슬롯 끝)
+     */
+    uint64_t getPollBudgetUs() const;
+
+    const BusHostResult& getResult() const;
+
+private:
+    enum Phase : uint8_t {
+        PHASE_IDLE,         // 다음 바퀴 대기
+        PHASE_POLL,         // 상태 응답 수집 중
+        PHASE_UNICAST,      // 1:1 요청 전송/차례 끝 대기
+        PHASE_FINISHED
+    };
+
+    void handleLine(const std::string& line, uint64_t now);
+    void finishPoll();
+    void sendUnicast(uint64_t now, VirtualBus& bus);
+
+    BusHostConfig config;
+    BusHostResult result;
+    Phase phase;
+    uint32_t round;
+    uint64_t slotUs;                    // 노드 하나의 상태 응답 슬롯 (펌웨어와 같은 계산)
+    uint64_t readyUs;                   // 호스트가 다음 요청을 보낼 수 있는 시각
+    uint64_t requestEndUs;              // 마지막 요청이 끝난 시각
+    uint64_t deadlineUs;                // 폴링 슬롯 끝 또는 1:1 요청 제한 시간
+    uint64_t lastStatusUs;
+    std::vector<bool> statusSeen;       // 이번 폴링에서 상태를 받은 노드
+    uint8_t target;                     // 1:1 요청 중인 노드
+    bool turnEnded;
+    uint16_t nextSequence;
+    std::string rxText;                 // 수신 중인 줄
+    bool rxGarbled;
+};
+
+#endif // BUSHOST_H
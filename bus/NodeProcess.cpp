@@ -0,0 +1,336 @@
+#include "NodeProcess.h"
+#include <NativeHAL.h>
+#include <SerialCommand.h>
+#include "Pin.h"
+
+#include <deque>
+#include <signal.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+void setup();
+void loop();
+extern SerialCommand serialCommand;
+
+namespace {
+
+    const uint16_t STEP_FINISH = 0xFFFF;    // 종료 요청 (StepCommand::count)
+
+    struct StepCommand {
+        uint64_t untilUs;
+        uint16_t count;                     // 뒤따르는 수신 바이트 수
+    };
+
+    struct StepReply {
+        uint16_t sentCount;                 // 뒤따르는 WireByte 수
+        uint16_t edgeCount;                 // 그 뒤의 DriverEdge 수
+    };
+
+    struct StartReply {
+        uint64_t startMicros;
+        uint8_t ok;
+    };
+
+    bool readAll(int fd, void* buffer, size_t size) {
+        uint8_t* p = static_cast<uint8_t*>(buffer);
+        while (size > 0) {
+            ssize_t n = read(fd, p, size);
+            if (n <= 0) {
+                return false;
+            }
+            p += n;
+            size -= (size_t)n;
+        }
+        return true;
+    }
+
+    bool writeAll(int fd, const void* buffer, size_t size) {
+        const uint8_t* p = static_cast<const uint8_t*>(buffer);
+        while (size > 0) {
+            ssize_t n = write(fd, p, size);
+            if (n <= 0) {
+                return false;
+            }
+            p += n;
+            size -= (size_t)n;
+        }
+        return true;
+    }
+
+    // ===== 자식 프로세스 쪽 상태 =====
+    // 시리얼 송신 처리 함수와 loop() 사이에서 공유합니다 (자식 프로세스마다 하나).
+    struct OwnByte {
+        uint64_t startUs;
+        bool flagged;                       // 이미 DE 없이 나간 바이트로 셌음
+    };
+
+    struct NodeTap {
+        bool capture;                       // false: 설정 중 (1:1 연결 응답은 버림)
+        uint64_t byteUs;
+        uint64_t lineFreeUs;                // 자기 송신이 끝나는 시각
+        uint8_t level;                      // 마지막으로 본 DE 레벨
+        char endLine[12];                   // 차례 끝 줄 ("#N,END")
+        char line[12];                      // 지금 보내는 줄의 앞부분
+        uint8_t lineLength;
+        bool ended;                         // 차례 끝을 보냈고 다음 차례가 아직 시작되지 않음
+        bool released;                      // 차례 끝 뒤에 DE 가 내려간 적 있음
+        std::vector<WireByte> sent;
+        std::vector<DriverEdge> edges;
+        std::deque<OwnByte> onWire;         // 아직 선로에 있는 자기 바이트
+        NodeReport report;
+    };
+
+    NodeTap tap;
+
+    // 보낸 줄이 차례 끝인지 확인합니다.
+    void tapLine(uint8_t c) {
+        if (c == '\n') {
+            tap.line[tap.lineLength] = '\0';
+            if (strcmp(tap.line, tap.endLine) == 0) {
+                tap.ended = true;
+                tap.released = false;
+            }
+            tap.lineLength = 0;
+        } else if (c != '\r' && tap.lineLength < sizeof(tap.line) - 1) {
+            tap.line[tap.lineLength++] = (char)c;
+        }
+    }
+
+    // 차례 끝 뒤에 DE 가 내려갔다 다시 오르면 다음 차례가 시작된 것입니다.
+    void watchTurn() {
+        if (!tap.ended) {
+            return;
+        }
+        if (NativeHAL::getOutputLevel(PIN_BUS_ENABLE) == LOW) {
+            tap.released = true;
+        } else if (tap.released) {
+            tap.ended = false;
+        }
+    }
+
+    void tapByte(uint8_t c, void*) {
+        // NativeHAL 송신 버퍼가 바이트를 선로에 내보내는 시각에 불립니다.
+        uint64_t start = NativeHAL::nowMicros();
+        tap.lineFreeUs = start + tap.byteUs;
+        if (!tap.capture) {
+            return;
+        }
+        watchTurn();
+        if (tap.ended) {
+            tap.report.afterEndBytes++;
+        }
+        tapLine(c);
+        tap.sent.push_back({ start, c });
+        tap.onWire.push_back({ start, false });
+    }
+
+    // loop() 1회 뒤의 DE 레벨로 [now, now + durationUs) 구간을 계산합니다.
+    void sampleDriver(uint64_t now, uint64_t durationUs) {
+        uint8_t level = (uint8_t)NativeHAL::getOutputLevel(PIN_BUS_ENABLE);
+        if (level != tap.level) {
+            tap.level = level;
+            tap.edges.push_back({ now, level });
+        }
+        watchTurn();
+
+        while (!tap.onWire.empty() && tap.onWire.front().startUs + tap.byteUs <= now) {
+            tap.onWire.pop_front();
+        }
+        bool sending = false;
+        for (OwnByte& own : tap.onWire) {
+            if (own.startUs >= now + durationUs) {
+                break;
+            }
+            sending = true;
+            if (level == LOW && !own.flagged && own.startUs <= now) {
+                own.flagged = true;
+                tap.report.undrivenBytes++;
+            }
+        }
+
+        if (level == HIGH) {
+            tap.report.driverHighUs += durationUs;
+            if (!sending) {
+                tap.report.driverIdleUs += durationUs;
+            }
+        }
+    }
+
+    void runUntil(uint64_t untilUs, unsigned long tickUs) {
+        while (NativeHAL::nowMicros() < untilUs) {
+            uint64_t now = NativeHAL::nowMicros();
+            uint64_t duration = untilUs - now < tickUs ? untilUs - now : tickUs;
+            loop();
+            if (tap.capture) {
+                sampleDriver(NativeHAL::nowMicros(), duration);
+            }
+            NativeHAL::advanceMicros((unsigned long)duration);
+        }
+    }
+
+    void sendPrivately(const char* line, unsigned long tickUs) {
+        NativeHAL::feedSerial(line, strlen(line));
+        runUntil(NativeHAL::nowMicros() + 100000UL, tickUs);
+    }
+
+    void setByteTime(uint32_t baudRate) {
+        tap.byteUs = 10000000ULL / baudRate;
+    }
+
+}  // namespace
+
+NodeProcess::NodeProcess(uint8_t address)
+    : address(address), pid(-1), commandFd(-1), reportFd(-1), startMicros(0) {
+}
+
+NodeProcess::~NodeProcess() {
+    if (commandFd >= 0) {
+        close(commandFd);
+    }
+    if (reportFd >= 0) {
+        close(reportFd);
+    }
+    if (pid > 0) {
+        waitpid(pid, nullptr, 0);
+    }
+}
+
+bool NodeProcess::start(uint32_t baudRate, unsigned long tickUs) {
+    int toChild[2];
+    int toParent[2];
+    if (pipe(toChild) != 0 || pipe(toParent) != 0) {
+        return false;
+    }
+    signal(SIGPIPE, SIG_IGN);
+    fflush(stdout);
+
+    pid = fork();
+    if (pid < 0) {
+        return false;
+    }
+    if (pid == 0) {
+        close(toChild[1]);
+        close(toParent[0]);
+        runChild(toChild[0], toParent[1], address, baudRate, tickUs);
+        _exit(0);
+    }
+
+    close(toChild[0]);
+    close(toParent[1]);
+    commandFd = toChild[1];
+    reportFd = toParent[0];
+
+    StartReply reply;
+    if (!readAll(reportFd, &reply, sizeof(reply))) {
+        return false;
+    }
+    startMicros = reply.startMicros;
+    return reply.ok != 0;
+}
+
+uint64_t NodeProcess::getStartMicros() const {
+    return startMicros;
+}
+
+bool NodeProcess::beginStep(uint64_t untilUs, const std::vector<uint8_t>& received) {
+    StepCommand command = { untilUs, (uint16_t)received.size() };
+    return writeAll(commandFd, &command, sizeof(command)) && writeAll(commandFd, received.data(), received.size());
+}
+
+bool NodeProcess::endStep(std::vector<WireByte>& sent, std::vector<DriverEdge>& edges) {
+    StepReply reply;
+    if (!readAll(reportFd, &reply, sizeof(reply))) {
+        return false;
+    }
+    size_t sentStart = sent.size();
+    size_t edgeStart = edges.size();
+    sent.resize(sentStart + reply.sentCount);
+    edges.resize(edgeStart + reply.edgeCount);
+    return readAll(reportFd, sent.data() + sentStart, reply.sentCount * sizeof(WireByte)) &&
+           readAll(reportFd, edges.data() + edgeStart, reply.edgeCount * sizeof(DriverEdge));
+}
+
+bool NodeProcess::finish(NodeReport& report) {
+    StepCommand command = { 0, STEP_FINISH };
+    bool ok = writeAll(commandFd, &command, sizeof(command)) && readAll(reportFd, &report, sizeof(report));
+    close(commandFd);
+    close(reportFd);
+    commandFd = -1;
+    reportFd = -1;
+    waitpid(pid, nullptr, 0);
+    pid = -1;
+    return ok;
+}
+
+uint8_t NodeProcess::getAddress() const {
+    return address;
+}
+
+void NodeProcess::runChild(int commandFd, int reportFd, uint8_t address, uint32_t baudRate, unsigned long tickUs) {
+    // ===== 1:1 연결로 설정 (버스에 붙기 전, 응답은 버림) =====
+    NativeHAL::reset();
+    NativeHAL::setSerialSink(tapByte, nullptr);
+    tap.capture = false;
+    tap.lineFreeUs = 0;
+    setByteTime(serialCommand.getBaudRate());
+    setup();
+    runUntil(NativeHAL::nowMicros() + 20000UL, tickUs);
+
+    char line[24];
+    if (serialCommand.getBaudRate() != baudRate) {
+        snprintf(line, sizeof(line), "Y%lu\n", (unsigned long)baudRate);
+        sendPrivately(line, tickUs);
+        setByteTime(baudRate);
+        sendPrivately("Y\n", tickUs);
+    }
+    snprintf(line, sizeof(line), "A%u\n", address);
+    sendPrivately(line, tickUs);
+
+    // 부팅 메시지와 설정 응답이 다 나가고 DE 가 내려간 뒤 버스에 참여합니다 (부모가 가장 늦은 노드에 맞춤).
+    while (tap.lineFreeUs > NativeHAL::nowMicros() || NativeHAL::getOutputLevel(PIN_BUS_ENABLE) == HIGH) {
+        runUntil(NativeHAL::nowMicros() + tickUs, tickUs);
+    }
+    StartReply start = { NativeHAL::nowMicros(), 0 };
+    start.ok = serialCommand.isMultiDrop() && serialCommand.getNodeAddress() == address &&
+               serialCommand.getBaudRate() == baudRate && !serialCommand.isBaudPending();
+    if (!writeAll(reportFd, &start, sizeof(start)) || !start.ok) {
+        return;
+    }
+
+    snprintf(tap.endLine, sizeof(tap.endLine), "%c%u,END", BUS_RESPONSE_PREFIX, address);
+    tap.lineLength = 0;
+    tap.ended = false;
+    tap.capture = true;
+    tap.level = (uint8_t)NativeHAL::getOutputLevel(PIN_BUS_ENABLE);
+
+    // ===== 부모가 지시하는 걸음만큼 실행 =====
+    std::vector<uint8_t> received;
+    StepCommand command;
+    while (readAll(commandFd, &command, sizeof(command))) {
+        if (command.count == STEP_FINISH) {
+            tap.report.bus = serialCommand.getBusStats();
+            writeAll(reportFd, &tap.report, sizeof(tap.report));
+            return;
+        }
+        received.resize(command.count);
+        if (!readAll(commandFd, received.data(), received.size())) {
+            return;
+        }
+        if (!received.empty()) {
+            NativeHAL::feedSerial(reinterpret_cast<const char*>(received.data()), received.size());
+        }
+
+        tap.sent.clear();
+        tap.edges.clear();
+        runUntil(command.untilUs, tickUs);
+
+        StepReply reply = { (uint16_t)tap.sent.size(), (uint16_t)tap.edges.size() };
+        if (!writeAll(reportFd, &reply, sizeof(reply)) ||
+            !writeAll(reportFd, tap.sent.data(), tap.sent.size() * sizeof(WireByte)) ||
+            !writeAll(reportFd, tap.edges.data(), tap.edges.size() * sizeof(DriverEdge))) {
+            return;
+        }
+    }
+}
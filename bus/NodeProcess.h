@@ -0,0 +1,99 @@
+#ifndef NODEPROCESS_H
+#define NODEPROCESS_H
+
+#include <Arduino.h>
+#include <BusLink.h>
+#include <sys/types.h>
+#include <vector>
+
+/**
+ * @brief 노드가 선로에 내보낸 바이트 한 개
+ */
+struct WireByte {
+    uint64_t startUs;           // 선로에 나가기 시작한 시각 (앞 바이트가 끝난 뒤)
+    uint8_t value;
+};
+
+/**
+ * @brief 송신 허용(DE) 핀 변화
+ */
+struct DriverEdge {
+    uint64_t timeUs;
+    uint8_t level;              // HIGH 또는 LOW
+};
+
+/**
+ * @brief 노드 실행 결과 (시뮬레이션 종료 시)
+ */
+struct NodeReport {
+    uint32_t undrivenBytes;     // DE 가 내려간 동안 선로에 있던 자기 바이트 수
+    uint32_t afterEndBytes;     // #N,END 를 보낸 뒤 다음 차례 전까지 보낸 바이트 수
+    uint64_t driverHighUs;      // DE 를 올리고 있던 시간
+    uint64_t driverIdleUs;      // DE 를 올린 채 아무 바이트도 보내지 않은 시간 (다른 노드를 막는 시간)
+    BusStats bus;               // 펌웨어 BusLink 통계
+};
+
+/**
+ * @brief 가상 버스에 붙은 펌웨어 인스턴스 하나 (자식 프로세스)
+ *
+ * 펌웨어는 전역 객체를 쓰므로 한 프로세스에 하나만 돌릴 수 있어, 노드마다 fork 하여
+ * setup()/loop() 를 가상 시간으로 실행합니다. 부모는 파이프로 한 걸음씩 "이 시각까지 실행"을
+ * 지시하고 그동안 버스에서 들은 바이트를 넘기며, 자식은 그동안 보낸 바이트와 DE 변화를 돌려줍니다.
+ * 모든 노드가 같은 걸음으로 움직이므로 가상 시간이 노드 사이에 어긋나지 않습니다.
+ */
+class NodeProcess {
+public:
+    /**
+     * @brief 생성자
+     * @param address 노드 주소 (1 ~ BUS_ADDRESS_MAX)
+     */
+    explicit NodeProcess(uint8_t address);
+    ~NodeProcess();
+
+    /**
+     * @brief 자식 프로세스 시작: 1:1 연결로 통신 속도와 주소를 설정한 뒤 버스에 참여
+     * @param baudRate 버스 통신 속도
+     * @param tickUs loop() 1회당 진행할 가상 시간
+     * @return 설정까지 성공하면 true
+     */
+    bool start(uint32_t baudRate, unsigned long tickUs);
+
+    /**
+     * @brief 버스 참여 시각 (설정을 마친 가상 시각)
+     */
+    uint64_t getStartMicros() const;
+
+    /**
+     * @brief 지정한 시각까지 실행 시작 (모든 노드에 지시한 뒤 endStep 으로 결과를 받아 병렬로 실행)
+     * @param untilUs 실행을 멈출 가상 시각
+     * @param received 이번 걸음에 버스에서 들은 바이트
+     * @return 자식과 통신에 성공하면 true
+     */
+    bool beginStep(uint64_t untilUs, const std::vector<uint8_t>& received);
+
+    /**
+     * @brief 실행 결과 받기
+     * @param sent 이번 걸음에 보낸 바이트 (추가됨)
+     * @param edges 이번 걸음의 DE 변화 (추가됨)
+     * @return 자식과 통신에 성공하면 true
+     */
+    bool endStep(std::vector<WireByte>& sent, std::vector<DriverEdge>& edges);
+
+    /**
+     * @brief 실행 결과를 받고 자식 프로세스 종료
+     */
+    bool finish(NodeReport& report);
+
+    uint8_t getAddress() const;
+
+private:
+    static void runChild(int commandFd, int reportFd, uint8_t address, uint32_t baudRate, unsigned long tickUs);
+
+    uint8_t address;
+    pid_t pid;
+    int commandFd;              // 부모 → 자식
+    int reportFd;               // 자식 → 부모
+    uint64_t startMicros;
+};
+
+#endif // NODEPROCESS_H
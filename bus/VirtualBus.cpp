@@ -0,0 +1,142 @@
+#include "VirtualBus.h"
+#include <algorithm>
+
+VirtualBus::VirtualBus(uint8_t nodeCount, uint32_t baudRate)
+    : nodeCount(nodeCount), byteUs(10000000ULL / baudRate), hostLineFreeUs(0),
+      driverLevels(nodeCount + 1, LOW), driversHigh(0), sweepUs(0), nodeRx(nodeCount + 1) {
+    stats = { 0, 0, 0, 0 };
+}
+
+uint64_t VirtualBus::getByteMicros() const {
+    return byteUs;
+}
+
+uint64_t VirtualBus::hostSend(const std::string& text, uint64_t now) {
+    uint64_t start = hostLineFreeUs > now ? hostLineFreeUs : now;
+    addEdge(BUS_HOST_DRIVER, start, HIGH);
+    for (char c : text) {
+        addTransfer(BUS_HOST_DRIVER, start, (uint8_t)c);
+        start += byteUs;
+    }
+    addEdge(BUS_HOST_DRIVER, start, LOW);
+    hostLineFreeUs = start;
+    return start;
+}
+
+void VirtualBus::addNodeTraffic(uint8_t driver, const std::vector<WireByte>& sent,
+                                const std::vector<DriverEdge>& edges) {
+    for (const WireByte& byte : sent) {
+        addTransfer(driver, byte.startUs, byte.value);
+    }
+    for (const DriverEdge& edge : edges) {
+        addEdge(driver, edge.timeUs, edge.level);
+    }
+}
+
+void VirtualBus::settle(uint64_t stepEndUs) {
+    sweepDrivers(stepEndUs);
+
+    // 이번 걸음 안에 시작된 바이트는 다음 걸음에 수신자의 RX 선으로 들어갑니다 (도착은 한 바이트 시간 뒤).
+    for (Transfer& transfer : transfers) {
+        if (transfer.startUs >= stepEndUs) {
+            break;
+        }
+        if (transfer.delivered) {
+            continue;
+        }
+        transfer.delivered = true;
+        stats.bytes++;
+        uint8_t value = transfer.collided ? BUS_GARBLED_BYTE : transfer.value;
+        for (uint8_t node = 1; node <= nodeCount; node++) {
+            if (node != transfer.driver) {
+                nodeRx[node].push_back(value);
+            }
+        }
+        if (transfer.driver != BUS_HOST_DRIVER) {
+            hostRx.push_back(std::make_pair(transfer.startUs + byteUs, value));
+        }
+    }
+
+    // 다음 걸음의 바이트는 stepEndUs 이후에 시작하므로, 그 전에 끝난 바이트와는 겹칠 수 없습니다.
+    while (!transfers.empty() && transfers.front().delivered && transfers.front().startUs + byteUs <= stepEndUs) {
+        transfers.pop_front();
+    }
+}
+
+std::vector<uint8_t>& VirtualBus::receivedBy(uint8_t driver) {
+    return nodeRx[driver];
+}
+
+bool VirtualBus::hostRead(uint64_t now, uint8_t& c) {
+    if (hostRx.empty() || hostRx.front().first > now) {
+        return false;
+    }
+    c = hostRx.front().second;
+    hostRx.pop_front();
+    return true;
+}
+
+const WireStats& VirtualBus::getStats() const {
+    return stats;
+}
+
+void VirtualBus::addTransfer(uint8_t driver, uint64_t startUs, uint8_t value) {
+    Transfer transfer = { startUs, driver, value, false, false };
+    for (Transfer& other : transfers) {
+        if (other.driver == driver || other.startUs >= startUs + byteUs || startUs >= other.startUs + byteUs) {
+            continue;
+        }
+        if (!other.collided) {
+            other.collided = true;
+            stats.collisions++;
+        }
+        if (!transfer.collided) {
+            transfer.collided = true;
+            stats.collisions++;
+        }
+    }
+
+    auto position = transfers.end();
+    while (position != transfers.begin() && (position - 1)->startUs > startUs) {
+        --position;
+    }
+    transfers.insert(position, transfer);
+}
+
+void VirtualBus::addEdge(uint8_t driver, uint64_t timeUs, uint8_t level) {
+    pendingEdges.push_back({ timeUs, driver, level });
+}
+
+void VirtualBus::sweepDrivers(uint64_t untilUs) {
+    std::stable_sort(pendingEdges.begin(), pendingEdges.end(),
+                     [](const Edge& a, const Edge& b) { return a.timeUs < b.timeUs; });
+
+    size_t applied = 0;
+    while (applied <= pendingEdges.size()) {
+        bool done = applied == pendingEdges.size() || pendingEdges[applied].timeUs >= untilUs;
+        uint64_t timeUs = done ? untilUs : pendingEdges[applied].timeUs;
+        if (timeUs > sweepUs) {
+            if (driversHigh >= 2) {
+                stats.contentionUs += timeUs - sweepUs;
+            }
+            sweepUs = timeUs;
+        }
+        if (done) {
+            break;
+        }
+
+        const Edge& edge = pendingEdges[applied++];
+        if (edge.level == driverLevels[edge.driver]) {
+            continue;
+        }
+        driverLevels[edge.driver] = edge.level;
+        if (edge.level == HIGH) {
+            if (++driversHigh == 2) {
+                stats.contentions++;
+            }
+        } else {
+            driversHigh--;
+        }
+    }
+    pendingEdges.erase(pendingEdges.begin(), pendingEdges.begin() + applied);
+}
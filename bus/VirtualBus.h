@@ -0,0 +1,109 @@
+#ifndef VIRTUALBUS_H
+#define VIRTUALBUS_H
+
+#include "NodeProcess.h"
+#include <deque>
+#include <string>
+#include <vector>
+
+#define BUS_HOST_DRIVER 0           // 송신자 번호 0: 호스트, 1 ~ N: 노드 (주소와 같음)
+#define BUS_GARBLED_BYTE 0x00       // 충돌한 바이트 대신 수신자에게 전달하는 값
+
+/**
+ * @brief 선로 통계
+ */
+struct WireStats {
+    uint64_t bytes;                 // 선로에 나간 바이트 수
+    uint32_t collisions;            // 다른 송신자의 바이트와 시간이 겹친 바이트 수
+    uint32_t contentions;           // 둘 이상이 DE 를 동시에 올린 횟수
+    uint64_t contentionUs;          // 둘 이상이 DE 를 동시에 올리고 있던 시간
+};
+
+/**
+ * @brief RS-485 반이중 선로 모델 (호스트 + 노드 N 개)
+ *
+ * 송신자마다 바이트가 선로를 점유하는 시간 구간과 DE 변화를 받아, 다른 송신자와 겹친 바이트를
+ * 충돌로 세고 깨진 값으로 전달합니다. 각 바이트는 보낸 쪽을 뺀 모든 노드가 듣고(DE 와 /RE 를
+ * 묶은 트랜시버), 호스트는 바이트가 끝나는 시각에 받습니다.
+ */
+class VirtualBus {
+public:
+    /**
+     * @brief 생성자
+     * @param nodeCount 노드 수
+     * @param baudRate 통신 속도
+     */
+    VirtualBus(uint8_t nodeCount, uint32_t baudRate);
+
+    /**
+     * @brief 바이트 하나의 선로 점유 시간
+     */
+    uint64_t getByteMicros() const;
+
+    /**
+     * @brief 호스트 송신 (선로가 비는 대로 연달아 나감, 그동안 호스트 DE 를 올림)
+     * @param text 보낼 문자열
+     * @param now 현재 시각
+     * @return 마지막 바이트가 끝나는 시각
+     */
+    uint64_t hostSend(const std::string& text, uint64_t now);
+
+    /**
+     * @brief 노드가 한 걸음 동안 보낸 바이트와 DE 변화 추가
+     */
+    void addNodeTraffic(uint8_t driver, const std::vector<WireByte>& sent, const std::vector<DriverEdge>& edges);
+
+    /**
+     * @brief 한 걸음 마무리: 충돌/DE 겹침 계산, 시작된 바이트를 수신자에게 전달
+     * @param stepEndUs 이번 걸음이 끝나는 시각
+     */
+    void settle(uint64_t stepEndUs);
+
+    /**
+     * @brief 노드가 다음 걸음에 받을 바이트 (호출한 쪽이 비움)
+     */
+    std::vector<uint8_t>& receivedBy(uint8_t driver);
+
+    /**
+     * @brief 호스트에 도착한 바이트 하나 꺼내기
+     * @param now 현재 시각
+     * @param c 꺼낸 바이트
+     * @return 도착한 바이트가 있으면 true
+     */
+    bool hostRead(uint64_t now, uint8_t& c);
+
+    const WireStats& getStats() const;
+
+private:
+    struct Transfer {
+        uint64_t startUs;
+        uint8_t driver;
+        uint8_t value;
+        bool collided;
+        bool delivered;
+    };
+
+    struct Edge {
+        uint64_t timeUs;
+        uint8_t driver;
+        uint8_t level;
+    };
+
+    void addTransfer(uint8_t driver, uint64_t startUs, uint8_t value);
+    void addEdge(uint8_t driver, uint64_t timeUs, uint8_t level);
+    void sweepDrivers(uint64_t untilUs);
+
+    uint8_t nodeCount;
+    uint64_t byteUs;
+    uint64_t hostLineFreeUs;                    // 호스트 송신이 끝나는 시각
+    std::deque<Transfer> transfers;             // 아직 끝나지 않았거나 전달하지 않은 바이트 (시작 시각 순)
+    std::vector<Edge> pendingEdges;             // 아직 반영하지 않은 DE 변화
+    std::vector<uint8_t> driverLevels;          // 송신자별 현재 DE
+    uint8_t driversHigh;                        // DE 를 올린 송신자 수
+    uint64_t sweepUs;                           // DE 겹침을 계산한 시각
+    std::vector<std::vector<uint8_t>> nodeRx;   // 노드별 다음 걸음에 받을 바이트
+    std::deque<std::pair<uint64_t, uint8_t>> hostRx;  // 호스트 도착 시각, 값
+    WireStats stats;
+};
+
+#endif // VIRTUALBUS_H
@@ -0,0 +1,238 @@
+/**
+ * @brief 멀티드롭 버스 시뮬레이터 진입점 (env:bus)
+ *
+ * 펌웨어 인스턴스 N 개(노드 주소 1 ~ N)를 자식 프로세스로 띄워 하나의 가상 RS-485 선로에 묶고,
+ * 스크립트 호스트가 방송 상태 폴링과 노드별 1:1 명령을 반복합니다. 모든 노드와 선로는 한 바이트
+ * 시간 간격의 같은 걸음으로 가상 시간을 진행하며, 선로 모델이 송신 바이트가 겹친 충돌,
+ * 여러 노드가 동시에 DE 를 올린 구간, DE 없이 나간 바이트를 셉니다.
+ *
+ * 실행 예)
+ *   .pio/build/bus/program --nodes 8 --rounds 20
+ *   .pio/build/bus/program --nodes 4 --baud 9600 --command "R1" --json
+ *   .pio/build/bus/program --nodes 2 --rounds 1 --trace
+ */
+#include <Arduino.h>
+#include <SerialCommand.h>
+#include "BusHost.h"
+#include "NodeProcess.h"
+#include "VirtualBus.h"
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+
+namespace {
+
+    struct BusOptions {
+        unsigned long tickUs;       // 노드 loop() 1회당 진행할 가상 시간
+        bool json;                  // 결과를 JSON 한 줄로 출력
+    };
+
+    void printUsage(const char* program) {
+        fprintf(stderr,
+                "usage: %s [options]\n"
+                "  --nodes N          firmware instances on the bus, addresses 1..N (default 4)\n"
+                "  --baud B           bus baud rate, set on each node with Y before joining (default 115200)\n"
+                "  --rounds N         broadcast status polls, each followed by one command per node (default 10)\n"
+                "  --command TEXT     command sent to every node each round, \"\" = poll only (default U0.5)\n"
+                "  --timeout-ms MS    wait for a node's #N,END before moving on (default 500)\n"
+                "  --turnaround-us US host delay after the last received byte before sending (default 100)\n"
+                "  --round-gap-ms MS  idle time between rounds (default 600)\n"
+                "  --tick-us US       virtual time per node loop() iteration (default 20)\n"
+                "  --trace            print bus traffic to stderr\n"
+                "  --json             print one JSON result line\n",
+                program);
+    }
+
+    double percentile(std::vector<double> values, double p) {
+        if (values.empty()) {
+            return 0.0;
+        }
+        std::sort(values.begin(), values.end());
+        size_t index = (size_t)(p / 100.0 * (values.size() - 1) + 0.5);
+        return values[index];
+    }
+
+    double mean(const std::vector<double>& values) {
+        double sum = 0.0;
+        for (double value : values) {
+            sum += value;
+        }
+        return values.empty() ? 0.0 : sum / values.size();
+    }
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    BusOptions options = { 20, false };
+    BusHostConfig host = { 4, 115200, 10, "U0.5", 500000, 100, 600000, false };
+
+    for (int i = 1; i < argc; i++) {
+        const char* arg = argv[i];
+        const char* value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+        bool hasValue = true;
+        if (strcmp(arg, "--nodes") == 0 && value) {
+            host.nodeCount = (uint8_t)std::min(std::max(1, atoi(value)), 64);
+        } else if (strcmp(arg, "--baud") == 0 && value) {
+            host.baudRate = (uint32_t)strtoul(value, nullptr, 10);
+        } else if (strcmp(arg, "--rounds") == 0 && value) {
+            host.rounds = (uint32_t)std::max(1, atoi(value));
+        } else if (strcmp(arg, "--command") == 0 && value) {
+            host.commandText = value;
+        } else if (strcmp(arg, "--timeout-ms") == 0 && value) {
+            host.timeoutUs = (uint32_t)(atof(value) * 1000.0);
+        } else if (strcmp(arg, "--turnaround-us") == 0 && value) {
+            host.turnaroundUs = (uint32_t)strtoul(value, nullptr, 10);
+        } else if (strcmp(arg, "--round-gap-ms") == 0 && value) {
+            host.roundGapUs = (uint32_t)(atof(value) * 1000.0);
+        } else if (strcmp(arg, "--tick-us") == 0 && value) {
+            options.tickUs = std::max(1UL, strtoul(value, nullptr, 10));
+        } else {
+            hasValue = false;
+            if (strcmp(arg, "--trace") == 0) {
+                host.trace = true;
+            } else if (strcmp(arg, "--json") == 0) {
+                options.json = true;
+            } else {
+                printUsage(argv[0]);
+                return 2;
+            }
+        }
+        if (hasValue) {
+            i++;
+        }
+    }
+    if (!SerialCommand::isSupportedBaudRate(host.baudRate)) {
+        fprintf(stderr, "unsupported baud rate: %lu\n", (unsigned long)host.baudRate);
+        return 2;
+    }
+
+    // ===== 노드 시작 (각자 1:1 연결로 속도와 주소를 설정한 뒤 버스에 참여) =====
+    auto wallStart = std::chrono::steady_clock::now();
+    std::vector<std::unique_ptr<NodeProcess>> nodes;
+    uint64_t startUs = 0;
+    for (uint8_t address = 1; address <= host.nodeCount; address++) {
+        nodes.emplace_back(new NodeProcess(address));
+        if (!nodes.back()->start(host.baudRate, options.tickUs)) {
+            fprintf(stderr, "node %u failed to join the bus\n", address);
+            return 1;
+        }
+        startUs = std::max(startUs, nodes.back()->getStartMicros());
+    }
+
+    // ===== 가상 버스 실행 =====
+    VirtualBus bus(host.nodeCount, host.baudRate);
+    BusHost busHost(host);
+    const uint64_t stepUs = std::min<uint64_t>(std::max<uint64_t>(bus.getByteMicros(), 20), 1000);
+    const uint64_t roundLimitUs = host.roundGapUs + busHost.getPollBudgetUs() +
+                                  (uint64_t)host.nodeCount * (host.timeoutUs + 100000ULL) + 1000000ULL;
+    const uint64_t endUs = startUs + host.rounds * roundLimitUs;
+
+    uint64_t now = startUs;
+    std::vector<WireByte> sent;
+    std::vector<DriverEdge> edges;
+    while (!busHost.isFinished() && now < endUs) {
+        busHost.update(now, bus);
+        uint64_t stepEndUs = now + stepUs;
+        // 모든 노드에 먼저 지시하여 자식 프로세스들이 동시에 실행되게 합니다.
+        for (std::unique_ptr<NodeProcess>& node : nodes) {
+            std::vector<uint8_t>& received = bus.receivedBy(node->getAddress());
+            if (!node->beginStep(stepEndUs, received)) {
+                fprintf(stderr, "node %u stopped responding\n", node->getAddress());
+                return 1;
+            }
+            received.clear();
+        }
+        for (std::unique_ptr<NodeProcess>& node : nodes) {
+            sent.clear();
+            edges.clear();
+            if (!node->endStep(sent, edges)) {
+                fprintf(stderr, "node %u stopped responding\n", node->getAddress());
+                return 1;
+            }
+            bus.addNodeTraffic(node->getAddress(), sent, edges);
+        }
+        bus.settle(stepEndUs);
+        now = stepEndUs;
+    }
+
+    NodeReport total = {};
+    for (std::unique_ptr<NodeProcess>& node : nodes) {
+        NodeReport report;
+        if (!node->finish(report)) {
+            fprintf(stderr, "node %u did not report\n", node->getAddress());
+            return 1;
+        }
+        total.undrivenBytes += report.undrivenBytes;
+        total.afterEndBytes += report.afterEndBytes;
+        total.driverHighUs += report.driverHighUs;
+        total.driverIdleUs += report.driverIdleUs;
+        total.bus.windows += report.bus.windows;
+        total.bus.slots += report.bus.slots;
+        total.bus.lateSlots += report.bus.lateSlots;
+        total.bus.filtered += report.bus.filtered;
+    }
+
+    double wallSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - wallStart).count();
+    double virtualSeconds = (now - startUs) / 1.0e6;
+    double speedup = wallSeconds > 0 ? virtualSeconds / wallSeconds : 0.0;
+
+    // ===== 결과 =====
+    const BusHostResult& result = busHost.getResult();
+    const WireStats& wire = bus.getStats();
+    uint32_t turns = total.bus.windows + total.bus.slots;
+    double idleHoldUs = turns ? (double)total.driverIdleUs / turns : 0.0;
+
+    if (options.json) {
+        printf("{\"nodes\":%u,\"baud\":%lu,\"rounds\":%u,\"command\":\"%s\",\"virtual_s\":%.2f,"
+               "\"poll\":{\"sent\":%u,\"complete\":%u,\"replies\":%u,\"busy\":%u,"
+               "\"cycle_ms\":{\"mean\":%.3f,\"max\":%.3f},\"slots_ms\":%.3f},"
+               "\"unicast\":{\"sent\":%u,\"ended\":%u,\"timeouts\":%u,"
+               "\"turnaround_ms\":{\"p50\":%.3f,\"p99\":%.3f,\"max\":%.3f}},"
+               "\"ack\":%u,\"done\":%u,\"fail\":%u,\"error\":%u,\"garbled\":%u,"
+               "\"wire\":{\"bytes\":%llu,\"collisions\":%u,\"contentions\":%u,\"contention_us\":%llu},"
+               "\"undriven\":%u,\"after_end\":%u,\"late_slots\":%u,\"filtered\":%u,\"de_idle_hold_us\":%.1f,\"speedup\":%.0f}\n",
+               host.nodeCount, (unsigned long)host.baudRate, host.rounds, host.commandText.c_str(), virtualSeconds,
+               result.polls, result.completePolls, result.statusReplies, result.busyReplies,
+               mean(result.pollCycleUs) / 1000.0, percentile(result.pollCycleUs, 100) / 1000.0,
+               busHost.getPollBudgetUs() / 1000.0,
+               result.unicasts, result.turnsEnded, result.timeouts,
+               percentile(result.turnaroundUs, 50) / 1000.0, percentile(result.turnaroundUs, 99) / 1000.0,
+               percentile(result.turnaroundUs, 100) / 1000.0,
+               result.acks, result.done, result.failed, result.errors, result.garbledLines,
+               (unsigned long long)wire.bytes, wire.collisions, wire.contentions,
+               (unsigned long long)wire.contentionUs,
+               total.undrivenBytes, total.afterEndBytes, total.bus.lateSlots, total.bus.filtered, idleHoldUs, speedup);
+        return 0;
+    }
+
+    printf("nodes            : %u @ %lu baud (status slot %.2f ms: guard %.1f ms + %u bytes)\n",
+           host.nodeCount, (unsigned long)host.baudRate, busHost.getPollBudgetUs() / 1000.0 / host.nodeCount,
+           BUS_GUARD_US / 1000.0, BUS_SLOT_BYTES);
+    printf("rounds           : %u, command \"%s\"\n", host.rounds, host.commandText.c_str());
+    printf("virtual time     : %.2f s (wall %.2f s, %.0fx real time)\n", virtualSeconds, wallSeconds, speedup);
+    printf("status poll      : %u/%u replies, %u/%u complete, busy %u\n",
+           result.statusReplies, result.polls * host.nodeCount, result.completePolls, result.polls,
+           result.busyReplies);
+    printf("poll cycle (ms)  : mean %.3f  max %.3f  (request end -> last status, last slot ends at %.3f)\n",
+           mean(result.pollCycleUs) / 1000.0, percentile(result.pollCycleUs, 100) / 1000.0,
+           busHost.getPollBudgetUs() / 1000.0);
+    if (!host.commandText.empty()) {
+        printf("unicast turns    : %u/%u ended, %u timed out\n", result.turnsEnded, result.unicasts, result.timeouts);
+        printf("turnaround (ms)  : p50 %.3f  p99 %.3f  max %.3f  (request end -> #N,END)\n",
+               percentile(result.turnaroundUs, 50) / 1000.0, percentile(result.turnaroundUs, 99) / 1000.0,
+               percentile(result.turnaroundUs, 100) / 1000.0);
+    }
+    printf("replies          : ACK %u, DONE %u, FAIL/NAK %u, ERROR %u, garbled lines %u\n",
+           result.acks, result.done, result.failed, result.errors, result.garbledLines);
+    printf("wire             : %llu bytes, collisions %u, DE contention %u (%llu us)\n",
+           (unsigned long long)wire.bytes, wire.collisions, wire.contentions,
+           (unsigned long long)wire.contentionUs);
+    printf("transceivers     : undriven bytes %u, bytes after END %u, DE held idle %.1f us per turn, late slots %u, filtered %u\n",
+           total.undrivenBytes, total.afterEndBytes, idleHoldUs, total.bus.lateSlots, total.bus.filtered);
+    return 0;
+}
@@ -0,0 +1,111 @@
+#ifndef CHANNELS_H
+#define CHANNELS_H
+
+#include <SerialCommand.h>
+#include "Pin.h"
+
+// ===== 분배 채널 설명자 =====
+#define CHANNEL_NO_PIN 0xFF
+
+enum ActuatorKind {
+    ACTUATOR_SERVO,      // 서보 게이트 (열림/닫힘 각도)
+    ACTUATOR_PUMP        // 릴레이 펌프 (ON/OFF)
+};
+
+enum SensorKind {
+    SENSOR_NONE,         // 센서 없음
+    SENSOR_STOCK,        // 레이저 + 조도 센서 재고 감지
+    SENSOR_FLOAT         // 플로트 스위치 수위 감지
+};
+
+/**
+ * @brief 분배 채널 설명자 (컴파일 타임 상수 테이블의 한 항목)
+ */
+struct ChannelConfig {
+    CommandType type;        // 명령 타입 (테이블 순서와 일치)
+    char prefix;             // 명령 접두사 (대문자)
+    const char* name;        // 표시 이름 (응답 메시지용)
+    ActuatorKind actuator;   // 액추에이터 종류
+    uint8_t actuatorPin;     // 서보/릴레이 핀
+    SensorKind sensor;       // 센서 종류
+    uint8_t sensorPin;       // 조도 센서/플로트 스위치 핀
+    uint8_t laserPin;        // 레이저 핀 (SENSOR_STOCK 전용)
+    uint8_t openAngle;       // 분배 중 서보 각도
+    uint8_t closedAngle;     // 대기 중 서보 각도
+    float maxDuration;       // 최대 작동 시간 (초)
+    bool needsVibration;     // 분배 중 DC 모터(진동) 사용 여부
+    bool checksStock;        // 시작 전 재고 확인 여부
+    const char* telemetryKey;// 센서 데이터 JSON 키 (센서 없으면 nullptr)
+    const char* unit;        // 분배량 단위 (보정/수량 명령용, 예: "g", "ml")
+};
+
+// ===== 분배 채널 설정 테이블 =====
+// 명령 접두사, 액추에이터/센서 핀, 서보 각도, 최대 시간, 진동 사용 여부를 채널별로 정의합니다.
+// 항목 순서는 CommandType 순서(COMMAND_SUGAR ~ COMMAND_CUP)와 같아야 하며,
+// 명령 타입으로 CHANNELS[type - CHANNEL_FIRST_COMMAND] 를 바로 조회합니다.
+//
+//  type, 접두사, 이름, 액추에이터, 액추에이터 핀, 센서, 센서 핀, 레이저 핀,
+//  열림 각도, 닫힘 각도, 최대 시간(초), 진동 사용, 재고 확인, 센서 데이터 키, 분배량 단위
+constexpr ChannelConfig CHANNELS[] = {
+    { COMMAND_SUGAR,    'S', "Sugar",    ACTUATOR_SERVO, 5,  SENSOR_STOCK, 8,  7,
+      0,   30, 10.0f, true,  true,  "sugar",           "g" },
+    { COMMAND_WATER,    'W', "Water",    ACTUATOR_PUMP,  4,  SENSOR_FLOAT, 2,  CHANNEL_NO_PIN,
+      0,   0,  30.0f, true,  false, "water",           "ml" },
+    { COMMAND_COFFEE,   'C', "Coffee",   ACTUATOR_SERVO, 6,  SENSOR_STOCK, 10, 9,
+      0,   30, 10.0f, true,  true,  "coffee_powder",   "g" },
+    { COMMAND_ICEDTEA,  'I', "IcedTea",  ACTUATOR_SERVO, 11, SENSOR_STOCK, 13, 12,
+      0,   30, 10.0f, true,  true,  "iced_tea_powder", "g" },
+    { COMMAND_GREENTEA, 'G', "GreenTea", ACTUATOR_SERVO, 14, SENSOR_STOCK, 16, 15,
+      0,   20, 10.0f, true,  true,  "green_tea",       "g" },
+    { COMMAND_CUP,      'U', "Cup",      ACTUATOR_SERVO, 3,  SENSOR_NONE,  CHANNEL_NO_PIN, CHANNEL_NO_PIN,
+      180, 0,  10.0f, false, false, nullptr,           "pcs" },
+};
+
+/**
+ * @brief 명령 타입의 채널 설정 (컴파일 타임 조회)
+ * @param type 분배 채널 명령 타입
+ */
+constexpr const ChannelConfig& channelConfig(CommandType type) {
+    return CHANNELS[type - CHANNEL_FIRST_COMMAND];
+}
+
+/**
+ * @brief 테이블 항목이 CommandType 순서대로 작성되었는지 확인
+ */
+constexpr bool isChannelTableOrdered(uint8_t index = 0) {
+    return index >= CHANNEL_COUNT ||
+           (CHANNELS[index].type == CHANNEL_FIRST_COMMAND + index && isChannelTableOrdered(index + 1));
+}
+
+static_assert(sizeof(CHANNELS) / sizeof(CHANNELS[0]) == CHANNEL_COUNT, "CHANNELS must cover every dispense channel");
+static_assert(isChannelTableOrdered(), "CHANNELS must be ordered by CommandType");
+
+// ===== 종류별 채널 수 (하드웨어 객체 배열 크기와 배열 안 순번) =====
+/**
+ * @brief 앞쪽 end 개 채널 중 액추에이터가 kind 인 채널 수
+ */
+constexpr uint8_t countActuators(ActuatorKind kind, uint8_t end = CHANNEL_COUNT) {
+    return end == 0 ? 0 : countActuators(kind, end - 1) + (CHANNELS[end - 1].actuator == kind ? 1 : 0);
+}
+
+/**
+ * @brief 앞쪽 end 개 채널 중 센서가 kind 인 채널 수
+ */
+constexpr uint8_t countSensors(SensorKind kind, uint8_t end = CHANNEL_COUNT) {
+    return end == 0 ? 0 : countSensors(kind, end - 1) + (CHANNELS[end - 1].sensor == kind ? 1 : 0);
+}
+
+#define SERVO_CHANNEL_COUNT countActuators(ACTUATOR_SERVO)
+#define PUMP_CHANNEL_COUNT countActuators(ACTUATOR_PUMP)
+#define STOCK_CHANNEL_COUNT countSensors(SENSOR_STOCK)
+#define FLOAT_CHANNEL_COUNT countSensors(SENSOR_FLOAT)
+
+// ===== 센서 데이터 전송 순서 =====
+// JSON 키 순서와 바이너리 텔레메트리 비트 순서 (비트 i = TELEMETRY_ORDER[i])
+constexpr CommandType TELEMETRY_ORDER[] = {
+    COMMAND_SUGAR, COMMAND_COFFEE, COMMAND_ICEDTEA, COMMAND_GREENTEA, COMMAND_WATER
+};
+
+#define TELEMETRY_CHANNEL_COUNT (sizeof(TELEMETRY_ORDER) / sizeof(TELEMETRY_ORDER[0]))
+
+#endif
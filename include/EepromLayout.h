@@ -0,0 +1,23 @@
+#ifndef EEPROMLAYOUT_H
+#define EEPROMLAYOUT_H
+
+// ===== EEPROM 영역 배치 (ATmega2560: 4096 바이트) =====
+// 영역을 옮기거나 크기를 바꾸면 기존 장비에 저장된 값은 초기화됩니다.
+
+// 채널별 분배량 보정값 (Calibration)
+#define EEPROM_CALIBRATION_ADDRESS 0
+#define EEPROM_CALIBRATION_SIZE    64   // 헤더 3 + float 4 × 최대 8채널 = 35 바이트 사용
+
+// 누적 사용량 스냅샷 링 (DispenseJournal, 64 바이트 × 4칸)
+#define EEPROM_COUNTERS_ADDRESS    64
+#define EEPROM_COUNTERS_SIZE       256
+
+// 분배 기록 링 (DispenseJournal, 16 바이트 × 192칸)
+#define EEPROM_JOURNAL_ADDRESS     320
+#define EEPROM_JOURNAL_SIZE        3072
+
+// 시리얼 통신 설정 (SerialCommand: 매직, 버전, 확정된 uint32 속도, 멀티드롭 노드 주소)
+#define EEPROM_LINK_ADDRESS        3392
+#define EEPROM_LINK_SIZE           8
+
+#endif
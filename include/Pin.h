@@ -2,27 +2,7 @@
 #define PIN_H
 
 // ===== 핀 정의 =====
-#define PIN_CUP_SERVO 3
-
-#define PIN_SUGAR_SERVO        5
-#define PIN_SUGAR_LASER        7
-#define PIN_SUGAR_SENSOR       8
-
-#define PIN_COFFEE_SERVO       6
-#define PIN_COFFEE_LASER       9
-#define PIN_COFFEE_SENSOR      10
-
-#define PIN_ICEDTEA_SERVO      11
-#define PIN_ICEDTEA_LASER      12
-#define PIN_ICEDTEA_SENSOR     13
-
-#define PIN_GREENTEA_SERVO     14
-#define PIN_GREENTEA_LASER     15
-#define PIN_GREENTEA_SENSOR    16
-
-#define PIN_WATER_PUMP         4
-#define PIN_WATER_FLOAT_SWITCH 2
-
+// 분배 채널(설탕, 물, 커피, 아이스티, 녹차, 컵)의 핀은 Channels.h 의 CHANNELS 테이블에 정의합니다.
 #define PIN_DC_MOTOR          17
 
 // ===== 서보 모터 각도 설정 =====
@@ -30,18 +10,32 @@
 // #define SERVO_ANGLE_OPEN 90           // 서보 모터 열림 각도 
 
 // ===== 타이밍 설정 =====
-#define INTERVAL_SENSOR_READING 1000  // 센서 읽기 주기 (밀리초)
+#define INTERVAL_SENSOR_SAMPLE 10        // 센서 샘플링 주기 (밀리초, 디바운스 단위)
+#define INTERVAL_SENSOR_REPORT 1000      // 스냅샷 모드(기본)의 전체 센서 상태 전송 주기 (밀리초)
+#define INTERVAL_SENSOR_HEARTBEAT 5000   // 이벤트 모드에서 변경이 없을 때 전체 센서 상태 전송 주기 (밀리초)
+#define INTERVAL_ACTUATOR_UPDATE 5       // 서보 동작 프로파일/펌프 램프 갱신 주기 (밀리초)
+
+// ===== 태스크 시간 예산 (마이크로초, 초과 횟수는 T 명령으로 조회) =====
+#define TASK_BUDGET_SENSOR 300           // 센서 뱅크 샘플
+#define TASK_BUDGET_TELEMETRY 4000       // 센서 변경/하트비트 전송 (JSON 직렬화 포함)
+#define TASK_BUDGET_SERIAL_RX 2000       // 명령 수신 (예산 안에서 여러 줄 처리)
+#define TASK_BUDGET_ACTUATORS 1000       // 서보/펌프 프로파일 갱신
+#define TASK_BUDGET_CHANNEL 1500         // 채널별 분배 진행 (완료 응답 전송 포함)
+#define TASK_BUDGET_DISPATCH 2000        // 대기열/레시피 단계 시작
+#define TASK_BUDGET_JOURNAL 1000         // 분배 기록 EEPROM 쓰기 및 덤프 전송
+#define TASK_BUDGET_SERIAL_TX 500        // 송신 대기열 → 하드웨어 송신 버퍼
+
+// ===== 물 펌프 유량 설정 (PWM 핀에서만 적용) =====
+#define WATER_PUMP_SOFT_START_MS 200     // 0에서 최대 유량까지 올리는 시간 (밀리초)
+#define WATER_PUMP_SOFT_STOP_MS 50       // 정지 시 유량을 줄이는 시간 (밀리초)
+#define WATER_PUMP_FINISH_DUTY 96        // 마무리 구간 듀티 (0-255, 튀지 않는 유량)
+#define WATER_PUMP_FINISH_MS 1000        // 마무리 구간 길이 (밀리초)
 
 // ===== 시리얼 통신 설정 =====
-#define BAUD_RATE_SERIAL 9600
-
-// ===== 명령 접두사 =====
-#define CMD_PREFIX_SUGAR 'S'
-#define CMD_PREFIX_WATER 'W'
-#define CMD_PREFIX_COFFEE 'C'
-#define CMD_PREFIX_ICEDTEA 'I'
-#define CMD_PREFIX_GREENTEA 'G'
-#define CMD_PREFIX_DC_MOTOR  'D'
+#define BAUD_RATE_SERIAL 9600            // 기본 통신 속도 (Y 명령으로 더 빠른 속도 협상, 실패 시 복귀)
+#define PIN_BUS_ENABLE 22                // RS-485 트랜시버 DE/RE 핀 (송신 중 HIGH, 노드 주소를 정하면 멀티드롭 버스로 사용)
+#define JOURNAL_DUMP_LINE_RESERVE 112    // 분배 기록 덤프 한 줄을 보내기 전에 필요한 응답 대기열 여유 (한 줄 + 다른 응답 몫, 바이트)
+#define STATS_REPORT_LINE_RESERVE 208    // 실행 시간 통계 한 줄을 보내기 전에 필요한 응답 대기열 여유 (가장 긴 줄 + 다른 응답 몫, 바이트)
 
 // ===== 재고 상태 문자열 (JSON 값으로 사용) =====
 #define STR_STOCK_HIGH "High"
@@ -0,0 +1,47 @@
+#ifndef RECIPES_H
+#define RECIPES_H
+
+#include <RecipeRunner.h>
+
+// ===== 레시피 테이블 =====
+// 각 단계: { 시작 시각, 명령 타입, 실행 시간 }  (시간 단위: 1/100초)
+// 단계는 시작 시각 오름차순으로 작성합니다. 같은 채널의 단계가 겹치면 앞 단계가 끝난 뒤 시작합니다.
+// 컵(COMMAND_CUP) 단계는 다른 단계와 겹치지 않고 단독으로 실행됩니다.
+// COMMAND_DC_MOTOR 단계는 진동 모터로 교반합니다.
+
+// R1: 커피
+const RecipeStep RECIPE_COFFEE_STEPS[] PROGMEM = {
+    {    0, COMMAND_CUP,      150 },
+    {  150, COMMAND_COFFEE,   200 },
+    {  150, COMMAND_SUGAR,    100 },
+    {  150, COMMAND_WATER,    800 },
+    {  950, COMMAND_DC_MOTOR, 300 },
+};
+
+// R2: 아이스티
+const RecipeStep RECIPE_ICEDTEA_STEPS[] PROGMEM = {
+    {    0, COMMAND_CUP,      150 },
+    {  150, COMMAND_ICEDTEA,  300 },
+    {  150, COMMAND_WATER,    800 },
+    {  950, COMMAND_DC_MOTOR, 300 },
+};
+
+// R3: 녹차
+const RecipeStep RECIPE_GREENTEA_STEPS[] PROGMEM = {
+    {    0, COMMAND_CUP,      150 },
+    {  150, COMMAND_GREENTEA, 200 },
+    {  150, COMMAND_WATER,    800 },
+    {  950, COMMAND_DC_MOTOR, 200 },
+};
+
+#define RECIPE_STEP_COUNT(steps) (uint8_t)(sizeof(steps) / sizeof(steps[0]))
+
+const Recipe RECIPES[] PROGMEM = {
+    { 1, RECIPE_COFFEE_STEPS,   RECIPE_STEP_COUNT(RECIPE_COFFEE_STEPS) },
+    { 2, RECIPE_ICEDTEA_STEPS,  RECIPE_STEP_COUNT(RECIPE_ICEDTEA_STEPS) },
+    { 3, RECIPE_GREENTEA_STEPS, RECIPE_STEP_COUNT(RECIPE_GREENTEA_STEPS) },
+};
+
+#define RECIPE_COUNT (uint8_t)(sizeof(RECIPES) / sizeof(RECIPES[0]))
+
+#endif // RECIPES_H
@@ -0,0 +1,80 @@
+#include "BatchRunner.h"
+
+BatchRunner::BatchRunner()
+    : stepCount(0), running(false), nextStepIndex(0), activeGroup(0) {
+}
+
+void BatchRunner::clear() {
+    stepCount = 0;
+    running = false;
+    nextStepIndex = 0;
+    activeGroup = 0;
+}
+
+bool BatchRunner::addStep(const BatchStep& step) {
+    if (running || stepCount >= BATCH_MAX_STEPS) {
+        return false;
+    }
+    steps[stepCount++] = step;
+    return true;
+}
+
+void BatchRunner::start() {
+    if (stepCount == 0) {
+        return;
+    }
+    running = true;
+    nextStepIndex = 0;
+    activeGroup = steps[0].group;
+}
+
+bool BatchRunner::getDueStep(bool previousGroupDone, BatchStep& step) {
+    if (!running || isAllStepsStarted()) {
+        return false;
+    }
+    
+    const BatchStep& next = steps[nextStepIndex];
+    if (next.group != activeGroup) {
+        if (!previousGroupDone) {
+            return false;
+        }
+        activeGroup = next.group;
+    }
+    
+    step = next;
+    return true;
+}
+
+void BatchRunner::advance() {
+    if (running && !isAllStepsStarted()) {
+        nextStepIndex++;
+    }
+}
+
+void BatchRunner::stop() {
+    clear();
+}
+
+bool BatchRunner::isLoaded() const {
+    return stepCount > 0;
+}
+
+bool BatchRunner::isRunning() const {
+    return running;
+}
+
+bool BatchRunner::isAllStepsStarted() const {
+    return nextStepIndex >= stepCount;
+}
+
+uint8_t BatchRunner::getStepCount() const {
+    return stepCount;
+}
+
+const BatchStep& BatchRunner::getStep(uint8_t index) const {
+    return steps[index < stepCount ? index : 0];
+}
+
+uint8_t BatchRunner::getNextStepIndex() const {
+    return nextStepIndex;
+}
@@ -0,0 +1,101 @@
+#ifndef BATCHRUNNER_H
+#define BATCHRUNNER_H
+
+#include <Arduino.h>
+#include <SerialCommand.h>
+
+/**
+ * @brief 여러 단계 명령 줄 실행기 ("U1.5;S1+C2+W8;D3")
+ *
+ * 검증을 마친 단계들을 보관했다가 그룹 순서대로 내보냅니다.
+ * 같은 그룹의 단계는 채널이 비는 대로 바로 시작하고, 다음 그룹은 앞 그룹이 모두 끝난 뒤 시작합니다.
+ * RecipeRunner 와 같이 액추에이터를 직접 제어하지 않으며, 호출 측이 채널 상태를 확인한 뒤
+ * 단계를 시작하고 advance()로 다음 단계로 넘어갑니다. 한 번에 한 줄만 보관합니다.
+ */
+class BatchRunner {
+public:
+    /**
+     * @brief 생성자
+     */
+    BatchRunner();
+
+    // ===== 단계 적재 메서드 =====
+    /**
+     * @brief 보관 중인 단계를 모두 지우고 실행 종료
+     */
+    void clear();
+    
+    /**
+     * @brief 단계 추가 (그룹 번호 오름차순으로 추가)
+     * @param step 추가할 단계 (분배량 단계는 시간으로 변환한 뒤 추가)
+     * @return true: 추가됨, false: BATCH_MAX_STEPS 초과 또는 실행 중
+     */
+    bool addStep(const BatchStep& step);
+
+    // ===== 실행 제어 메서드 =====
+    /**
+     * @brief 보관한 단계 실행 시작
+     */
+    void start();
+    
+    /**
+     * @brief 시작할 수 있는 다음 단계 조회
+     *
+     * 다음 단계가 현재 그룹이면 바로, 다음 그룹이면 앞 그룹이 모두 끝났을 때만 내보냅니다.
+     * @param previousGroupDone 앞 그룹의 단계가 모두 끝났는지 여부
+     * @param step 조회된 단계를 저장할 구조체
+     * @return true: 시작할 단계 있음, false: 아직 없음
+     */
+    bool getDueStep(bool previousGroupDone, BatchStep& step);
+    
+    /**
+     * @brief 다음 단계로 진행
+     */
+    void advance();
+    
+    /**
+     * @brief 실행 종료 (완료 또는 중단, 보관한 단계도 지움)
+     */
+    void stop();
+    
+    // ===== 상태 확인 메서드 =====
+    /**
+     * @brief 단계를 보관 중인지 확인 (시작 대기 또는 실행 중)
+     */
+    bool isLoaded() const;
+    
+    /**
+     * @brief 실행 중 여부
+     */
+    bool isRunning() const;
+    
+    /**
+     * @brief 모든 단계를 시작했는지 확인
+     */
+    bool isAllStepsStarted() const;
+    
+    /**
+     * @brief 보관 중인 단계 수
+     */
+    uint8_t getStepCount() const;
+    
+    /**
+     * @brief 단계 조회
+     * @param index 단계 번호 (0부터)
+     */
+    const BatchStep& getStep(uint8_t index) const;
+    
+    /**
+     * @brief 다음에 시작할 단계 번호 (0부터, 모두 시작했으면 단계 수)
+     */
+    uint8_t getNextStepIndex() const;
+
+private:
+    BatchStep steps[BATCH_MAX_STEPS];   // 보관 중인 단계
+    uint8_t stepCount;                  // 보관 중인 단계 수
+    bool running;                       // 실행 중 여부
+    uint8_t nextStepIndex;              // 다음에 시작할 단계 번호
+    uint8_t activeGroup;                // 현재 실행 중인 그룹 번호
+};
+
+#endif // BATCHRUNNER_H
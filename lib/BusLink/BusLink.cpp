@@ -0,0 +1,177 @@
+#include "BusLink.h"
+
+BusLink::BusLink(Print& port)
+    : port(port), enablePin(BUS_NO_PIN), address(BUS_ADDRESS_NONE), baudRate(0), byteMicros(0), driverEnabled(false),
+      lineIdleMicros(0), state(WINDOW_IDLE), openMicros(0), slotEndMicros(0), slotLength(0) {
+    resetStats();
+}
+
+void BusLink::begin(uint8_t enablePin, uint32_t baudRate) {
+    this->enablePin = enablePin;
+    if (enablePin != BUS_NO_PIN) {
+        pinMode(enablePin, OUTPUT);
+    }
+    driverEnabled = true;
+    setDriver(false);  // 수신 상태로 시작
+    setBaudRate(baudRate);
+    lineIdleMicros = micros();
+}
+
+void BusLink::setBaudRate(uint32_t baudRate) {
+    this->baudRate = baudRate;
+    // 올림하여 슬롯 안에서 응답이 끝나도록 합니다.
+    byteMicros = (uint16_t)((BUS_BITS_PER_BYTE * 1000000UL + baudRate - 1) / baudRate);
+}
+
+void BusLink::setAddress(uint8_t address) {
+    this->address = address;
+    if (address == BUS_ADDRESS_NONE) {
+        state = WINDOW_IDLE;
+        slotLength = 0;
+    }
+}
+
+uint8_t BusLink::getAddress() const {
+    return address;
+}
+
+bool BusLink::isMultiDrop() const {
+    return address != BUS_ADDRESS_NONE;
+}
+
+bool BusLink::accepts(uint8_t target) const {
+    return target == address || target == BUS_ADDRESS_BROADCAST;
+}
+
+void BusLink::scheduleWindow(uint32_t requestMicros) {
+    if (!isMultiDrop()) {
+        return;
+    }
+    state = WINDOW_SCHEDULED;
+    openMicros = requestMicros + BUS_GUARD_US;
+    slotLength = 0;
+}
+
+void BusLink::scheduleSlot(uint32_t requestMicros, const uint8_t* message, uint8_t length) {
+    if (!isMultiDrop() || length > BUS_SLOT_BYTES) {
+        return;
+    }
+    // 슬롯 k 는 [요청 + k × 슬롯 길이 + 보호 시간, + BUS_SLOT_BYTES 바이트 시간) 동안 이 노드 차례입니다.
+    uint32_t slotBytesMicros = (uint32_t)BUS_SLOT_BYTES * byteMicros;
+    uint32_t slotMicros = BUS_GUARD_US + slotBytesMicros;
+    state = WINDOW_SCHEDULED;
+    openMicros = requestMicros + (uint32_t)(address - 1) * slotMicros + BUS_GUARD_US;
+    slotEndMicros = openMicros + slotBytesMicros;
+    memcpy(slotMessage, message, length);
+    slotLength = length;
+}
+
+void BusLink::closeWindow() {
+    if (isMultiDrop() && state != WINDOW_IDLE) {
+        state = WINDOW_DRAINING;
+    }
+}
+
+void BusLink::update() {
+    uint32_t now = micros();
+
+    openIfDue(now);
+    if (state == WINDOW_SCHEDULED && slotLength > 0 && (int32_t)(now - openMicros) >= 0) {
+        // 슬롯 끝까지 다 보낼 수 없으면 다음 노드와 겹치지 않도록 이번 응답은 건너뜁니다.
+        if ((int32_t)(now + transferMicros(slotLength) - slotEndMicros) <= 0) {
+            setDriver(true);
+            port.write(slotMessage, slotLength);  // 창이 닫혀 있던 동안 하드웨어 버퍼는 비어 있음
+            markSent(slotLength);
+            stats.slots++;
+        } else {
+            stats.lateSlots++;
+        }
+        slotLength = 0;
+        state = WINDOW_DRAINING;
+    }
+
+    // 넘긴 바이트가 모두 선로를 떠났으면 DE 를 내립니다.
+    if ((int32_t)(now - lineIdleMicros) >= 0) {
+        setDriver(false);
+        if (state == WINDOW_DRAINING) {
+            state = WINDOW_IDLE;
+        }
+    }
+}
+
+bool BusLink::isWindowOpen() const {
+    return !isMultiDrop() || state == WINDOW_OPEN;
+}
+
+bool BusLink::isMyTurn() const {
+    return isWindowOpen() || (state == WINDOW_SCHEDULED && slotLength == 0);
+}
+
+size_t BusLink::write(uint8_t c) {
+    return write(&c, 1);
+}
+
+size_t BusLink::write(const uint8_t* buffer, size_t size) {
+    if (!isWindowOpen()) {
+        return 0;  // 다른 노드 차례: 선로에 내보내지 않음
+    }
+    setDriver(true);
+    size_t written = port.write(buffer, size);
+    markSent(written);
+    return written;
+}
+
+int BusLink::availableForWrite() {
+    // 응답 대기열이 자리를 기다리며 부르는 동안에도 창이 열리도록 여기서도 시각을 확인합니다.
+    openIfDue(micros());
+    return isWindowOpen() ? port.availableForWrite() : 0;
+}
+
+void BusLink::flush() {
+    port.flush();
+}
+
+void BusLink::countFiltered() {
+    stats.filtered++;
+}
+
+const BusStats& BusLink::getStats() const {
+    return stats;
+}
+
+void BusLink::resetStats() {
+    stats.windows = 0;
+    stats.slots = 0;
+    stats.lateSlots = 0;
+    stats.filtered = 0;
+}
+
+void BusLink::openIfDue(uint32_t now) {
+    if (state == WINDOW_SCHEDULED && slotLength == 0 && (int32_t)(now - openMicros) >= 0) {
+        state = WINDOW_OPEN;
+        stats.windows++;
+    }
+}
+
+void BusLink::markSent(size_t count) {
+    setDriver(true);
+    // 하드웨어 버퍼의 바이트는 앞 바이트가 끝난 뒤 차례로 나갑니다.
+    uint32_t now = micros();
+    uint32_t start = ((int32_t)(lineIdleMicros - now) > 0) ? lineIdleMicros : now;
+    lineIdleMicros = start + transferMicros(count);
+}
+
+uint32_t BusLink::transferMicros(size_t count) const {
+    // 한 번에 넘긴 바이트 전체를 한 번만 올림합니다 (바이트마다 올리면 긴 응답에서 DE 를 오래 잡고 있음).
+    return ((uint32_t)count * BUS_BITS_PER_BYTE * 1000000UL + baudRate - 1) / baudRate;
+}
+
+void BusLink::setDriver(bool enabled) {
+    if (enabled == driverEnabled) {
+        return;
+    }
+    driverEnabled = enabled;
+    if (enablePin != BUS_NO_PIN) {
+        digitalWrite(enablePin, enabled ? HIGH : LOW);
+    }
+}
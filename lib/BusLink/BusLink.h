@@ -0,0 +1,186 @@
+#ifndef BUSLINK_H
+#define BUSLINK_H
+
+#include <Arduino.h>
+
+// ===== 노드 주소 =====
+#define BUS_ADDRESS_NONE 0             // 주소 없음: 1:1 연결 (기존 동작, 언제든 송신)
+#define BUS_ADDRESS_MAX 247            // 노드 주소 범위 1 ~ 247
+#define BUS_ADDRESS_BROADCAST 0xFF     // 모든 노드 (텍스트 "@*")
+#define BUS_NO_PIN 0xFF                // 송신 허용(DE) 핀 없음
+
+// ===== 응답 시간 창 =====
+// 요청의 마지막 바이트를 받은 뒤 BUS_GUARD_US 가 지나야 송신을 시작합니다 (호스트가 송신기를 끌 시간,
+// 노드마다 다른 loop() 지연 흡수). 방송 상태 폴링에는 주소 순서대로 한 슬롯씩 응답하며,
+// 슬롯 길이는 BUS_GUARD_US + BUS_SLOT_BYTES 바이트 전송 시간입니다 (주소 N 은 N-1 번째 슬롯).
+#define BUS_GUARD_US 3000
+#define BUS_SLOT_BYTES 24              // 슬롯 하나에 보낼 수 있는 최대 바이트 (상태 응답 한 줄/프레임)
+#define BUS_BITS_PER_BYTE 10           // 8N1: 시작 + 8 데이터 + 정지
+
+/**
+ * @brief 버스 통계
+ */
+struct BusStats {
+    uint16_t windows;        // 연 응답 창 수 (1:1 요청 응답)
+    uint16_t slots;          // 보낸 방송 상태 응답 수
+    uint16_t lateSlots;      // loop() 가 늦어 슬롯 안에 끝낼 수 없어 건너뛴 상태 응답 수
+    uint16_t filtered;       // 다른 노드 앞으로 온 줄/프레임 수 (수신 필터에서 버림)
+};
+
+/**
+ * @brief RS-485 반이중 멀티드롭 송신 제어
+ *
+ * 시리얼 포트를 감싸는 Print 로, 허용된 시간 창 안에서만 송신하고 그동안 트랜시버의
+ * 송신 허용(DE) 핀을 올립니다. 포트에 넘긴 바이트 수와 통신 속도로 마지막 바이트가 선로를
+ * 떠나는 시각을 계산하여, 그 뒤에 DE 를 내립니다 (송신 완료를 기다리며 막지 않음).
+ * 주소가 없으면(1:1 연결) 창은 항상 열려 있고 DE 만 송신 중에 올립니다.
+ * 메시지 형식은 모르며, 언제 창을 열고 닫을지는 SerialCommand 가 정합니다.
+ */
+class BusLink : public Print {
+public:
+    /**
+     * @brief 생성자
+     * @param port 실제 송신 포트 (Serial)
+     */
+    explicit BusLink(Print& port);
+
+    // ===== 초기화 메서드 =====
+    /**
+     * @brief 송신 허용 핀 초기화 (수신 상태로 시작)
+     * @param enablePin 트랜시버 DE(/RE) 핀 (BUS_NO_PIN: 없음)
+     * @param baudRate 현재 통신 속도
+     */
+    void begin(uint8_t enablePin, uint32_t baudRate);
+
+    /**
+     * @brief 통신 속도 변경 (바이트 전송 시간 재계산)
+     */
+    void setBaudRate(uint32_t baudRate);
+
+    /**
+     * @brief 노드 주소 설정 (BUS_ADDRESS_NONE: 1:1 연결)
+     */
+    void setAddress(uint8_t address);
+
+    /**
+     * @brief 노드 주소
+     */
+    uint8_t getAddress() const;
+
+    /**
+     * @brief 멀티드롭 버스 사용 여부 (주소가 설정됨)
+     */
+    bool isMultiDrop() const;
+
+    /**
+     * @brief 이 노드가 받아야 하는 주소인지 확인 (자기 주소 또는 방송)
+     */
+    bool accepts(uint8_t target) const;
+
+    // ===== 응답 시간 창 =====
+    /**
+     * @brief 1:1 요청의 응답 창 예약 (요청 수신 후 BUS_GUARD_US 뒤에 열림)
+     * @param requestMicros 요청의 마지막 바이트를 받은 시각
+     */
+    void scheduleWindow(uint32_t requestMicros);
+
+    /**
+     * @brief 방송 상태 폴링의 응답 슬롯 예약 (이 노드 차례에 메시지 하나만 보내고 닫힘)
+     * @param requestMicros 폴링의 마지막 바이트를 받은 시각
+     * @param message 보낼 메시지 (BUS_SLOT_BYTES 이하)
+     * @param length 메시지 길이
+     */
+    void scheduleSlot(uint32_t requestMicros, const uint8_t* message, uint8_t length);
+
+    /**
+     * @brief 응답 창을 닫음 (이미 넘긴 바이트가 선로를 떠나면 DE 를 내림)
+     */
+    void closeWindow();
+
+    /**
+     * @brief 예약된 창 열기, 슬롯 메시지 송신, 송신이 끝난 DE 내리기 (매 loop()에서 호출)
+     */
+    void update();
+
+    /**
+     * @brief 응답 창이 열려 있는지 확인 (1:1 연결은 항상 열림)
+     */
+    bool isWindowOpen() const;
+
+    /**
+     * @brief 이 노드가 송신할 차례인지 확인 (1:1 응답 창이 열렸거나 곧 열림, 1:1 연결은 항상)
+     *
+     * 차례가 아니면 송신 대기열은 기다리지 않고 멈춰 있어야 합니다 (다른 노드의 차례는 언제 끝날지 모름).
+     */
+    bool isMyTurn() const;
+
+    // ===== Print 구현 (창이 열려 있을 때만 포트로 전달) =====
+    size_t write(uint8_t c) override;
+    size_t write(const uint8_t* buffer, size_t size) override;
+    int availableForWrite() override;
+    void flush() override;
+    using Print::write;
+
+    // ===== 통계 =====
+    /**
+     * @brief 다른 노드 앞으로 온 요청을 버린 횟수 세기 (수신 필터에서 호출)
+     */
+    void countFiltered();
+
+    /**
+     * @brief 버스 통계
+     */
+    const BusStats& getStats() const;
+
+    /**
+     * @brief 통계 초기화
+     */
+    void resetStats();
+
+private:
+    enum WindowState : uint8_t {
+        WINDOW_IDLE,         // 수신 대기 (DE 내림)
+        WINDOW_SCHEDULED,    // 예약됨 (openMicros 에 열림)
+        WINDOW_OPEN,         // 송신 가능
+        WINDOW_DRAINING      // 닫는 중 (넘긴 바이트가 선로를 떠나면 IDLE)
+    };
+
+    /**
+     * @brief 예약된 1:1 응답 창이 열릴 시각이 되었으면 열기
+     * @param now 현재 시각
+     */
+    void openIfDue(uint32_t now);
+
+    /**
+     * @brief 포트에 넘긴 바이트의 선로 점유 시각 갱신, 필요하면 DE 올리기
+     * @param count 넘긴 바이트 수
+     */
+    void markSent(size_t count);
+
+    /**
+     * @brief 바이트 여러 개의 전송 시간 (마이크로초, 올림)
+     * @param count 바이트 수 (하드웨어 송신 버퍼 크기 이하)
+     */
+    uint32_t transferMicros(size_t count) const;
+
+    /**
+     * @brief 송신 허용 핀 출력
+     */
+    void setDriver(bool enabled);
+
+    Print& port;                       // 실제 송신 포트
+    uint8_t enablePin;                 // 트랜시버 DE 핀 (BUS_NO_PIN: 없음)
+    uint8_t address;                   // 노드 주소 (BUS_ADDRESS_NONE: 1:1 연결)
+    uint32_t baudRate;                 // 통신 속도
+    uint16_t byteMicros;               // 바이트 하나의 전송 시간 (마이크로초, 올림: 슬롯 계산용)
+    bool driverEnabled;                // DE 출력 상태
+    uint32_t lineIdleMicros;           // 마지막으로 넘긴 바이트가 선로를 떠나는 시각
+    WindowState state;                 // 응답 창 상태
+    uint32_t openMicros;               // 예약된 창이 열리는 시각
+    uint32_t slotEndMicros;            // 슬롯 끝 시각 (이 전에 메시지를 다 보내야 함)
+    uint8_t slotMessage[BUS_SLOT_BYTES]; // 슬롯에 보낼 메시지
+    uint8_t slotLength;                // 슬롯 메시지 길이 (0: 슬롯 아님)
+    BusStats stats;                    // 통계
+};
+
+#endif // BUSLINK_H
@@ -0,0 +1,67 @@
+#include "Calibration.h"
+
+// 헤더: 매직, 버전, 채널 수
+#define CALIBRATION_HEADER_SIZE 3
+
+Calibration::Calibration(int eepromAddress, uint8_t slotCount)
+    : eepromAddress(eepromAddress), slotCount(slotCount > CALIBRATION_MAX_SLOTS ? CALIBRATION_MAX_SLOTS : slotCount) {
+    for (uint8_t i = 0; i < CALIBRATION_MAX_SLOTS; i++) {
+        rates[i] = 0.0f;
+    }
+}
+
+void Calibration::begin() {
+    bool isFormatted = EEPROM.read(eepromAddress) == CALIBRATION_MAGIC &&
+                       EEPROM.read(eepromAddress + 1) == CALIBRATION_VERSION &&
+                       EEPROM.read(eepromAddress + 2) == slotCount;
+    
+    if (!isFormatted) {
+        // 처음 사용하거나 형식이 바뀐 경우: 헤더를 쓰고 모든 채널을 미보정으로 초기화
+        EEPROM.update(eepromAddress, CALIBRATION_MAGIC);
+        EEPROM.update(eepromAddress + 1, CALIBRATION_VERSION);
+        EEPROM.update(eepromAddress + 2, slotCount);
+        for (uint8_t i = 0; i < slotCount; i++) {
+            rates[i] = 0.0f;
+            EEPROM.put(getRateAddress(i), rates[i]);
+        }
+        return;
+    }
+    
+    for (uint8_t i = 0; i < slotCount; i++) {
+        float rate;
+        EEPROM.get(getRateAddress(i), rate);
+        rates[i] = isValidRate(rate) ? rate : 0.0f;
+    }
+}
+
+bool Calibration::isCalibrated(uint8_t slot) const {
+    return getRate(slot) > 0.0f;
+}
+
+float Calibration::getRate(uint8_t slot) const {
+    return slot < slotCount ? rates[slot] : 0.0f;
+}
+
+bool Calibration::setRate(uint8_t slot, float rate) {
+    if (slot >= slotCount || !isValidRate(rate)) {
+        return false;
+    }
+    
+    rates[slot] = rate;
+    EEPROM.put(getRateAddress(slot), rate);  // 바뀐 바이트만 기록
+    return true;
+}
+
+float Calibration::toDuration(uint8_t slot, float quantity) const {
+    float rate = getRate(slot);
+    return rate > 0.0f ? quantity / rate : 0.0f;
+}
+
+int Calibration::getRateAddress(uint8_t slot) const {
+    return eepromAddress + CALIBRATION_HEADER_SIZE + slot * (int)sizeof(float);
+}
+
+bool Calibration::isValidRate(float rate) {
+    // NaN 은 모든 비교가 거짓이므로 여기서 걸러집니다.
+    return rate > 0.0f && rate <= CALIBRATION_MAX_RATE;
+}
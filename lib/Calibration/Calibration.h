@@ -0,0 +1,84 @@
+#ifndef CALIBRATION_H
+#define CALIBRATION_H
+
+#include <Arduino.h>
+#include <EEPROM.h>
+
+// ===== 보정값 저장 설정 =====
+#define CALIBRATION_MAX_SLOTS 8          // 최대 채널 수
+#define CALIBRATION_MAGIC 0xCA           // 보정 영역 식별 바이트
+#define CALIBRATION_VERSION 1            // 저장 형식 버전
+#define CALIBRATION_MAX_RATE 1000.0f     // 허용하는 최대 초당 분배량
+
+/**
+ * @brief 채널별 분배량 보정 클래스
+ * 
+ * 채널마다 초당 분배량(g/s 또는 ml/s)을 EEPROM 에 저장하고,
+ * 부팅 시 RAM 으로 읽어 두어 목표량을 작동 시간으로 바로 변환합니다.
+ * 저장 형식: [매직][버전][채널 수][float 보정값 × 채널 수]
+ * 보정되지 않은 채널의 값은 0 입니다.
+ */
+class Calibration {
+public:
+    /**
+     * @brief 생성자
+     * @param eepromAddress 보정 영역 시작 주소
+     * @param slotCount 채널 수 (최대 CALIBRATION_MAX_SLOTS)
+     */
+    Calibration(int eepromAddress, uint8_t slotCount);
+
+    // ===== 초기화 메서드 =====
+    /**
+     * @brief EEPROM 에서 보정값 읽기 (setup()에서 호출)
+     * 
+     * 영역이 비어 있거나 형식이 다르면 모든 채널을 미보정 상태로 초기화합니다.
+     */
+    void begin();
+
+    // ===== 보정값 메서드 =====
+    /**
+     * @brief 채널 보정 여부
+     * @param slot 채널 번호
+     */
+    bool isCalibrated(uint8_t slot) const;
+    
+    /**
+     * @brief 초당 분배량 반환
+     * @param slot 채널 번호
+     * @return 초당 분배량 (미보정이면 0)
+     */
+    float getRate(uint8_t slot) const;
+    
+    /**
+     * @brief 초당 분배량 저장 (RAM 과 EEPROM 모두 갱신)
+     * @param slot 채널 번호
+     * @param rate 초당 분배량 (0 초과, CALIBRATION_MAX_RATE 이하)
+     * @return true: 저장됨, false: 범위 밖
+     */
+    bool setRate(uint8_t slot, float rate);
+    
+    /**
+     * @brief 목표량을 작동 시간으로 변환
+     * @param slot 채널 번호
+     * @param quantity 목표량 (g 또는 ml)
+     * @return 작동 시간 (초, 미보정이면 0)
+     */
+    float toDuration(uint8_t slot, float quantity) const;
+
+private:
+    /**
+     * @brief 채널 보정값의 EEPROM 주소
+     */
+    int getRateAddress(uint8_t slot) const;
+    
+    /**
+     * @brief 보정값이 유효 범위인지 확인 (지워진 EEPROM 의 NaN 포함 거부)
+     */
+    static bool isValidRate(float rate);
+
+    int eepromAddress;                      // 보정 영역 시작 주소
+    uint8_t slotCount;                      // 채널 수
+    float rates[CALIBRATION_MAX_SLOTS];     // 초당 분배량 캐시
+};
+
+#endif // CALIBRATION_H
@@ -0,0 +1,50 @@
+#include "CommandQueue.h"
+
+CommandQueue::CommandQueue() : head(0), count(0) {
+}
+
+bool CommandQueue::push(const Command& command) {
+    if (isFull()) {
+        return false;
+    }
+    
+    uint8_t tail = (head + count) % COMMAND_QUEUE_SIZE;
+    commands[tail] = command;
+    count++;
+    return true;
+}
+
+bool CommandQueue::pop(Command& command) {
+    if (isEmpty()) {
+        return false;
+    }
+    
+    command = commands[head];
+    head = (head + 1) % COMMAND_QUEUE_SIZE;
+    count--;
+    return true;
+}
+
+const Command* CommandQueue::peek() const {
+    if (isEmpty()) {
+        return nullptr;
+    }
+    return &commands[head];
+}
+
+void CommandQueue::clear() {
+    head = 0;
+    count = 0;
+}
+
+bool CommandQueue::isEmpty() const {
+    return count == 0;
+}
+
+bool CommandQueue::isFull() const {
+    return count >= COMMAND_QUEUE_SIZE;
+}
+
+uint8_t CommandQueue::size() const {
+    return count;
+}
@@ -0,0 +1,71 @@
+#ifndef COMMANDQUEUE_H
+#define COMMANDQUEUE_H
+
+#include <Arduino.h>
+#include <SerialCommand.h>
+
+// ===== 명령 대기열 크기 =====
+#define COMMAND_QUEUE_SIZE 8
+
+/**
+ * @brief 명령 대기열 (고정 크기 FIFO)
+ * 
+ * 실행 중에도 수신된 명령을 보관하여, 이전 명령이 완료되는 즉시
+ * 다음 명령을 시작할 수 있게 합니다. 동적 메모리를 사용하지 않는 링 버퍼입니다.
+ */
+class CommandQueue {
+public:
+    /**
+     * @brief 생성자
+     */
+    CommandQueue();
+
+    // ===== 대기열 조작 메서드 =====
+    /**
+     * @brief 명령을 대기열 끝에 추가
+     * @param command 추가할 명령
+     * @return true: 추가됨, false: 대기열 가득 참
+     */
+    bool push(const Command& command);
+    
+    /**
+     * @brief 대기열 맨 앞 명령을 꺼냄
+     * @param command 꺼낸 명령을 저장할 구조체
+     * @return true: 꺼냄, false: 대기열 비어 있음
+     */
+    bool pop(Command& command);
+    
+    /**
+     * @brief 대기열 맨 앞 명령 조회 (제거하지 않음)
+     * @return 맨 앞 명령 포인터 (비어 있으면 nullptr)
+     */
+    const Command* peek() const;
+    
+    /**
+     * @brief 대기열 비우기
+     */
+    void clear();
+    
+    // ===== 상태 확인 메서드 =====
+    /**
+     * @brief 대기열이 비었는지 확인
+     */
+    bool isEmpty() const;
+    
+    /**
+     * @brief 대기열이 가득 찼는지 확인
+     */
+    bool isFull() const;
+    
+    /**
+     * @brief 대기 중인 명령 수 반환
+     */
+    uint8_t size() const;
+
+private:
+    Command commands[COMMAND_QUEUE_SIZE];   // 명령 저장 공간
+    uint8_t head;                           // 다음에 꺼낼 위치
+    uint8_t count;                          // 대기 중인 명령 수
+};
+
+#endif // COMMANDQUEUE_H
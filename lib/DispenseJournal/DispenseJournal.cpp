@@ -0,0 +1,228 @@
+#include "DispenseJournal.h"
+
+#if defined(__AVR__)
+#include <avr/eeprom.h>
+#endif
+
+static_assert(JOURNAL_SNAPSHOT_INTERVAL > 0, "Snapshot interval must be positive");
+
+DispenseJournal::DispenseJournal(int journalAddress, uint16_t journalSize, int snapshotAddress, uint16_t snapshotSize)
+    : journalAddress(journalAddress), capacity(journalSize / sizeof(JournalEntry)),
+      snapshotAddress(snapshotAddress), snapshotSlots(snapshotSize / JOURNAL_SNAPSHOT_SLOT_SIZE),
+      head(0), entryCount(0), lastSequence(0), nextSnapshotSlot(0), bootCount(1),
+      pendingFirst(0), pendingCount(0), pendingOffset(0), snapshotPending(false), snapshotOffset(0) {
+    static_assert(sizeof(Snapshot) <= JOURNAL_SNAPSHOT_SLOT_SIZE, "Snapshot must fit in one slot");
+    memset(&counters, 0, sizeof(counters));
+    memset(pendingEntries, 0, sizeof(pendingEntries));
+    memset(&pendingSnapshot, 0, sizeof(pendingSnapshot));
+}
+
+void DispenseJournal::begin() {
+    // 1. 기록 링 전체를 읽어 가장 최근 기록(일련번호 최대)의 다음 칸을 쓰기 위치로 복원
+    JournalEntry entry;
+    uint8_t newestBoot = 0;
+    entryCount = 0;
+    lastSequence = 0;
+    for (uint16_t slot = 0; slot < capacity; slot++) {
+        if (!loadEntry(slot, entry)) {
+            continue;
+        }
+        entryCount++;
+        if (entry.sequence > lastSequence) {
+            lastSequence = entry.sequence;
+            newestBoot = entry.bootCount;
+            head = (slot + 1) % capacity;
+        }
+    }
+    // 기록이 있는 부팅끼리만 구분하면 되므로, 부팅 번호는 따로 저장하지 않고 최근 기록에서 이어갑니다.
+    bootCount = entryCount > 0 ? (uint8_t)(newestBoot + 1) : 1;
+
+    // 2. 가장 최근 스냅샷을 불러오기
+    Snapshot snapshot;
+    uint32_t snapshotSequence = 0;
+    bool hasSnapshot = false;
+    memset(&counters, 0, sizeof(counters));
+    for (uint8_t slot = 0; slot < snapshotSlots; slot++) {
+        EEPROM.get(getSnapshotAddress(slot), snapshot);
+        if (snapshot.sequence == JOURNAL_EMPTY_SEQUENCE || snapshot.crc != computeCrc(snapshot)) {
+            continue;
+        }
+        if (!hasSnapshot || snapshot.sequence > snapshotSequence) {
+            hasSnapshot = true;
+            snapshotSequence = snapshot.sequence;
+            counters = snapshot.counters;
+            nextSnapshotSlot = (slot + 1) % snapshotSlots;
+        }
+    }
+    // 기록 링이 지워졌더라도 일련번호는 스냅샷 이후로 이어갑니다.
+    if (snapshotSequence > lastSequence) {
+        lastSequence = snapshotSequence;
+    }
+
+    // 3. 스냅샷 이후의 기록을 다시 더해 누적 사용량 복원
+    //    (스냅샷 주기가 링 크기보다 작으므로 필요한 기록은 모두 링에 남아 있습니다.)
+    for (uint16_t slot = 0; slot < capacity; slot++) {
+        if (loadEntry(slot, entry) && entry.sequence > snapshotSequence) {
+            applyEntry(entry);
+        }
+    }
+}
+
+void DispenseJournal::update() {
+    // EEPROM 바이트 쓰기는 한 번에 약 3.3ms 걸리므로, 쓰기가 끝났을 때만 한 바이트씩 진행합니다.
+    while (hasPendingWrite() && isEepromReady()) {
+        if (writePendingByte()) {
+            return;  // 실제로 쓴 바이트가 있으면 다음 호출까지 대기
+        }
+    }
+}
+
+void DispenseJournal::flush() {
+    while (hasPendingWrite()) {
+        writePendingByte();
+    }
+}
+
+bool DispenseJournal::hasPendingWrite() const {
+    return pendingCount > 0 || snapshotPending;
+}
+
+void DispenseJournal::record(CommandType type, uint16_t requestedCs, uint16_t actualCs, bool vibrationCycle, uint32_t uptimeSeconds) {
+    if (capacity == 0) {
+        return;
+    }
+
+    // 대기열이 가득 차면 가장 오래된 기록만 마저 써서 자리를 만듭니다 (분배가 몰려 끝날 때만 발생).
+    while (pendingCount >= JOURNAL_PENDING_SIZE) {
+        writePendingByte();
+    }
+
+    JournalEntry entry;
+    entry.sequence = ++lastSequence;
+    entry.uptimeSeconds = uptimeSeconds;
+    entry.requestedCs = requestedCs;
+    entry.actualCs = actualCs;
+    entry.bootCount = bootCount;
+    entry.type = (uint8_t)type;
+    entry.flags = vibrationCycle ? JOURNAL_FLAG_VIBRATION_CYCLE : 0;
+    entry.crc = computeCrc(entry);
+
+    // 덮어쓸 칸이 빈 칸이나 손상된 칸이면 유효 기록 수가 늘어납니다.
+    JournalEntry previous;
+    if (!loadEntry(head, previous)) {
+        entryCount++;
+    }
+
+    uint8_t index = getPendingIndex(pendingCount++);
+    pendingEntries[index] = entry;
+    pendingSlots[index] = head;
+    head = (head + 1) % capacity;
+
+    applyEntry(entry);
+    if (snapshotSlots > 0 && entry.sequence % JOURNAL_SNAPSHOT_INTERVAL == 0) {
+        // 스냅샷은 대기 중인 기록을 모두 쓴 뒤 이어서 씁니다 (쓰다 만 이전 스냅샷은 같은 칸에 새로 씀).
+        memset(&pendingSnapshot, 0, sizeof(pendingSnapshot));  // 패딩 바이트까지 고정
+        pendingSnapshot.sequence = entry.sequence;
+        pendingSnapshot.counters = counters;
+        pendingSnapshot.crc = computeCrc(pendingSnapshot);
+        snapshotPending = true;
+        snapshotOffset = 0;
+    }
+}
+
+uint16_t DispenseJournal::getCapacity() const {
+    return capacity;
+}
+
+uint16_t DispenseJournal::getEntryCount() const {
+    return entryCount;
+}
+
+bool DispenseJournal::readEntry(uint16_t age, JournalEntry& entry) const {
+    if (age >= capacity) {
+        return false;
+    }
+    return loadEntry((head + age) % capacity, entry);
+}
+
+const LifetimeCounters& DispenseJournal::getCounters() const {
+    return counters;
+}
+
+uint8_t DispenseJournal::getBootCount() const {
+    return bootCount;
+}
+
+bool DispenseJournal::loadEntry(uint16_t slot, JournalEntry& entry) const {
+    // 쓰기를 기다리는 칸은 RAM 사본이 최신
+    for (uint8_t i = pendingCount; i > 0; i--) {
+        uint8_t index = getPendingIndex(i - 1);
+        if (pendingSlots[index] == slot) {
+            entry = pendingEntries[index];
+            return true;
+        }
+    }
+    EEPROM.get(getEntryAddress(slot), entry);
+    return entry.sequence != JOURNAL_EMPTY_SEQUENCE && entry.crc == computeCrc(entry);
+}
+
+void DispenseJournal::applyEntry(const JournalEntry& entry) {
+    if (entry.type >= CHANNEL_FIRST_COMMAND && entry.type < CHANNEL_FIRST_COMMAND + CHANNEL_COUNT) {
+        uint8_t slot = entry.type - CHANNEL_FIRST_COMMAND;
+        counters.cycles[slot]++;
+        counters.onTimeCs[slot] += entry.actualCs;
+    }
+    if (entry.flags & JOURNAL_FLAG_VIBRATION_CYCLE) {
+        counters.vibrationCycles++;
+    }
+}
+
+bool DispenseJournal::writePendingByte() {
+    int address;
+    uint8_t value;
+
+    if (pendingCount > 0) {
+        address = getEntryAddress(pendingSlots[pendingFirst]) + pendingOffset;
+        value = reinterpret_cast<const uint8_t*>(&pendingEntries[pendingFirst])[pendingOffset];
+        if (++pendingOffset >= sizeof(JournalEntry)) {
+            pendingOffset = 0;
+            pendingFirst = getPendingIndex(1);
+            pendingCount--;
+        }
+    } else if (snapshotPending) {
+        address = getSnapshotAddress(nextSnapshotSlot) + snapshotOffset;
+        value = reinterpret_cast<const uint8_t*>(&pendingSnapshot)[snapshotOffset];
+        if (++snapshotOffset >= sizeof(Snapshot)) {
+            snapshotPending = false;
+            nextSnapshotSlot = (nextSnapshotSlot + 1) % snapshotSlots;
+        }
+    } else {
+        return false;
+    }
+
+    if (EEPROM.read(address) == value) {
+        return false;  // 같은 값은 다시 쓰지 않음 (수명 보호)
+    }
+    EEPROM.write(address, value);
+    return true;
+}
+
+uint8_t DispenseJournal::getPendingIndex(uint8_t index) const {
+    return (uint8_t)((pendingFirst + index) % JOURNAL_PENDING_SIZE);
+}
+
+int DispenseJournal::getEntryAddress(uint16_t slot) const {
+    return journalAddress + slot * (int)sizeof(JournalEntry);
+}
+
+int DispenseJournal::getSnapshotAddress(uint8_t slot) const {
+    return snapshotAddress + slot * JOURNAL_SNAPSHOT_SLOT_SIZE;
+}
+
+bool DispenseJournal::isEepromReady() {
+#if defined(__AVR__)
+    return eeprom_is_ready();
+#else
+    return true;
+#endif
+}
@@ -0,0 +1,203 @@
+#ifndef DISPENSEJOURNAL_H
+#define DISPENSEJOURNAL_H
+
+#include <Arduino.h>
+#include <EEPROM.h>
+#include <stddef.h>
+#include <SerialCommand.h>
+
+// ===== 기록 저장 설정 =====
+#define JOURNAL_EMPTY_SEQUENCE 0xFFFFFFFFUL   // 지워진 EEPROM 칸의 일련번호
+#define JOURNAL_SNAPSHOT_INTERVAL 32          // 누적 사용량 스냅샷 주기 (기록 수)
+#define JOURNAL_SNAPSHOT_SLOT_SIZE 64         // 스냅샷 한 칸 크기 (바이트)
+#define JOURNAL_FLAG_VIBRATION_CYCLE 0x01     // 이 분배가 끝나며 진동 릴레이가 꺼짐
+#define JOURNAL_PENDING_SIZE 4                // EEPROM 쓰기를 기다릴 수 있는 기록 수
+
+/**
+ * @brief 분배 기록 한 건 (EEPROM 16 바이트)
+ */
+struct JournalEntry {
+    uint32_t sequence;        // 일련번호 (1부터 증가, JOURNAL_EMPTY_SEQUENCE: 빈 칸)
+    uint32_t uptimeSeconds;   // 부팅 후 경과 시간 (초)
+    uint16_t requestedCs;     // 요청 작동 시간 (1/100초)
+    uint16_t actualCs;        // 실제 작동 시간 (1/100초)
+    uint8_t bootCount;        // 부팅 번호 (경과 시간의 기준점 구분용)
+    uint8_t type;             // 채널 명령 타입
+    uint8_t flags;            // JOURNAL_FLAG_*
+    uint8_t crc;              // 앞 15 바이트의 CRC-8
+};
+
+/**
+ * @brief 액추에이터 누적 사용량
+ */
+struct LifetimeCounters {
+    uint32_t cycles[CHANNEL_COUNT];     // 채널별 작동 횟수 (서보 열림/닫힘, 펌프 ON/OFF)
+    uint32_t onTimeCs[CHANNEL_COUNT];   // 채널별 누적 작동 시간 (1/100초)
+    uint32_t vibrationCycles;           // 진동 릴레이 ON/OFF 횟수
+};
+
+/**
+ * @brief 분배 기록과 누적 사용량을 EEPROM 에 남기는 클래스
+ *
+ * 기록은 16 바이트 칸의 링에 순서대로 덮어쓰므로 모든 칸이 고르게 닳습니다.
+ * 고정 위치의 헤드 포인터를 두지 않고, 부팅 시 일련번호가 가장 큰 칸을 찾아
+ * 다음 쓰기 위치를 복원합니다 (CRC 가 맞지 않는 칸은 쓰다 끊긴 것으로 보고 건너뜀).
+ * 누적 사용량은 JOURNAL_SNAPSHOT_INTERVAL 건마다 별도 링에 스냅샷을 남기고,
+ * 부팅 시 가장 최근 스냅샷에 그 뒤의 기록을 다시 더해 정확한 값을 복원합니다.
+ * EEPROM 쓰기는 바이트마다 약 3.3ms 가 걸리므로, record() 는 RAM 의 대기열(JOURNAL_PENDING_SIZE 건)에
+ * 기록만 해 두고 update() 가 이전 쓰기가 끝났을 때마다 한 바이트씩 내보냅니다 (loop 를 막지 않음).
+ * 대기열이 가득 찰 때(기록 한 건을 쓰는 약 53ms 안에 분배가 여러 건 끝난 경우)에만
+ * 가장 오래된 기록 한 건을 마저 쓰고 자리를 만듭니다.
+ */
+class DispenseJournal {
+public:
+    /**
+     * @brief 생성자
+     * @param journalAddress 기록 링 시작 주소
+     * @param journalSize 기록 링 크기 (바이트, 16의 배수)
+     * @param snapshotAddress 스냅샷 링 시작 주소
+     * @param snapshotSize 스냅샷 링 크기 (바이트, JOURNAL_SNAPSHOT_SLOT_SIZE 의 배수)
+     */
+    DispenseJournal(int journalAddress, uint16_t journalSize, int snapshotAddress, uint16_t snapshotSize);
+
+    // ===== 초기화 메서드 =====
+    /**
+     * @brief 기록 링과 스냅샷을 읽어 쓰기 위치와 누적 사용량 복원 (setup()에서 호출)
+     */
+    void begin();
+
+    // ===== 기록 메서드 =====
+    /**
+     * @brief 완료된 분배 한 건 기록
+     * @param type 채널 명령 타입
+     * @param requestedCs 요청 작동 시간 (1/100초)
+     * @param actualCs 실제 작동 시간 (1/100초)
+     * @param vibrationCycle 이 분배가 끝나며 진동 릴레이가 꺼졌는지 여부
+     * @param uptimeSeconds 부팅 후 경과 시간 (초)
+     */
+    void record(CommandType type, uint16_t requestedCs, uint16_t actualCs, bool vibrationCycle, uint32_t uptimeSeconds);
+
+    /**
+     * @brief 대기 중인 EEPROM 쓰기 진행 (매 loop()에서 호출, 논블로킹)
+     */
+    void update();
+
+    /**
+     * @brief 대기 중인 EEPROM 쓰기를 모두 마칠 때까지 대기
+     */
+    void flush();
+
+    /**
+     * @brief 아직 EEPROM 에 쓰지 못한 기록/스냅샷이 있는지 여부
+     */
+    bool hasPendingWrite() const;
+
+    // ===== 조회 메서드 =====
+    /**
+     * @brief 기록 링의 칸 수
+     */
+    uint16_t getCapacity() const;
+
+    /**
+     * @brief 저장된 유효 기록 수
+     */
+    uint16_t getEntryCount() const;
+
+    /**
+     * @brief 기록 읽기 (오래된 칸부터)
+     * @param age 0: 가장 오래된 칸 ~ getCapacity() - 1: 가장 최근 칸
+     * @param entry 읽은 기록
+     * @return true: 유효한 기록, false: 빈 칸 또는 손상된 칸
+     */
+    bool readEntry(uint16_t age, JournalEntry& entry) const;
+
+    /**
+     * @brief 누적 사용량
+     */
+    const LifetimeCounters& getCounters() const;
+
+    /**
+     * @brief 이번 부팅 번호
+     */
+    uint8_t getBootCount() const;
+
+private:
+    /**
+     * @brief 스냅샷 한 칸 (EEPROM)
+     */
+    struct Snapshot {
+        uint32_t sequence;           // 반영된 마지막 기록 일련번호
+        LifetimeCounters counters;   // 누적 사용량
+        uint8_t crc;                 // 앞 바이트의 CRC-8
+    };
+
+    /**
+     * @brief 기록 칸 읽기 및 검증
+     * @param slot 칸 번호
+     * @param entry 읽은 기록
+     * @return true: 유효한 기록
+     */
+    bool loadEntry(uint16_t slot, JournalEntry& entry) const;
+
+    /**
+     * @brief 기록 한 건을 누적 사용량에 더하기
+     */
+    void applyEntry(const JournalEntry& entry);
+
+    /**
+     * @brief 대기열에서 index 번째(0: 쓰는 중인 기록) 기록의 위치
+     */
+    uint8_t getPendingIndex(uint8_t index) const;
+
+    /**
+     * @brief 대기 중인 기록/스냅샷의 다음 바이트 쓰기
+     * @return true: EEPROM 에 실제로 씀, false: 같은 값이라 건너뜀 또는 대기 중인 쓰기 없음
+     */
+    bool writePendingByte();
+
+    /**
+     * @brief 기록 칸의 EEPROM 주소
+     */
+    int getEntryAddress(uint16_t slot) const;
+
+    /**
+     * @brief 스냅샷 칸의 EEPROM 주소
+     */
+    int getSnapshotAddress(uint8_t slot) const;
+
+    /**
+     * @brief 이전 EEPROM 쓰기가 끝났는지 여부
+     */
+    static bool isEepromReady();
+
+    /**
+     * @brief 구조체의 CRC 바이트 앞까지 CRC-8 계산
+     */
+    template <typename T>
+    static uint8_t computeCrc(const T& record) {
+        return SerialCommand::crc8(reinterpret_cast<const uint8_t*>(&record), (uint8_t)offsetof(T, crc));
+    }
+
+    int journalAddress;                 // 기록 링 시작 주소
+    uint16_t capacity;                  // 기록 링 칸 수
+    int snapshotAddress;                // 스냅샷 링 시작 주소
+    uint8_t snapshotSlots;              // 스냅샷 링 칸 수
+    uint16_t head;                      // 다음에 쓸 기록 칸
+    uint16_t entryCount;                // 유효 기록 수
+    uint32_t lastSequence;              // 마지막 기록 일련번호 (0: 기록 없음)
+    uint8_t nextSnapshotSlot;           // 다음에 쓸 스냅샷 칸
+    uint8_t bootCount;                  // 이번 부팅 번호
+    LifetimeCounters counters;          // 누적 사용량
+    JournalEntry pendingEntries[JOURNAL_PENDING_SIZE];  // 쓰기를 기다리는 기록 (링)
+    uint16_t pendingSlots[JOURNAL_PENDING_SIZE];        // 각 기록을 쓸 칸
+    uint8_t pendingFirst;               // 쓰는 중인 기록의 대기열 위치
+    uint8_t pendingCount;               // 대기열의 기록 수
+    uint8_t pendingOffset;              // 쓰는 중인 기록의 다음 바이트
+    Snapshot pendingSnapshot;           // 쓰는 중인 스냅샷
+    bool snapshotPending;               // 스냅샷 쓰기 대기 여부
+    uint8_t snapshotOffset;             // 쓰는 중인 스냅샷의 다음 바이트
+};
+
+static_assert(sizeof(JournalEntry) == 16, "JournalEntry must stay 16 bytes");
+
+#endif // DISPENSEJOURNAL_H
@@ -0,0 +1,108 @@
+#include "DoseTimer.h"
+
+#ifdef NATIVE_HAL
+#include <NativeHAL.h>
+#endif
+
+namespace {
+    DoseTimer* activeTimer = nullptr;   // 인터럽트가 처리할 타이머 객체
+}
+
+#if defined(__AVR__)
+ISR(TIMER4_COMPB_vect) {
+    if (activeTimer != nullptr) {
+        activeTimer->tick();
+    }
+}
+#else
+namespace {
+    void nativeTimerInterrupt() {
+        if (activeTimer != nullptr) {
+            activeTimer->tick();
+        }
+    }
+}
+#endif
+
+DoseTimer::DoseTimer() : handler(nullptr), armedBits(0), expiredBits(0) {
+    for (uint8_t i = 0; i < DOSE_TIMER_SLOTS; i++) {
+        remainingTicks[i] = 0;
+    }
+}
+
+void DoseTimer::begin(CutoffHandler handler) {
+    this->handler = handler;
+    activeTimer = this;
+
+#if defined(__AVR__)
+    // Timer4 CTC 모드(TOP = OCR4A), 분주비 64: 16MHz / 64 / 250 = 1kHz
+    // 주기마다 TCNT4 가 OCR4B(=0) 를 지날 때 COMPB 인터럽트가 발생합니다.
+    noInterrupts();
+    TCCR4A = 0;
+    TCCR4B = _BV(WGM42) | _BV(CS41) | _BV(CS40);
+    TCNT4 = 0;
+    OCR4A = (uint16_t)(F_CPU / 64 / (1000000UL / DOSE_TIMER_TICK_US) - 1);
+    OCR4B = 0;
+    TIFR4 = _BV(OCF4B);
+    TIMSK4 = _BV(OCIE4B);
+    interrupts();
+#else
+    NativeHAL::attachTimerInterrupt(nativeTimerInterrupt, DOSE_TIMER_TICK_US);
+#endif
+}
+
+void DoseTimer::arm(uint8_t slot, unsigned long durationMs) {
+    if (slot >= DOSE_TIMER_SLOTS) {
+        return;
+    }
+    
+    unsigned long ticks = durationMs * 1000UL / DOSE_TIMER_TICK_US;
+    if (ticks == 0) ticks = 1;
+    if (ticks > DOSE_TIMER_MAX_TICKS) ticks = DOSE_TIMER_MAX_TICKS;
+    
+    uint8_t bit = (uint8_t)(1 << slot);
+    noInterrupts();
+    remainingTicks[slot] = (uint16_t)ticks;
+    expiredBits &= (uint8_t)~bit;
+    armedBits |= bit;
+    interrupts();
+}
+
+bool DoseTimer::takeExpired(uint8_t slot) {
+    if (slot >= DOSE_TIMER_SLOTS) {
+        return false;
+    }
+    
+    uint8_t bit = (uint8_t)(1 << slot);
+    bool expired;
+    noInterrupts();
+    expired = (expiredBits & bit) != 0;
+    expiredBits &= (uint8_t)~bit;
+    interrupts();
+    return expired;
+}
+
+bool DoseTimer::isArmed(uint8_t slot) const {
+    return slot < DOSE_TIMER_SLOTS && (armedBits & (1 << slot)) != 0;
+}
+
+void DoseTimer::tick() {
+    uint8_t armed = armedBits;
+    if (armed == 0) {
+        return;
+    }
+    
+    for (uint8_t slot = 0; slot < DOSE_TIMER_SLOTS; slot++) {
+        uint8_t bit = (uint8_t)(1 << slot);
+        if (!(armed & bit) || --remainingTicks[slot] != 0) {
+            continue;
+        }
+        
+        // 종료 시각: 인터럽트 안에서 즉시 액추에이터를 닫고 loop() 에 완료를 알립니다.
+        armedBits &= (uint8_t)~bit;
+        expiredBits |= bit;
+        if (handler != nullptr) {
+            handler(slot);
+        }
+    }
+}
@@ -0,0 +1,75 @@
+#ifndef DOSETIMER_H
+#define DOSETIMER_H
+
+#include <Arduino.h>
+
+// ===== 분배 타이머 설정 =====
+#define DOSE_TIMER_SLOTS 8               // 동시에 관리하는 최대 채널 수 (비트마스크 크기)
+#define DOSE_TIMER_TICK_US 1000          // 타이머 인터럽트 주기 (마이크로초)
+#define DOSE_TIMER_MAX_TICKS 0xFFFF      // 한 번에 설정 가능한 최대 틱 수 (1kHz 기준 약 65초)
+
+/**
+ * @brief 하드웨어 타이머 기반 분배 종료 클래스
+ * 
+ * Timer4 비교 일치 인터럽트(1kHz)에서 채널별 남은 시간을 줄이고,
+ * 0이 되는 즉시 등록된 종료 함수를 인터럽트 안에서 호출하여 서보/릴레이를 닫습니다.
+ * loop() 는 takeExpired() 로 종료된 채널을 확인한 뒤 완료 응답만 보내므로,
+ * 분배 정확도가 loop() 의 지연(시리얼 전송 대기 등)에 영향을 받지 않습니다.
+ * (Timer0 은 millis(), Timer5 는 Servo 라이브러리가 사용합니다. Servo 라이브러리가
+ *  Timer1/3/4/5 의 COMPA 벡터를 모두 정의하므로, Timer4 는 OCR4A 를 주기로 쓰고 COMPB 벡터로 인터럽트를 받습니다.)
+ */
+class DoseTimer {
+public:
+    /**
+     * @brief 분배 종료 함수 (인터럽트 컨텍스트에서 호출, 시리얼 출력 금지)
+     * @param slot 종료된 채널 번호
+     */
+    typedef void (*CutoffHandler)(uint8_t slot);
+
+    /**
+     * @brief 생성자
+     */
+    DoseTimer();
+
+    // ===== 초기화 메서드 =====
+    /**
+     * @brief 타이머 설정 및 인터럽트 시작 (setup()에서 호출)
+     * @param handler 채널 종료 시 호출할 함수
+     */
+    void begin(CutoffHandler handler);
+
+    // ===== 채널 제어 메서드 =====
+    /**
+     * @brief 채널 종료 시각 설정
+     * @param slot 채널 번호 (0 ~ DOSE_TIMER_SLOTS-1)
+     * @param durationMs 지금부터 종료까지의 시간 (밀리초, 최대 DOSE_TIMER_MAX_TICKS 틱)
+     */
+    void arm(uint8_t slot, unsigned long durationMs);
+    
+    /**
+     * @brief 인터럽트가 종료시킨 채널 확인 (확인 후 표시 해제)
+     * @param slot 채널 번호
+     * @return true: 타이머가 채널을 종료함 (완료 보고 필요)
+     */
+    bool takeExpired(uint8_t slot);
+    
+    /**
+     * @brief 채널 종료 대기 중 여부
+     * @param slot 채널 번호
+     */
+    bool isArmed(uint8_t slot) const;
+
+    // ===== 인터럽트 처리 =====
+    /**
+     * @brief 타이머 1틱 처리 (타이머 인터럽트에서 호출)
+     */
+    void tick();
+
+private:
+    CutoffHandler handler;                              // 채널 종료 함수
+    volatile uint16_t remainingTicks[DOSE_TIMER_SLOTS]; // 채널별 남은 틱 수
+    volatile uint8_t armedBits;                         // 종료 대기 중인 채널
+    volatile uint8_t expiredBits;                       // 종료되었지만 loop() 가 확인하지 않은 채널
+};
+
+#endif // DOSETIMER_H
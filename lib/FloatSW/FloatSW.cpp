@@ -1,14 +1,31 @@
 #include "FloatSW.h"
+#include "Channels.h"  // ChannelConfig 정의 (프로젝트 include/)
 
-FloatSW::FloatSW(int pin, String name) 
-    : floatPin(pin), currentState(FLOAT_STATE_EMPTY), name(name) {
+FloatSW::FloatSW(SensorBank& bank, int pin, const char* name) 
+    : bank(&bank), bankIndex(-1), floatPin(pin), currentState(FLOAT_STATE_EMPTY), name(name) {
+}
+
+FloatSW::FloatSW()
+    : bank(nullptr), bankIndex(-1), floatPin(-1), currentState(FLOAT_STATE_EMPTY), name(nullptr) {
+}
+
+void FloatSW::begin(SensorBank& bank, const ChannelConfig& config) {
+    this->bank = &bank;
+    floatPin = config.sensorPin;
+    name = config.name;
+    begin();
+}
+
+void FloatSW::begin() {
     pinMode(floatPin, INPUT_PULLUP);  // 내부 풀업 저항 사용
+    bankIndex = bank->addPin(floatPin);
     currentState = digitalRead(floatPin);  // 초기 상태 읽기
-    Serial.println(name + " FloatSW initialized");
+    Serial.print(name);
+    Serial.println(F(" FloatSW initialized"));
 }
 
 int FloatSW::readState() {
-    currentState = digitalRead(floatPin);
+    currentState = bankIndex >= 0 ? bank->read(bankIndex) : digitalRead(floatPin);
     return currentState;
 }
 
@@ -22,12 +39,12 @@ bool FloatSW::isLiquidEmpty() {
     return (currentState == FLOAT_STATE_EMPTY);
 }
 
-String FloatSW::getStateString() {
+const char* FloatSW::getStateString() {
     readState();  // 현재 상태 업데이트
     if (currentState == FLOAT_STATE_FULL) {
-        return "HIGH";
+        return STR_FLOAT_HIGH;
     } else {
-        return "LOW";
+        return STR_FLOAT_LOW;
     }
 }
 
@@ -35,6 +52,6 @@ int FloatSW::getPin() const {
     return floatPin;
 }
 
-String FloatSW::getName() const {
+const char* FloatSW::getName() const {
     return name;
 }
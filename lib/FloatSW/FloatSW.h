@@ -2,29 +2,57 @@
 #define FLOATSW_H
 
 #include <Arduino.h>
+#include <SensorBank.h>
+
+// 채널 설정 항목 (정의: include/Channels.h)
+struct ChannelConfig;
 
 // ===== 플로트 스위치 상태 정의 =====
 #define FLOAT_STATE_EMPTY HIGH    // 액체 없음 (플로트 내려감)
 #define FLOAT_STATE_FULL LOW      // 액체 있음 (플로트 올라감)
 
+// ===== 상태 문자열 (JSON 값으로 사용) =====
+#define STR_FLOAT_HIGH "HIGH"
+#define STR_FLOAT_LOW "LOW"
+
 /**
  * @brief 플로트 스위치 제어 클래스
  * 
  * 플로트 스위치를 통해 액체 레벨을 감지하고 관리합니다.
  * 내부 풀업 저항을 사용하여 안정적인 신호를 제공합니다.
+ * 스위치 상태는 SensorBank 가 일괄 샘플링/디바운스한 스냅샷에서 읽습니다.
  */
 class FloatSW {
 public:
     /**
      * @brief 생성자
+     * @param bank 플로트 스위치 핀을 샘플링하는 센서 뱅크
      * @param pin 플로트 스위치 연결 핀 번호
-     * @param name 플로트 스위치 식별 이름
+     * @param name 플로트 스위치 식별 이름 (문자열 상수)
+     */
+    FloatSW(SensorBank& bank, int pin, const char* name);
+
+    /**
+     * @brief 기본 생성자 (센서 뱅크, 핀과 이름은 begin(SensorBank&, const ChannelConfig&)에서 설정)
+     */
+    FloatSW();
+
+    // ===== 초기화 메서드 =====
+    /**
+     * @brief 핀 설정 및 센서 뱅크 등록 (setup()에서 SensorBank::begin() 전에 호출)
+     */
+    void begin();
+
+    /**
+     * @brief 채널 설정의 센서 핀과 이름으로 초기화 (SensorBank::begin() 전에 호출)
+     * @param bank 플로트 스위치 핀을 샘플링하는 센서 뱅크
+     * @param config 분배 채널 설정 (SENSOR_FLOAT)
      */
-    FloatSW(int pin, String name);
+    void begin(SensorBank& bank, const ChannelConfig& config);
 
     // ===== 상태 읽기 메서드 =====
     /**
-     * @brief 플로트 스위치 상태 읽기
+     * @brief 플로트 스위치 상태 읽기 (센서 뱅크의 디바운스된 스냅샷)
      * @return 현재 상태 (HIGH: 액체 없음, LOW: 액체 있음)
      */
     int readState();
@@ -43,10 +71,10 @@ public:
     
     // ===== 정보 반환 메서드 =====
     /**
-     * @brief 현재 상태 문자열 반환
-     * @return "FULL" 또는 "EMPTY"
+     * @brief 현재 상태 문자열 반환 (정적 문자열, 동적 메모리 사용 없음)
+     * @return "HIGH" (액체 없음) 또는 "LOW" (액체 있음)
      */
-    String getStateString();
+    const char* getStateString();
     
     /**
      * @brief 플로트 스위치 핀 번호 반환
@@ -58,12 +86,14 @@ public:
      * @brief 플로트 스위치 이름 반환
      * @return 이름
      */
-    String getName() const;
+    const char* getName() const;
 
 private:
+    SensorBank* bank;       // 플로트 스위치 샘플링 뱅크
+    int8_t bankIndex;       // 센서 뱅크 내 인덱스 (-1: 미등록, digitalRead 사용)
     int floatPin;           // 플로트 스위치 핀 번호
     int currentState;       // 현재 상태
-    String name;           // 플로트 스위치 이름
+    const char* name;      // 플로트 스위치 이름
 };
 
 #endif // FLOATSW_H
@@ -0,0 +1,256 @@
+#ifndef NATIVEHAL_ARDUINO_H
+#define NATIVEHAL_ARDUINO_H
+
+/**
+ * @brief 호스트(native) 빌드용 Arduino 코어 대체 헤더
+ *
+ * [env:native] 환경에서만 사용됩니다. 실제 AVR 코어 대신
+ * 가상 시간(millis/micros), 가상 핀, 가상 시리얼을 제공하여
+ * src/main.cpp 와 lib/ 의 라이브러리를 리눅스에서 그대로 실행할 수 있게 합니다.
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <ctype.h>
+#include <stdlib.h>
+#include <math.h>
+#include <string>
+
+// ===== 기본 상수 =====
+#define HIGH 0x1
+#define LOW  0x0
+
+#define INPUT        0x0
+#define OUTPUT       0x1
+#define INPUT_PULLUP 0x2
+
+#define DEC 10
+#define HEX 16
+#define BIN 2
+
+#define NUM_DIGITAL_PINS 70
+
+// ===== 포트 레지스터 매핑 =====
+// 호스트에서는 핀 8개씩 하나의 가상 포트로 묶습니다 (포트 번호는 1부터, 0은 NOT_A_PORT).
+#define NOT_A_PIN  0
+#define NOT_A_PORT 0
+#define NATIVE_PORT_COUNT ((NUM_DIGITAL_PINS + 7) / 8)
+#define digitalPinToPort(P) ((uint8_t)(P) < NUM_DIGITAL_PINS ? (uint8_t)((P) / 8 + 1) : NOT_A_PORT)
+#define digitalPinToBitMask(P) ((uint8_t)(1 << ((P) % 8)))
+
+// ===== PWM 타이머 매핑 =====
+// Mega2560 과 같이 2~13번, 44~46번 핀만 PWM 출력이 가능한 것으로 취급합니다 (타이머 번호는 구분하지 않음).
+#define NOT_ON_TIMER 0
+#define digitalPinToTimer(P) ((((P) >= 2 && (P) <= 13) || ((P) >= 44 && (P) <= 46)) ? 1 : NOT_ON_TIMER)
+
+typedef uint8_t byte;
+typedef bool boolean;
+
+// ===== 플래시 메모리 매크로 (호스트에서는 일반 메모리) =====
+#define PROGMEM
+#define PSTR(s) (s)
+#define pgm_read_byte(addr) (*(const uint8_t*)(addr))
+#define pgm_read_word(addr) (*(const uint16_t*)(addr))
+#define pgm_read_dword(addr) (*(const uint32_t*)(addr))
+#define pgm_read_float(addr) (*(const float*)(addr))
+#define pgm_read_ptr(addr) (*(void* const*)(addr))
+#define memcpy_P memcpy
+#define strlen_P strlen
+#define strcmp_P strcmp
+
+class __FlashStringHelper;
+#define F(s) (reinterpret_cast<const __FlashStringHelper*>(s))
+
+// ===== 인터럽트 매크로 (호스트에서는 의미 없음) =====
+#define noInterrupts()
+#define interrupts()
+#define cli()
+#define sei()
+
+// ===== String =====
+class StringSumHelper;
+
+/**
+ * @brief Arduino String 대체 클래스 (std::string 기반)
+ */
+class String {
+public:
+    String() {}
+    String(const char* cstr) : buffer(cstr ? cstr : "") {}
+    String(const __FlashStringHelper* fstr) : buffer(reinterpret_cast<const char*>(fstr)) {}
+    String(const std::string& str) : buffer(str) {}
+    explicit String(char c) : buffer(1, c) {}
+    explicit String(unsigned char value, unsigned char base = 10);
+    explicit String(int value, unsigned char base = 10);
+    explicit String(unsigned int value, unsigned char base = 10);
+    explicit String(long value, unsigned char base = 10);
+    explicit String(unsigned long value, unsigned char base = 10);
+    explicit String(float value, unsigned char decimalPlaces = 2);
+    explicit String(double value, unsigned char decimalPlaces = 2);
+
+    unsigned int length() const { return (unsigned int)buffer.length(); }
+    const char* c_str() const { return buffer.c_str(); }
+    bool reserve(unsigned int size) { buffer.reserve(size); return true; }
+
+    char charAt(unsigned int index) const { return index < buffer.length() ? buffer[index] : 0; }
+    char operator[](unsigned int index) const { return charAt(index); }
+    char& operator[](unsigned int index) { return buffer[index]; }
+
+    bool concat(const String& str) { buffer += str.buffer; return true; }
+    bool concat(const char* cstr) { if (cstr) buffer += cstr; return true; }
+    bool concat(char c) { buffer += c; return true; }
+
+    String& operator+=(const String& rhs) { concat(rhs); return *this; }
+    String& operator+=(const char* cstr) { concat(cstr); return *this; }
+    String& operator+=(char c) { concat(c); return *this; }
+
+    bool equals(const String& s) const { return buffer == s.buffer; }
+    bool equals(const char* cstr) const { return buffer == (cstr ? cstr : ""); }
+    bool operator==(const String& rhs) const { return equals(rhs); }
+    bool operator==(const char* cstr) const { return equals(cstr); }
+    bool operator!=(const String& rhs) const { return !equals(rhs); }
+    bool operator!=(const char* cstr) const { return !equals(cstr); }
+
+    bool startsWith(const String& prefix) const { return buffer.compare(0, prefix.buffer.length(), prefix.buffer) == 0; }
+    int indexOf(char c, unsigned int fromIndex = 0) const;
+    int indexOf(const String& str, unsigned int fromIndex = 0) const;
+
+    String substring(unsigned int beginIndex) const;
+    String substring(unsigned int beginIndex, unsigned int endIndex) const;
+
+    void trim();
+    void toUpperCase();
+    void toLowerCase();
+
+    long toInt() const { return atol(buffer.c_str()); }
+    float toFloat() const { return (float)atof(buffer.c_str()); }
+    double toDouble() const { return atof(buffer.c_str()); }
+
+private:
+    std::string buffer;
+};
+
+/**
+ * @brief 문자열 연결 결과 타입 (ArduinoJson 호환용)
+ */
+class StringSumHelper : public String {
+public:
+    StringSumHelper(const String& s) : String(s) {}
+};
+
+StringSumHelper operator+(const String& lhs, const String& rhs);
+StringSumHelper operator+(const String& lhs, const char* rhs);
+StringSumHelper operator+(const char* lhs, const String& rhs);
+StringSumHelper operator+(const String& lhs, char rhs);
+
+// ===== Print / Stream =====
+/**
+ * @brief Arduino Print 대체 클래스
+ */
+class Print {
+public:
+    virtual ~Print() {}
+    virtual size_t write(uint8_t c) = 0;
+    virtual size_t write(const uint8_t* buffer, size_t size);
+    size_t write(const char* str) { return str ? write((const uint8_t*)str, strlen(str)) : 0; }
+    size_t write(const char* buffer, size_t size) { return write((const uint8_t*)buffer, size); }
+    virtual int availableForWrite() { return 0; }
+    virtual void flush() {}
+
+    size_t print(const __FlashStringHelper* fstr) { return write(reinterpret_cast<const char*>(fstr)); }
+    size_t print(const String& s) { return write(s.c_str()); }
+    size_t print(const char* str) { return write(str); }
+    size_t print(char c) { return write((uint8_t)c); }
+    size_t print(unsigned char value, int base = DEC) { return print((unsigned long)value, base); }
+    size_t print(int value, int base = DEC) { return print((long)value, base); }
+    size_t print(unsigned int value, int base = DEC) { return print((unsigned long)value, base); }
+    size_t print(long value, int base = DEC);
+    size_t print(unsigned long value, int base = DEC);
+    size_t print(double value, int digits = 2);
+
+    size_t println() { return write("\r\n"); }
+    template <typename T>
+    size_t println(const T& value) { size_t n = print(value); return n + println(); }
+    template <typename T>
+    size_t println(const T& value, int format) { size_t n = print(value, format); return n + println(); }
+};
+
+/**
+ * @brief Arduino Stream 대체 클래스
+ *
+ * 타임아웃이 있는 읽기는 가상 시간을 진행시키며 대기합니다.
+ */
+class Stream : public Print {
+public:
+    virtual int available() = 0;
+    virtual int read() = 0;
+    virtual int peek() = 0;
+
+    void setTimeout(unsigned long timeout) { timeoutMs = timeout; }
+    unsigned long getTimeout() const { return timeoutMs; }
+
+    size_t readBytes(char* buffer, size_t length);
+    String readString();
+    String readStringUntil(char terminator);
+
+protected:
+    int timedRead();
+    unsigned long timeoutMs = 1000;
+};
+
+/**
+ * @brief 가상 UART
+ *
+ * 수신 데이터는 NativeHAL::feedSerial() 로 주입되며,
+ * Serial.begin() 에 지정된 통신 속도에 맞춰 한 바이트씩 도착합니다.
+ * 송신 데이터는 표준 출력으로 내보냅니다.
+ */
+class HardwareSerial : public Stream {
+public:
+    void begin(unsigned long baud);
+    void end() {}
+    int available() override;
+    int read() override;
+    int peek() override;
+    size_t write(uint8_t c) override;
+    size_t write(const uint8_t* buffer, size_t size) override;
+    int availableForWrite() override;
+    void flush() override;
+    explicit operator bool() const { return true; }
+    using Print::write;
+
+    unsigned long getBaudRate() const { return baudRate; }
+
+private:
+    unsigned long baudRate = 9600;
+};
+
+extern HardwareSerial Serial;
+
+// ===== 시간 =====
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+void yield();
+
+// ===== 디지털 / 아날로그 입출력 =====
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t value);
+int digitalRead(uint8_t pin);
+void analogWrite(uint8_t pin, int value);
+int analogRead(uint8_t pin);
+
+/**
+ * @brief 가상 포트 입력 레지스터 (AVR 의 PINx 에 해당)
+ * @param port digitalPinToPort() 결과
+ * @return 레지스터 주소 (핀 레벨 변경이 즉시 반영됨)
+ */
+volatile uint8_t* portInputRegister(uint8_t port);
+
+// ===== 스케치 진입점 =====
+void setup();
+void loop();
+
+#endif // NATIVEHAL_ARDUINO_H
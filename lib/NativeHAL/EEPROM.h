@@ -0,0 +1,55 @@
+#ifndef NATIVEHAL_EEPROM_H
+#define NATIVEHAL_EEPROM_H
+
+#include <Arduino.h>
+
+#define NATIVE_EEPROM_SIZE 4096  // ATmega2560 EEPROM 크기
+
+/**
+ * @brief 호스트 빌드용 EEPROM 라이브러리 대체 클래스
+ *
+ * 4KB 메모리 배열로 동작하며 지워진 상태(0xFF)로 시작합니다.
+ */
+class EEPROMClass {
+public:
+    uint8_t read(int address) const { return data[address]; }
+    void write(int address, uint8_t value) { data[address] = value; writeCount++; }
+    void update(int address, uint8_t value) { if (data[address] != value) write(address, value); }
+    uint8_t& operator[](int address) { return data[address]; }
+    uint16_t length() const { return NATIVE_EEPROM_SIZE; }
+
+    template <typename T>
+    T& get(int address, T& value) const {
+        memcpy(&value, &data[address], sizeof(T));
+        return value;
+    }
+
+    template <typename T>
+    const T& put(int address, const T& value) {
+        const uint8_t* bytes = (const uint8_t*)&value;
+        for (size_t i = 0; i < sizeof(T); i++) {
+            update(address + (int)i, bytes[i]);
+        }
+        return value;
+    }
+
+    /**
+     * @brief 전체 내용을 지워진 상태로 초기화 (호스트 전용)
+     */
+    void clear() { memset(data, 0xFF, sizeof(data)); writeCount = 0; }
+
+    /**
+     * @brief 실제로 기록된 바이트 수 (호스트 전용, 마모 분석용)
+     */
+    unsigned long getWriteCount() const { return writeCount; }
+
+    EEPROMClass() { clear(); }
+
+private:
+    uint8_t data[NATIVE_EEPROM_SIZE];
+    unsigned long writeCount;
+};
+
+extern EEPROMClass EEPROM;
+
+#endif // NATIVEHAL_EEPROM_H
@@ -0,0 +1,711 @@
+#include "NativeHAL.h"
+#include <Servo.h>
+#include <EEPROM.h>
+
+#include <ctype.h>
+#include <stdio.h>
+#include <unistd.h>
+#include <deque>
+
+// ===== 가상 하드웨어 상태 =====
+namespace {
+    uint64_t virtualMicros = 0;             // 가상 시간 (마이크로초)
+
+    uint8_t pinModes[NUM_DIGITAL_PINS];     // pinMode 설정값
+    uint8_t outputLevels[NUM_DIGITAL_PINS]; // digitalWrite 출력값
+    uint8_t inputLevels[NUM_DIGITAL_PINS];  // 외부에서 주입한 입력값
+    int pwmDuties[NUM_DIGITAL_PINS];        // analogWrite 듀티
+    int servoPulses[NUM_DIGITAL_PINS];      // 서보 펄스 폭 (마이크로초)
+    volatile uint8_t portInputs[NATIVE_PORT_COUNT + 1]; // 가상 PINx 레지스터 (인덱스: 포트 번호)
+
+    std::deque<uint8_t> rxLine;             // 수신선 위에서 전송 중인 바이트
+    std::deque<uint8_t> rxBuffer;           // UART 수신 버퍼에 도착한 바이트
+    uint64_t nextRxArrival = 0;             // 다음 바이트 도착 시각
+    const size_t RX_BUFFER_SIZE = 64;       // AVR HardwareSerial 수신 버퍼 크기
+
+    std::deque<uint8_t> txBuffer;           // UART 송신 버퍼에서 선로를 기다리는 바이트
+    uint64_t txLineFree = 0;                // 송신 중인 바이트가 선로를 떠나는 시각
+    uint64_t txLineFreeExact = 0;           // 같은 시각 (마이크로초 x 통신 속도, 반올림 오차 누적 방지)
+    const size_t TX_BUFFER_SIZE = 64;       // AVR HardwareSerial 송신 버퍼 크기 (63 바이트 사용)
+
+    void (*timerIsr)() = nullptr;           // 가상 타이머 인터럽트 처리 함수
+    uint64_t timerPeriodUs = 0;             // 타이머 인터럽트 주기
+    uint64_t nextTimerFire = 0;             // 다음 타이머 인터럽트 시각
+
+    void (*serialSink)(uint8_t c, void* context) = nullptr;
+    void* serialSinkContext = nullptr;
+
+    bool isValidPin(uint8_t pin) {
+        return pin < NUM_DIGITAL_PINS;
+    }
+
+    // 핀의 현재 레벨을 가상 PINx 레지스터의 해당 비트에 반영합니다.
+    void syncPortBit(uint8_t pin) {
+        uint8_t port = digitalPinToPort(pin);
+        uint8_t mask = digitalPinToBitMask(pin);
+        if (digitalRead(pin)) {
+            portInputs[port] |= mask;
+        } else {
+            portInputs[port] &= (uint8_t)~mask;
+        }
+    }
+
+    void syncAllPortBits() {
+        for (uint8_t pin = 0; pin < NUM_DIGITAL_PINS; pin++) {
+            syncPortBit(pin);
+        }
+    }
+
+    uint64_t byteTimeMicros() {
+        // 8N1 프레임: 시작 비트 + 8 데이터 비트 + 정지 비트
+        return 10000000ULL / Serial.getBaudRate();
+    }
+
+    void pumpSerialRx() {
+        while (!rxLine.empty() && nextRxArrival <= virtualMicros) {
+            // 수신 버퍼가 가득 차면 AVR 과 동일하게 바이트가 유실됩니다.
+            if (rxBuffer.size() < RX_BUFFER_SIZE - 1) {
+                rxBuffer.push_back(rxLine.front());
+            }
+            rxLine.pop_front();
+            nextRxArrival += byteTimeMicros();
+        }
+    }
+
+    // 바이트 하나를 선로에 내보냅니다 (현재 시각에 송신 시작).
+    // 연달아 보내는 바이트는 앞 바이트의 정확한 끝 시각에 이어 붙여 실제 통신 속도를 지킵니다.
+    void startSerialTx(uint8_t c, bool followsPrevious) {
+        uint64_t baud = Serial.getBaudRate();
+        if (!followsPrevious) {
+            txLineFreeExact = virtualMicros * baud;
+        }
+        txLineFreeExact += 10000000ULL;  // 8N1 프레임 10 비트
+        txLineFree = (txLineFreeExact + baud - 1) / baud;
+        if (serialSink) {
+            serialSink(c, serialSinkContext);
+        } else {
+            fputc(c, stdout);
+        }
+    }
+
+    // 송신 중인 바이트가 선로를 떠날 때까지 가상 시간을 진행합니다.
+    void waitSerialTx() {
+        NativeHAL::advanceMicros(txLineFree > virtualMicros ? (unsigned long)(txLineFree - virtualMicros) : 0);
+    }
+
+    // 앞 바이트가 끝난 시각에 송신 버퍼의 다음 바이트를 내보냅니다.
+    // advanceMicros 가 송신 시작 시각마다 시간을 맞춰 부르므로 송신 처리 함수는 정확한 시각을 봅니다.
+    void pumpSerialTx() {
+        while (!txBuffer.empty() && txLineFree <= virtualMicros) {
+            uint8_t c = txBuffer.front();
+            txBuffer.pop_front();
+            startSerialTx(c, true);
+        }
+    }
+}
+
+namespace NativeHAL {
+
+    void advanceMicros(unsigned long us) {
+        uint64_t target = virtualMicros + us;
+        
+        // 타이머 인터럽트와 송신 바이트는 정확한 발생 시각에 처리되도록 시간을 나눠 진행합니다.
+        for (;;) {
+            bool timerDue = timerIsr != nullptr && nextTimerFire <= target;
+            bool txDue = !txBuffer.empty() && txLineFree <= target;
+            if (!timerDue && !txDue) {
+                break;
+            }
+            if (txDue && (!timerDue || txLineFree < nextTimerFire)) {
+                if (txLineFree > virtualMicros) {
+                    virtualMicros = txLineFree;
+                }
+                pumpSerialRx();
+                pumpSerialTx();
+                continue;
+            }
+            virtualMicros = nextTimerFire;
+            pumpSerialRx();
+            pumpSerialTx();
+            nextTimerFire += timerPeriodUs;
+            timerIsr();
+        }
+        
+        virtualMicros = target;
+        pumpSerialRx();
+        pumpSerialTx();
+    }
+
+    uint64_t nowMicros() {
+        return virtualMicros;
+    }
+
+    void attachTimerInterrupt(void (*isr)(), unsigned long periodUs) {
+        timerIsr = periodUs > 0 ? isr : nullptr;
+        timerPeriodUs = periodUs;
+        nextTimerFire = virtualMicros + periodUs;
+    }
+
+    void setInputLevel(uint8_t pin, int level) {
+        if (!isValidPin(pin)) return;
+        inputLevels[pin] = level ? HIGH : LOW;
+        syncPortBit(pin);
+    }
+
+    int getOutputLevel(uint8_t pin) {
+        return isValidPin(pin) ? outputLevels[pin] : LOW;
+    }
+
+    uint8_t getPinMode(uint8_t pin) {
+        return isValidPin(pin) ? pinModes[pin] : INPUT;
+    }
+
+    int getPwmDuty(uint8_t pin) {
+        return isValidPin(pin) ? pwmDuties[pin] : 0;
+    }
+
+    int getServoPulse(uint8_t pin) {
+        return isValidPin(pin) ? servoPulses[pin] : 0;
+    }
+
+    void setServoPulse(uint8_t pin, int pulseUs) {
+        if (isValidPin(pin)) servoPulses[pin] = pulseUs;
+    }
+
+    void feedSerial(const char* data, size_t length) {
+        if (rxLine.empty() && nextRxArrival < virtualMicros + byteTimeMicros()) {
+            nextRxArrival = virtualMicros + byteTimeMicros();
+        }
+        rxLine.insert(rxLine.end(), data, data + length);
+    }
+
+    size_t pendingSerialBytes() {
+        return rxLine.size();
+    }
+
+    size_t pendingSerialTxBytes() {
+        return txBuffer.size();
+    }
+
+    void setSerialSink(void (*sink)(uint8_t c, void* context), void* context) {
+        serialSink = sink;
+        serialSinkContext = context;
+    }
+
+    void reset() {
+        virtualMicros = 0;
+        memset(pinModes, INPUT, sizeof(pinModes));
+        memset(outputLevels, LOW, sizeof(outputLevels));
+        memset(inputLevels, HIGH, sizeof(inputLevels));
+        memset(pwmDuties, 0, sizeof(pwmDuties));
+        memset(servoPulses, 0, sizeof(servoPulses));
+        rxLine.clear();
+        rxBuffer.clear();
+        nextRxArrival = 0;
+        txBuffer.clear();
+        txLineFree = 0;
+        txLineFreeExact = 0;
+        timerIsr = nullptr;
+        timerPeriodUs = 0;
+        nextTimerFire = 0;
+        EEPROM.clear();
+        syncAllPortBits();
+    }
+
+} // namespace NativeHAL
+
+// ===== 시간 =====
+unsigned long millis() {
+    // AVR 과 동일하게 32비트에서 오버플로우합니다.
+    return (uint32_t)(virtualMicros / 1000);
+}
+
+unsigned long micros() {
+    return (uint32_t)virtualMicros;
+}
+
+void delay(unsigned long ms) {
+    NativeHAL::advanceMicros(ms * 1000UL);
+}
+
+void delayMicroseconds(unsigned int us) {
+    NativeHAL::advanceMicros(us);
+}
+
+void yield() {
+    // 바쁜 대기 한 바퀴: 실제 보드처럼 기다리는 동안 가상 시간이 흐릅니다.
+    NativeHAL::advanceMicros(10);
+}
+
+// ===== 디지털 / 아날로그 입출력 =====
+void pinMode(uint8_t pin, uint8_t mode) {
+    if (!isValidPin(pin)) return;
+    pinModes[pin] = mode;
+    syncPortBit(pin);
+}
+
+void digitalWrite(uint8_t pin, uint8_t value) {
+    if (!isValidPin(pin)) return;
+    outputLevels[pin] = value ? HIGH : LOW;
+    pwmDuties[pin] = value ? 255 : 0;
+    syncPortBit(pin);
+}
+
+int digitalRead(uint8_t pin) {
+    if (!isValidPin(pin)) return LOW;
+    if (pinModes[pin] == OUTPUT) return outputLevels[pin];
+    return inputLevels[pin];
+}
+
+void analogWrite(uint8_t pin, int value) {
+    if (!isValidPin(pin)) return;
+    if (value < 0) value = 0;
+    if (value > 255) value = 255;
+    pwmDuties[pin] = value;
+    outputLevels[pin] = value > 0 ? HIGH : LOW;
+    syncPortBit(pin);
+}
+
+int analogRead(uint8_t pin) {
+    if (!isValidPin(pin)) return 0;
+    return inputLevels[pin] ? 1023 : 0;
+}
+
+volatile uint8_t* portInputRegister(uint8_t port) {
+    return port <= NATIVE_PORT_COUNT ? &portInputs[port] : &portInputs[NOT_A_PORT];
+}
+
+// ===== String =====
+namespace {
+    std::string formatInteger(unsigned long value, bool negative, unsigned char base) {
+        if (base < 2) base = 10;
+        char digits[72];
+        int pos = sizeof(digits) - 1;
+        digits[pos] = '\0';
+        do {
+            unsigned long digit = value % base;
+            digits[--pos] = (char)(digit < 10 ? '0' + digit : 'A' + digit - 10);
+            value /= base;
+        } while (value > 0);
+        if (negative) digits[--pos] = '-';
+        return std::string(&digits[pos]);
+    }
+
+    std::string formatFloat(double value, unsigned char decimalPlaces) {
+        char text[64];
+        snprintf(text, sizeof(text), "%.*f", decimalPlaces, value);
+        return std::string(text);
+    }
+}
+
+String::String(unsigned char value, unsigned char base) : buffer(formatInteger(value, false, base)) {}
+String::String(int value, unsigned char base)
+    : buffer(base == 10 && value < 0 ? formatInteger(-(long)value, true, base) : formatInteger((unsigned int)value, false, base)) {}
+String::String(unsigned int value, unsigned char base) : buffer(formatInteger(value, false, base)) {}
+String::String(long value, unsigned char base)
+    : buffer(base == 10 && value < 0 ? formatInteger(0UL - (unsigned long)value, true, base) : formatInteger((unsigned long)value, false, base)) {}
+String::String(unsigned long value, unsigned char base) : buffer(formatInteger(value, false, base)) {}
+String::String(float value, unsigned char decimalPlaces) : buffer(formatFloat(value, decimalPlaces)) {}
+String::String(double value, unsigned char decimalPlaces) : buffer(formatFloat(value, decimalPlaces)) {}
+
+int String::indexOf(char c, unsigned int fromIndex) const {
+    size_t pos = buffer.find(c, fromIndex);
+    return pos == std::string::npos ? -1 : (int)pos;
+}
+
+int String::indexOf(const String& str, unsigned int fromIndex) const {
+    size_t pos = buffer.find(str.buffer, fromIndex);
+    return pos == std::string::npos ? -1 : (int)pos;
+}
+
+String String::substring(unsigned int beginIndex) const {
+    return substring(beginIndex, length());
+}
+
+String String::substring(unsigned int beginIndex, unsigned int endIndex) const {
+    if (beginIndex > endIndex) {
+        unsigned int temp = beginIndex;
+        beginIndex = endIndex;
+        endIndex = temp;
+    }
+    if (beginIndex >= length()) return String();
+    if (endIndex > length()) endIndex = length();
+    return String(buffer.substr(beginIndex, endIndex - beginIndex));
+}
+
+void String::trim() {
+    size_t begin = 0;
+    while (begin < buffer.length() && isspace((unsigned char)buffer[begin])) begin++;
+    size_t end = buffer.length();
+    while (end > begin && isspace((unsigned char)buffer[end - 1])) end--;
+    buffer = buffer.substr(begin, end - begin);
+}
+
+void String::toUpperCase() {
+    for (size_t i = 0; i < buffer.length(); i++) buffer[i] = (char)toupper((unsigned char)buffer[i]);
+}
+
+void String::toLowerCase() {
+    for (size_t i = 0; i < buffer.length(); i++) buffer[i] = (char)tolower((unsigned char)buffer[i]);
+}
+
+StringSumHelper operator+(const String& lhs, const String& rhs) {
+    String result(lhs);
+    result += rhs;
+    return StringSumHelper(result);
+}
+
+StringSumHelper operator+(const String& lhs, const char* rhs) {
+    String result(lhs);
+    result += rhs;
+    return StringSumHelper(result);
+}
+
+StringSumHelper operator+(const char* lhs, const String& rhs) {
+    String result(lhs);
+    result += rhs;
+    return StringSumHelper(result);
+}
+
+StringSumHelper operator+(const String& lhs, char rhs) {
+    String result(lhs);
+    result += rhs;
+    return StringSumHelper(result);
+}
+
+// ===== Print =====
+size_t Print::write(const uint8_t* buffer, size_t size) {
+    size_t n = 0;
+    while (size--) {
+        n += write(*buffer++);
+    }
+    return n;
+}
+
+size_t Print::print(long value, int base) {
+    return print(String(value, (unsigned char)base));
+}
+
+size_t Print::print(unsigned long value, int base) {
+    return print(String(value, (unsigned char)base));
+}
+
+size_t Print::print(double value, int digits) {
+    return print(String(value, (unsigned char)digits));
+}
+
+// ===== Stream =====
+int Stream::timedRead() {
+    unsigned long startMillis = millis();
+    do {
+        int c = read();
+        if (c >= 0) return c;
+        // 실제 보드처럼 다음 바이트가 도착할 때까지 가상 시간이 흐릅니다.
+        NativeHAL::advanceMicros(10);
+    } while (millis() - startMillis < timeoutMs);
+    return -1;
+}
+
+size_t Stream::readBytes(char* buffer, size_t length) {
+    size_t count = 0;
+    while (count < length) {
+        int c = timedRead();
+        if (c < 0) break;
+        *buffer++ = (char)c;
+        count++;
+    }
+    return count;
+}
+
+String Stream::readString() {
+    String result;
+    int c = timedRead();
+    while (c >= 0) {
+        result += (char)c;
+        c = timedRead();
+    }
+    return result;
+}
+
+String Stream::readStringUntil(char terminator) {
+    String result;
+    int c = timedRead();
+    while (c >= 0 && c != terminator) {
+        result += (char)c;
+        c = timedRead();
+    }
+    return result;
+}
+
+// ===== HardwareSerial =====
+HardwareSerial Serial;
+
+void HardwareSerial::begin(unsigned long baud) {
+    baudRate = baud > 0 ? baud : 9600;
+}
+
+int HardwareSerial::available() {
+    pumpSerialRx();
+    return (int)rxBuffer.size();
+}
+
+int HardwareSerial::read() {
+    pumpSerialRx();
+    if (rxBuffer.empty()) return -1;
+    uint8_t c = rxBuffer.front();
+    rxBuffer.pop_front();
+    return c;
+}
+
+int HardwareSerial::peek() {
+    pumpSerialRx();
+    return rxBuffer.empty() ? -1 : rxBuffer.front();
+}
+
+size_t HardwareSerial::write(uint8_t c) {
+    pumpSerialTx();
+    // 선로가 비어 있으면 AVR 처럼 버퍼를 거치지 않고 바로 송신을 시작합니다.
+    if (txBuffer.empty() && txLineFree <= virtualMicros) {
+        startSerialTx(c, false);
+        return 1;
+    }
+    // 송신 버퍼가 가득 차면 AVR 과 동일하게 자리가 날 때까지 기다립니다 (그동안 시간이 흐름).
+    while (txBuffer.size() >= TX_BUFFER_SIZE - 1) {
+        waitSerialTx();
+    }
+    txBuffer.push_back(c);
+    return 1;
+}
+
+size_t HardwareSerial::write(const uint8_t* buffer, size_t size) {
+    for (size_t i = 0; i < size; i++) {
+        write(buffer[i]);
+    }
+    return size;
+}
+
+int HardwareSerial::availableForWrite() {
+    pumpSerialTx();
+    return (int)(TX_BUFFER_SIZE - 1 - txBuffer.size());
+}
+
+void HardwareSerial::flush() {
+    // 마지막 바이트가 선로를 떠날 때까지 기다립니다 (AVR 의 송신 완료 대기).
+    while (!txBuffer.empty() || txLineFree > virtualMicros) {
+        waitSerialTx();
+    }
+    if (!serialSink) fflush(stdout);
+}
+
+// ===== Servo =====
+uint8_t Servo::attach(int pin) {
+    return attach(pin, MIN_PULSE_WIDTH, MAX_PULSE_WIDTH);
+}
+
+uint8_t Servo::attach(int pin, int min, int max) {
+    servoPin = pin;
+    minPulse = min;
+    maxPulse = max;
+    NativeHAL::setServoPulse((uint8_t)servoPin, pulseWidth);
+    return 0;
+}
+
+void Servo::detach() {
+    if (servoPin >= 0) NativeHAL::setServoPulse((uint8_t)servoPin, 0);
+    servoPin = -1;
+}
+
+void Servo::write(int value) {
+    if (value < MIN_PULSE_WIDTH) {
+        // Arduino Servo 와 동일하게 544 미만의 값은 각도로 해석합니다.
+        if (value < 0) value = 0;
+        if (value > 180) value = 180;
+        value = minPulse + (int)((long)(maxPulse - minPulse) * value / 180);
+    }
+    writeMicroseconds(value);
+}
+
+void Servo::writeMicroseconds(int value) {
+    if (value < minPulse) value = minPulse;
+    if (value > maxPulse) value = maxPulse;
+    pulseWidth = value;
+    if (servoPin >= 0) NativeHAL::setServoPulse((uint8_t)servoPin, pulseWidth);
+}
+
+int Servo::read() {
+    return (int)((long)(pulseWidth - minPulse) * 180 / (maxPulse - minPulse));
+}
+
+int Servo::readMicroseconds() {
+    return pulseWidth;
+}
+
+bool Servo::attached() {
+    return servoPin >= 0;
+}
+
+// ===== EEPROM =====
+EEPROMClass EEPROM;
+
+// ===== 진입점 =====
+// 시뮬레이터(NATIVE_HAL_NO_MAIN)와 단위 테스트(PIO_UNIT_TESTING)는 자체 main() 을 사용합니다.
+#if !defined(NATIVE_HAL_NO_MAIN) && !defined(PIO_UNIT_TESTING)
+#include <chrono>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <sys/ioctl.h>
+#include <termios.h>
+
+namespace {
+    int ptyMaster = -1;     // 가상 시리얼 포트 (호스트 프로그램은 슬레이브 쪽 /dev/pts/N 을 엽니다)
+    int ptySlave = -1;      // 호스트가 설정한 통신 속도를 읽기 위해 열어 둔 슬레이브
+
+    /**
+     * @brief 호스트가 슬레이브 쪽에 설정한 통신 속도 (알 수 없으면 0)
+     */
+    unsigned long getPtyBaudRate() {
+#if defined(__linux__)
+        // termios2 로 읽어야 250000 처럼 Bxxx 상수가 없는 속도도 숫자로 얻을 수 있습니다.
+        struct PtyTermios2 {
+            tcflag_t c_iflag, c_oflag, c_cflag, c_lflag;
+            cc_t c_line;
+            cc_t c_cc[19];
+            speed_t c_ispeed, c_ospeed;
+        } tio;
+        if (ioctl(ptySlave, _IOR('T', 0x2A, PtyTermios2), &tio) == 0) {
+            return tio.c_ospeed;
+        }
+#endif
+        return 0;
+    }
+
+    /**
+     * @brief 양쪽 통신 속도가 같은지 확인 (다르면 실제 UART 처럼 바이트가 깨짐)
+     */
+    bool isPtyBaudMatched() {
+        unsigned long hostBaud = getPtyBaudRate();
+        return hostBaud == 0 || hostBaud == Serial.getBaudRate();
+    }
+
+    void writePty(uint8_t c, void*) {
+        if (!isPtyBaudMatched()) {
+            c = 0xFF;
+        }
+        if (write(ptyMaster, &c, 1) < 0) {
+            // 호스트가 아직 포트를 열지 않았으면 버립니다.
+        }
+    }
+
+    /**
+     * @brief 가상 시리얼 포트를 pty 로 열기 (슬레이브 경로를 표준 에러로 알림)
+     */
+    bool openPty() {
+        ptyMaster = posix_openpt(O_RDWR | O_NOCTTY);
+        if (ptyMaster < 0 || grantpt(ptyMaster) != 0 || unlockpt(ptyMaster) != 0) {
+            perror("NativeHAL: posix_openpt");
+            return false;
+        }
+        const char* slaveName = ptsname(ptyMaster);
+        ptySlave = open(slaveName, O_RDWR | O_NOCTTY);
+        if (ptySlave < 0) {
+            perror("NativeHAL: open pty slave");
+            return false;
+        }
+
+        // 호스트가 열기 전에도 raw 9600bps 로 두고, 읽기는 막지 않게 합니다.
+        struct termios tio;
+        tcgetattr(ptySlave, &tio);
+        cfmakeraw(&tio);
+        cfsetispeed(&tio, B9600);
+        cfsetospeed(&tio, B9600);
+        tcsetattr(ptySlave, TCSANOW, &tio);
+        fcntl(ptyMaster, F_SETFL, fcntl(ptyMaster, F_GETFL) | O_NONBLOCK);
+
+        fprintf(stderr, "NativeHAL: serial port %s\n", slaveName);
+        NativeHAL::setSerialSink(writePty, nullptr);
+        return true;
+    }
+
+    /**
+     * @brief pty 모드 실행: 가상 시간을 실제 시간에 맞춰 진행하며 계속 실행
+     */
+    int runPty(unsigned long tickUs) {
+        if (!openPty()) {
+            return 1;
+        }
+
+        setup();
+
+        auto start = std::chrono::steady_clock::now();
+        while (true) {
+            uint8_t chunk[256];
+            ssize_t n = read(ptyMaster, chunk, sizeof(chunk));
+            if (n > 0) {
+                if (!isPtyBaudMatched()) {
+                    memset(chunk, 0xFF, (size_t)n);
+                }
+                NativeHAL::feedSerial((const char*)chunk, (size_t)n);
+            }
+
+            loop();
+
+            uint64_t wallUs = (uint64_t)std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::steady_clock::now() - start).count();
+            if (wallUs > NativeHAL::nowMicros()) {
+                NativeHAL::advanceMicros((unsigned long)(wallUs - NativeHAL::nowMicros()));
+            } else {
+                usleep(tickUs);
+            }
+        }
+    }
+}
+
+/**
+ * @brief 호스트 실행 진입점
+ *
+ * 표준 입력을 시리얼 수신선으로 보내고 setup()/loop() 를 가상 시간으로 실행합니다.
+ *  - NATIVE_TICK_US : loop() 1회당 진행할 가상 시간 (기본값 100us)
+ *  - NATIVE_RUN_MS  : 입력 전송이 끝난 뒤 추가로 실행할 가상 시간 (기본값 10000ms)
+ *  - NATIVE_PTY=1   : 표준 입출력 대신 pty 를 시리얼 포트로 열고 실제 시간으로 계속 실행
+ *                     (호스트 프로그램이 알려준 /dev/pts/N 을 열어 통신 속도 협상까지 시험할 수 있고,
+ *                      양쪽 통신 속도가 다르면 바이트가 깨집니다)
+ */
+int main() {
+    NativeHAL::reset();
+
+    const char* tickEnv = getenv("NATIVE_TICK_US");
+    const char* runEnv = getenv("NATIVE_RUN_MS");
+    const char* ptyEnv = getenv("NATIVE_PTY");
+    unsigned long tickUs = tickEnv ? strtoul(tickEnv, nullptr, 10) : 100;
+    uint64_t runUs = (runEnv ? strtoull(runEnv, nullptr, 10) : 10000) * 1000ULL;
+    if (tickUs == 0) tickUs = 1;
+
+    if (ptyEnv != nullptr && atoi(ptyEnv) != 0) {
+        return runPty(tickUs);
+    }
+
+    if (!isatty(STDIN_FILENO)) {
+        char chunk[256];
+        size_t n;
+        while ((n = fread(chunk, 1, sizeof(chunk), stdin)) > 0) {
+            NativeHAL::feedSerial(chunk, n);
+        }
+    }
+
+    setup();
+
+    uint64_t idleSince = NativeHAL::nowMicros();
+    while (true) {
+        loop();
+        NativeHAL::advanceMicros(tickUs);
+        if (NativeHAL::pendingSerialBytes() > 0 || Serial.available() > 0) {
+            idleSince = NativeHAL::nowMicros();
+        } else if (NativeHAL::nowMicros() - idleSince >= runUs) {
+            break;
+        }
+    }
+
+    fflush(stdout);
+    return 0;
+}
+#endif // !NATIVE_HAL_NO_MAIN && !PIO_UNIT_TESTING
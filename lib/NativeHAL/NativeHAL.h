@@ -0,0 +1,105 @@
+#ifndef NATIVEHAL_H
+#define NATIVEHAL_H
+
+#include <Arduino.h>
+
+/**
+ * @brief 호스트 빌드 전용 가상 하드웨어 제어 인터페이스
+ *
+ * 펌웨어 코드는 이 헤더를 사용하지 않습니다. (예외: 하드웨어 타이머를 쓰는 라이브러리가
+ * NATIVE_HAL 빌드에서 타이머 인터럽트를 대체할 때)
+ * 시뮬레이션/벤치마크 코드가 가상 시간을 진행시키고,
+ * 센서 입력을 주입하고, 액추에이터 출력을 관찰할 때 사용합니다.
+ */
+namespace NativeHAL {
+
+    // ===== 가상 시간 =====
+    /**
+     * @brief 가상 시간 진행
+     * @param us 진행할 시간 (마이크로초)
+     */
+    void advanceMicros(unsigned long us);
+
+    /**
+     * @brief 현재 가상 시간 반환 (64비트, 마이크로초)
+     */
+    uint64_t nowMicros();
+
+    // ===== 가상 타이머 인터럽트 =====
+    /**
+     * @brief 주기적 타이머 인터럽트 등록 (AVR 타이머 비교 일치 인터럽트 대체)
+     *
+     * 가상 시간이 주기 경계를 지날 때마다 해당 시각으로 시간을 맞춘 뒤 isr 을 호출합니다.
+     * delay() 나 시리얼 대기 중에도 호출되므로 loop() 가 바쁜 상황을 재현할 수 있습니다.
+     * @param isr 인터럽트 처리 함수 (nullptr: 해제)
+     * @param periodUs 호출 주기 (마이크로초)
+     */
+    void attachTimerInterrupt(void (*isr)(), unsigned long periodUs);
+
+    // ===== 가상 핀 =====
+    /**
+     * @brief 입력 핀 레벨 설정 (센서 신호 주입)
+     * @param pin 핀 번호
+     * @param level HIGH 또는 LOW
+     */
+    void setInputLevel(uint8_t pin, int level);
+
+    /**
+     * @brief 출력 핀 레벨 반환 (digitalWrite 결과)
+     */
+    int getOutputLevel(uint8_t pin);
+
+    /**
+     * @brief 핀 모드 반환 (pinMode 결과)
+     */
+    uint8_t getPinMode(uint8_t pin);
+
+    /**
+     * @brief PWM 듀티 반환 (analogWrite 결과, 0-255)
+     */
+    int getPwmDuty(uint8_t pin);
+
+    /**
+     * @brief 서보 펄스 폭 반환 (마이크로초, 미연결 시 0)
+     */
+    int getServoPulse(uint8_t pin);
+
+    /**
+     * @brief 서보 펄스 폭 기록 (Servo 대체 클래스에서 호출)
+     */
+    void setServoPulse(uint8_t pin, int pulseUs);
+
+    // ===== 가상 시리얼 =====
+    /**
+     * @brief 시리얼 수신선에 데이터 주입
+     *
+     * 주입된 바이트는 현재 통신 속도에 맞춘 간격으로 수신 버퍼에 도착합니다.
+     */
+    void feedSerial(const char* data, size_t length);
+
+    /**
+     * @brief 아직 수신선에서 도착하지 않은 바이트 수
+     */
+    size_t pendingSerialBytes();
+
+    /**
+     * @brief 송신 버퍼에서 아직 선로로 나가지 않은 바이트 수
+     *
+     * 송신 버퍼는 통신 속도(바이트당 10 비트)로 비워지며, 송신 처리 함수는 바이트가
+     * 선로에 나가기 시작하는 시각에 호출됩니다.
+     */
+    size_t pendingSerialTxBytes();
+
+    /**
+     * @brief 송신 데이터 처리 함수 설정 (nullptr: 표준 출력)
+     */
+    void setSerialSink(void (*sink)(uint8_t c, void* context), void* context);
+
+    /**
+     * @brief 가상 하드웨어 상태 초기화 (시간, 핀, 시리얼, EEPROM)
+     */
+    void reset();
+
+} // namespace NativeHAL
+
+#endif // NATIVEHAL_H
@@ -0,0 +1,33 @@
+#ifndef NATIVEHAL_SERVO_H
+#define NATIVEHAL_SERVO_H
+
+#include <Arduino.h>
+
+#define MIN_PULSE_WIDTH       544
+#define MAX_PULSE_WIDTH      2400
+#define DEFAULT_PULSE_WIDTH  1500
+
+/**
+ * @brief 호스트 빌드용 Servo 라이브러리 대체 클래스
+ *
+ * 펄스 폭을 NativeHAL 의 가상 핀 상태에 기록합니다.
+ */
+class Servo {
+public:
+    uint8_t attach(int pin);
+    uint8_t attach(int pin, int min, int max);
+    void detach();
+    void write(int value);
+    void writeMicroseconds(int value);
+    int read();
+    int readMicroseconds();
+    bool attached();
+
+private:
+    int servoPin = -1;
+    int minPulse = MIN_PULSE_WIDTH;
+    int maxPulse = MAX_PULSE_WIDTH;
+    int pulseWidth = DEFAULT_PULSE_WIDTH;
+};
+
+#endif // NATIVEHAL_SERVO_H
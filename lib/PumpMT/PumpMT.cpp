@@ -1,20 +1,135 @@
 #include "PumpMT.h"
+#include "Channels.h"  // ChannelConfig 정의 (프로젝트 include/)
 
-PumpMT::PumpMT(int pin, String name) 
-    : pumpPin(pin), pumpState(false), name(name) {
+PumpMT::PumpMT(int pin, const char* name)
+    : pumpPin(pin), pumpState(false), pwmCapable(digitalPinToTimer(pin) != NOT_ON_TIMER),
+      targetDuty(0), currentDuty(0.0f), softStartMs(0), softStopMs(0), lastUpdateMicros(0),
+      timedRun(false), cutOffCount(0), seenCutOffCount(0), runStartMs(0), runDurationMs(0), finishMs(0), finishDuty(PUMP_DUTY_MAX), name(name) {
+}
+
+PumpMT::PumpMT()
+    : pumpPin(-1), pumpState(false), pwmCapable(false),
+      targetDuty(0), currentDuty(0.0f), softStartMs(0), softStopMs(0), lastUpdateMicros(0),
+      timedRun(false), cutOffCount(0), seenCutOffCount(0), runStartMs(0), runDurationMs(0), finishMs(0), finishDuty(PUMP_DUTY_MAX), name(nullptr) {
+}
+
+void PumpMT::begin(const ChannelConfig& config) {
+    pumpPin = config.actuatorPin;
+    pwmCapable = digitalPinToTimer(pumpPin) != NOT_ON_TIMER;
+    name = config.name;
+    begin();
+}
+
+void PumpMT::begin() {
     pinMode(pumpPin, OUTPUT);
     digitalWrite(pumpPin, PUMP_STATE_OFF);  // 초기 상태: 펌프 OFF
-    Serial.println(name + " PumpMT initialized");
+    pumpState = false;
+    targetDuty = 0;
+    currentDuty = 0.0f;
+    lastUpdateMicros = micros();
+    Serial.print(name);
+    Serial.println(F(" PumpMT initialized"));
 }
 
 void PumpMT::turnOn() {
-    digitalWrite(pumpPin, PUMP_STATE_ON);
-    pumpState = true;
+    setDuty(PUMP_DUTY_MAX);
 }
 
 void PumpMT::turnOff() {
-    digitalWrite(pumpPin, PUMP_STATE_OFF);
+    timedRun = false;
+    setDuty(0);
+}
+
+void PumpMT::cutOff() {
+    timedRun = false;
+    targetDuty = 0;
     pumpState = false;
+    cutOffCount++;
+    writeOutput(0);
+}
+
+void PumpMT::setDuty(uint8_t duty) {
+    targetDuty = duty;
+    pumpState = duty > 0;
+
+    // 램프가 없거나 PWM 이 안 되는 핀은 바로 출력합니다.
+    bool ramped = pwmCapable && (duty > currentDuty ? softStartMs : softStopMs) > 0;
+    if (!ramped) {
+        currentDuty = duty;
+        writeOutput(duty);
+    }
+}
+
+void PumpMT::setRamps(uint16_t softStartMs, uint16_t softStopMs) {
+    this->softStartMs = softStartMs;
+    this->softStopMs = softStopMs;
+}
+
+void PumpMT::update() {
+    uint32_t now = micros();
+    uint32_t elapsedUs = now - lastUpdateMicros;
+    lastUpdateMicros = now;
+
+    // 분배 종료 인터럽트(cutOff)가 바꾸는 값은 인터럽트를 막고 복사만 한 뒤, 계산은 인터럽트를 켜고 합니다.
+    noInterrupts();
+    uint8_t target = targetDuty;
+    bool running = timedRun;
+    uint8_t cutOffs = cutOffCount;
+    interrupts();
+
+    // 지난 update() 뒤에 cutOff() 가 핀을 내렸으면 현재 듀티도 0에서 시작합니다.
+    if (cutOffs != seenCutOffCount) {
+        seenCutOffCount = cutOffs;
+        currentDuty = 0.0f;
+    }
+
+    // 시간 제어: 마무리 구간에서 듀티를 낮추고, 시간이 끝나면 정지
+    if (running) {
+        unsigned long elapsedMs = millis() - runStartMs;
+        if (elapsedMs >= runDurationMs) {
+            running = false;
+            target = 0;
+        } else if (runDurationMs - elapsedMs <= finishMs && target > finishDuty) {
+            target = finishDuty;
+        }
+    }
+
+    // 램프: 최대 듀티 전체를 softStartMs/softStopMs 에 걸쳐 바꾸는 기울기로 목표에 접근
+    float duty = currentDuty;
+    if (duty != target) {
+        uint16_t rampMs = target > duty ? softStartMs : softStopMs;
+        float step = (pwmCapable && rampMs > 0) ? (float)PUMP_DUTY_MAX * elapsedUs / (rampMs * 1000.0f) : PUMP_DUTY_MAX;
+        if (duty < target) {
+            duty = (duty + step < target) ? duty + step : target;
+        } else {
+            duty = (duty - step > target) ? duty - step : target;
+        }
+    }
+
+    // 계산하는 동안 cutOff() 가 핀을 내렸으면 그 결과를 덮어쓰지 않습니다.
+    noInterrupts();
+    bool cut = cutOffCount != cutOffs;
+    if (!cut) {
+        targetDuty = target;
+        timedRun = running;
+        pumpState = target > 0;
+    }
+    interrupts();
+    if (cut) {
+        return;
+    }
+
+    if (duty != currentDuty) {
+        currentDuty = duty;
+        writeOutput((uint8_t)(duty + 0.5f));
+        // 출력하는 사이에 끊겼으면 다시 내립니다.
+        noInterrupts();
+        if (cutOffCount != cutOffs) {
+            currentDuty = 0.0f;
+            writeOutput(0);
+        }
+        interrupts();
+    }
 }
 
 void PumpMT::toggle() {
@@ -33,15 +148,32 @@ bool PumpMT::isOff() const {
     return !pumpState;
 }
 
-void PumpMT::runForDuration(unsigned long durationMs) {
-    if (durationMs > 0) {
-        turnOn();
-        delay(durationMs);
-        turnOff();
+bool PumpMT::isRunning() const {
+    return timedRun;
+}
+
+uint8_t PumpMT::getDuty() const {
+    return (uint8_t)(currentDuty + 0.5f);
+}
+
+bool PumpMT::isPwmCapable() const {
+    return pwmCapable;
+}
+
+void PumpMT::runFor(unsigned long durationMs, uint8_t finishDuty, unsigned long finishMs) {
+    if (durationMs == 0) {
+        return;
     }
+    this->finishDuty = finishDuty;
+    this->finishMs = finishMs;
+    runStartMs = millis();
+    runDurationMs = durationMs;
+    timedRun = true;
+    // 작동 시간이 마무리 구간보다 짧으면 처음부터 마무리 듀티로 작동
+    setDuty(durationMs <= finishMs ? finishDuty : PUMP_DUTY_MAX);
 }
 
-String PumpMT::getStateString() {
+const char* PumpMT::getStateString() {
     if (pumpState) {
         return "ON";
     } else {
@@ -53,6 +185,14 @@ int PumpMT::getPin() const {
     return pumpPin;
 }
 
-String PumpMT::getName() const {
+const char* PumpMT::getName() const {
     return name;
-} 
\ No newline at end of file
+}
+
+void PumpMT::writeOutput(uint8_t duty) {
+    if (pwmCapable) {
+        analogWrite(pumpPin, duty);
+    } else {
+        digitalWrite(pumpPin, duty > 0 ? PUMP_STATE_ON : PUMP_STATE_OFF);
+    }
+}
@@ -3,36 +3,89 @@
 
 #include <Arduino.h>
 
+// 채널 설정 항목 (정의: include/Channels.h)
+struct ChannelConfig;
+
 // ===== 펌프 상태 정의 =====
 #define PUMP_STATE_OFF LOW     // 펌프 정지
 #define PUMP_STATE_ON HIGH     // 펌프 작동
 
+// ===== 출력 세기 =====
+#define PUMP_DUTY_MAX 255      // 최대 듀티 (PWM 이 안 되는 핀은 0 초과면 ON)
+
 /**
  * @brief 펌프 제어 클래스
  * 
  * 릴레이를 통해 펌프를 제어합니다.
  * ON/OFF 제어, 토글, 시간 제어 기능을 제공합니다.
+ * 
+ * PWM 이 가능한 핀에서는 듀티로 유량을 조절하고, 소프트 스타트/스톱 램프를 적용합니다.
+ * 램프와 시간 제어는 update() 가 매 loop()에서 조금씩 진행하므로 블로킹하지 않습니다.
+ * PWM 이 안 되는 핀은 램프 없이 ON/OFF 로 동작합니다.
  */
 class PumpMT {
 public:
     /**
      * @brief 생성자
      * @param pin 펌프 릴레이 연결 핀 번호
-     * @param name 펌프 식별 이름
+     * @param name 펌프 식별 이름 (문자열 상수)
+     */
+    PumpMT(int pin, const char* name);
+
+    /**
+     * @brief 기본 생성자 (핀과 이름은 begin(const ChannelConfig&)에서 설정)
+     */
+    PumpMT();
+
+    // ===== 초기화 메서드 =====
+    /**
+     * @brief 핀 설정 및 펌프 OFF (setup()에서 호출)
      */
-    PumpMT(int pin, String name);
+    void begin();
+
+    /**
+     * @brief 채널 설정의 핀과 이름으로 핀 설정 및 펌프 OFF
+     * @param config 분배 채널 설정 (ACTUATOR_PUMP)
+     */
+    void begin(const ChannelConfig& config);
 
     // ===== 기본 제어 메서드 =====
     /**
-     * @brief 펌프 켜기
+     * @brief 펌프 켜기 (최대 듀티까지 소프트 스타트)
      */
     void turnOn();
     
     /**
-     * @brief 펌프 끄기
+     * @brief 펌프 끄기 (소프트 스톱, 시간 제어 취소, 인터럽트에서도 호출 가능)
      */
     void turnOff();
     
+    /**
+     * @brief 즉시 정지 (램프 없이 핀을 바로 내림, 시간 제어 취소, 인터럽트 전용)
+     *
+     * 분배 종료 타이머가 정한 시각에 유량이 끊겨야 하므로 소프트 스톱을 건너뜁니다.
+     * 현재 듀티는 다음 update() 에서 0으로 맞춥니다.
+     */
+    void cutOff();
+    
+    /**
+     * @brief 목표 듀티 설정 (램프를 따라 변경)
+     * @param duty 목표 듀티 (0 ~ PUMP_DUTY_MAX, 0: 정지)
+     */
+    void setDuty(uint8_t duty);
+    
+    /**
+     * @brief 소프트 스타트/스톱 램프 시간 설정
+     * @param softStartMs 0에서 최대 듀티까지 걸리는 시간 (밀리초, 0: 즉시)
+     * @param softStopMs 최대 듀티에서 0까지 걸리는 시간 (밀리초, 0: 즉시)
+     */
+    void setRamps(uint16_t softStartMs, uint16_t softStopMs);
+    
+    /**
+     * @brief 램프와 시간 제어 진행 (매 loop()에서 호출, 논블로킹)
+     */
+    void update();
+    
     /**
      * @brief 펌프 상태 토글
      */
@@ -51,19 +104,38 @@ public:
      */
     bool isOff() const;
     
+    /**
+     * @brief 시간 제어 실행 중인지 확인
+     */
+    bool isRunning() const;
+    
+    /**
+     * @brief 현재 출력 듀티 반환 (램프 진행 중이면 중간값)
+     */
+    uint8_t getDuty() const;
+    
+    /**
+     * @brief PWM 출력 가능한 핀인지 확인
+     */
+    bool isPwmCapable() const;
+    
     // ===== 시간 제어 메서드 =====
     /**
-     * @brief 지정된 시간 동안 펌프 작동
+     * @brief 지정된 시간 동안 펌프 작동 (논블로킹, update()가 종료 처리)
+     *
+     * 마지막 finishMs 동안은 finishDuty 로 유량을 줄여 튀지 않게 마무리합니다.
      * @param durationMs 작동 시간 (밀리초)
+     * @param finishDuty 마무리 구간 듀티 (기본값: 최대)
+     * @param finishMs 마무리 구간 길이 (밀리초, 기본값: 없음)
      */
-    void runForDuration(unsigned long durationMs);
+    void runFor(unsigned long durationMs, uint8_t finishDuty = PUMP_DUTY_MAX, unsigned long finishMs = 0);
     
     // ===== 정보 반환 메서드 =====
     /**
      * @brief 현재 펌프 상태 문자열 반환
-     * @return "ON" 또는 "OFF"
+     * @return "ON" 또는 "OFF" (정적 문자열)
      */
-    String getStateString();
+    const char* getStateString();
     
     /**
      * @brief 펌프 핀 번호 반환
@@ -75,12 +147,30 @@ public:
      * @brief 펌프 이름 반환
      * @return 이름
      */
-    String getName() const;
+    const char* getName() const;
 
 private:
+    /**
+     * @brief 듀티를 핀에 출력
+     */
+    void writeOutput(uint8_t duty);
+
     int pumpPin;            // 펌프 릴레이 핀 번호
-    bool pumpState;         // 펌프 상태
-    String name;           // 펌프 이름
+    volatile bool pumpState;  // 펌프 상태 (목표 듀티가 0 초과)
+    bool pwmCapable;        // PWM 출력 가능 여부
+    volatile uint8_t targetDuty;  // 목표 듀티 (분배 종료 인터럽트에서도 변경)
+    float currentDuty;      // 현재 출력 듀티 (램프 진행 중 소수)
+    uint16_t softStartMs;   // 소프트 스타트 시간 (밀리초)
+    uint16_t softStopMs;    // 소프트 스톱 시간 (밀리초)
+    uint32_t lastUpdateMicros;  // 직전 update() 시각
+    volatile bool timedRun; // 시간 제어 실행 중
+    volatile uint8_t cutOffCount; // cutOff() 호출 횟수 (update() 계산 중 끊겼는지 확인)
+    uint8_t seenCutOffCount;      // update() 가 마지막으로 반영한 cutOffCount
+    unsigned long runStartMs;     // 시간 제어 시작 시각
+    unsigned long runDurationMs;  // 시간 제어 작동 시간
+    unsigned long finishMs;       // 마무리 구간 길이
+    uint8_t finishDuty;           // 마무리 구간 듀티
+    const char* name;      // 펌프 이름
 };
 
 #endif // PUMPMT_H 
\ No newline at end of file
@@ -0,0 +1,75 @@
+#include "RecipeRunner.h"
+
+RecipeRunner::RecipeRunner(const Recipe* recipes, uint8_t recipeCount)
+    : recipes(recipes), recipeCount(recipeCount), running(false), nextStepIndex(0), startTime(0) {
+    activeRecipe.id = 0;
+    activeRecipe.steps = nullptr;
+    activeRecipe.stepCount = 0;
+}
+
+bool RecipeRunner::start(uint8_t recipeId, unsigned long currentTime) {
+    if (!findRecipe(recipeId, activeRecipe)) {
+        return false;
+    }
+    
+    running = true;
+    nextStepIndex = 0;
+    startTime = currentTime;
+    return true;
+}
+
+bool RecipeRunner::getDueStep(unsigned long currentTime, RecipeStep& step) const {
+    if (!running || isAllStepsStarted()) {
+        return false;
+    }
+    
+    memcpy_P(&step, &activeRecipe.steps[nextStepIndex], sizeof(RecipeStep));
+    return currentTime - startTime >= (unsigned long)step.offsetCs * 10UL;
+}
+
+unsigned long RecipeRunner::getNextStepTime() const {
+    if (!running || isAllStepsStarted()) {
+        return startTime;
+    }
+    
+    uint16_t offsetCs = pgm_read_word(&activeRecipe.steps[nextStepIndex].offsetCs);
+    return startTime + (unsigned long)offsetCs * 10UL;
+}
+
+void RecipeRunner::advance() {
+    if (running && !isAllStepsStarted()) {
+        nextStepIndex++;
+    }
+}
+
+void RecipeRunner::stop() {
+    running = false;
+    nextStepIndex = 0;
+}
+
+bool RecipeRunner::isRunning() const {
+    return running;
+}
+
+bool RecipeRunner::isAllStepsStarted() const {
+    return nextStepIndex >= activeRecipe.stepCount;
+}
+
+uint8_t RecipeRunner::getRecipeId() const {
+    return activeRecipe.id;
+}
+
+bool RecipeRunner::hasRecipe(uint8_t recipeId) const {
+    Recipe recipe;
+    return findRecipe(recipeId, recipe);
+}
+
+bool RecipeRunner::findRecipe(uint8_t recipeId, Recipe& recipe) const {
+    for (uint8_t i = 0; i < recipeCount; i++) {
+        memcpy_P(&recipe, &recipes[i], sizeof(Recipe));
+        if (recipe.id == recipeId) {
+            return true;
+        }
+    }
+    return false;
+}
@@ -0,0 +1,112 @@
+#ifndef RECIPERUNNER_H
+#define RECIPERUNNER_H
+
+#include <Arduino.h>
+#include <SerialCommand.h>
+
+// ===== 레시피 데이터 구조 =====
+/**
+ * @brief 레시피 단계 (시간 단위: 10밀리초)
+ */
+struct RecipeStep {
+    uint16_t offsetCs;      // 레시피 시작 기준 시작 시각 (1/100초)
+    uint8_t type;           // 실행할 명령 타입 (CommandType)
+    uint16_t durationCs;    // 실행 시간 (1/100초)
+};
+
+/**
+ * @brief 레시피 (단계 배열은 플래시 메모리에 저장)
+ */
+struct Recipe {
+    uint8_t id;                 // 레시피 번호 (R 명령 값)
+    const RecipeStep* steps;    // 단계 배열 (PROGMEM, 시작 시각 오름차순)
+    uint8_t stepCount;          // 단계 수
+};
+
+/**
+ * @brief 레시피 타임라인 실행기
+ * 
+ * 레시피 단계들을 시작 시각 순서대로 내보냅니다.
+ * 액추에이터를 직접 제어하지 않으며, 호출 측이 채널 상태를 확인한 뒤
+ * 단계를 시작하고 advance()로 다음 단계로 넘어갑니다.
+ */
+class RecipeRunner {
+public:
+    /**
+     * @brief 생성자
+     * @param recipes 레시피 테이블 (PROGMEM)
+     * @param recipeCount 레시피 수
+     */
+    RecipeRunner(const Recipe* recipes, uint8_t recipeCount);
+
+    // ===== 실행 제어 메서드 =====
+    /**
+     * @brief 레시피 실행 시작
+     * @param recipeId 레시피 번호
+     * @param currentTime 현재 시간 (밀리초)
+     * @return true: 시작됨, false: 해당 번호의 레시피 없음
+     */
+    bool start(uint8_t recipeId, unsigned long currentTime);
+    
+    /**
+     * @brief 시작 시각이 된 다음 단계 조회
+     * @param currentTime 현재 시간 (밀리초)
+     * @param step 조회된 단계를 저장할 구조체
+     * @return true: 시작할 단계 있음, false: 아직 없음
+     */
+    bool getDueStep(unsigned long currentTime, RecipeStep& step) const;
+    
+    /**
+     * @brief 다음 단계의 시작 시각 반환
+     * @return 시작 시각 (밀리초, 실행 중이 아니거나 남은 단계가 없으면 의미 없음)
+     */
+    unsigned long getNextStepTime() const;
+    
+    /**
+     * @brief 다음 단계로 진행
+     */
+    void advance();
+    
+    /**
+     * @brief 레시피 실행 종료 (완료 또는 중단)
+     */
+    void stop();
+    
+    // ===== 상태 확인 메서드 =====
+    /**
+     * @brief 레시피 실행 중 여부
+     */
+    bool isRunning() const;
+    
+    /**
+     * @brief 모든 단계를 시작했는지 확인
+     */
+    bool isAllStepsStarted() const;
+    
+    /**
+     * @brief 실행 중인 레시피 번호 반환
+     */
+    uint8_t getRecipeId() const;
+    
+    /**
+     * @brief 레시피 존재 여부 확인
+     * @param recipeId 레시피 번호
+     */
+    bool hasRecipe(uint8_t recipeId) const;
+
+private:
+    /**
+     * @brief 레시피 테이블에서 번호로 검색
+     * @return true: 찾음 (recipe 에 복사), false: 없음
+     */
+    bool findRecipe(uint8_t recipeId, Recipe& recipe) const;
+
+    const Recipe* recipes;      // 레시피 테이블 (PROGMEM)
+    uint8_t recipeCount;        // 레시피 수
+    Recipe activeRecipe;        // 실행 중인 레시피 (RAM 사본)
+    bool running;               // 실행 중 여부
+    uint8_t nextStepIndex;      // 다음에 시작할 단계 번호
+    unsigned long startTime;    // 레시피 시작 시각 (밀리초)
+};
+
+#endif // RECIPERUNNER_H
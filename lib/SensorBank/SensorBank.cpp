@@ -0,0 +1,117 @@
+#include "SensorBank.h"
+
+SensorBank::SensorBank()
+    : portCount(0), pinCount(0), stableBits(0), rawBits(0), lastSampleTime(0) {
+}
+
+int8_t SensorBank::addPin(uint8_t pin) {
+    // 같은 핀을 두 번 등록하면 기존 인덱스를 공유합니다.
+    for (uint8_t i = 0; i < pinCount; i++) {
+        if (pins[i].pin == pin) {
+            return (int8_t)i;
+        }
+    }
+    
+    if (pinCount >= SENSOR_BANK_MAX_PINS || digitalPinToPort(pin) == NOT_A_PORT) {
+        return -1;
+    }
+    
+    PinSlot& slot = pins[pinCount];
+    slot.pin = pin;
+    slot.portSlot = 0;
+    slot.bitMask = digitalPinToBitMask(pin);
+    slot.history = 0;
+    return (int8_t)pinCount++;
+}
+
+void SensorBank::begin() {
+    // 핀별 포트 레지스터 주소를 미리 계산하고, 같은 포트의 핀은 한 슬롯을 공유합니다.
+    portCount = 0;
+    for (uint8_t i = 0; i < pinCount; i++) {
+        volatile uint8_t* inputRegister = portInputRegister(digitalPinToPort(pins[i].pin));
+        
+        uint8_t slot = 0;
+        while (slot < portCount && ports[slot].inputRegister != inputRegister) {
+            slot++;
+        }
+        if (slot == portCount) {
+            ports[portCount].inputRegister = inputRegister;
+            ports[portCount].value = 0;
+            portCount++;
+        }
+        pins[i].portSlot = slot;
+    }
+    
+    // 첫 샘플로 이력을 채워 디바운스 대기 없이 현재 상태에서 시작합니다.
+    sample();
+    for (uint8_t i = 0; i < pinCount; i++) {
+        pins[i].history = (rawBits & (1 << i)) ? HISTORY_MASK : 0;
+    }
+    stableBits = rawBits;
+    lastSampleTime = millis();
+}
+
+bool SensorBank::update(unsigned long currentTime) {
+    if (currentTime - lastSampleTime < SENSOR_BANK_TICK_MS) {
+        return false;
+    }
+    lastSampleTime = currentTime;
+    sample();
+    return true;
+}
+
+void SensorBank::sample() {
+    // 모든 포트를 연달아 읽어 같은 시점의 스냅샷을 만듭니다.
+    for (uint8_t slot = 0; slot < portCount; slot++) {
+        ports[slot].value = *ports[slot].inputRegister;
+    }
+    
+    uint8_t newRawBits = 0;
+    for (uint8_t i = 0; i < pinCount; i++) {
+        PinSlot& pin = pins[i];
+        uint8_t bit = (uint8_t)(1 << i);
+        bool isHigh = (ports[pin.portSlot].value & pin.bitMask) != 0;
+        
+        pin.history = (uint8_t)(((pin.history << 1) | (isHigh ? 1 : 0)) & HISTORY_MASK);
+        if (isHigh) {
+            newRawBits |= bit;
+        }
+        
+        // 다수결 디바운스: 임계값 사이에서는 이전 상태를 유지합니다.
+        uint8_t highSamples = countHighSamples(pin.history);
+        if (highSamples >= SENSOR_BANK_HIGH_THRESHOLD) {
+            stableBits |= bit;
+        } else if (highSamples <= SENSOR_BANK_LOW_THRESHOLD) {
+            stableBits &= (uint8_t)~bit;
+        }
+    }
+    rawBits = newRawBits;
+}
+
+int SensorBank::read(int8_t index) const {
+    if (index < 0 || index >= (int8_t)pinCount) {
+        return LOW;
+    }
+    return (stableBits & (1 << index)) ? HIGH : LOW;
+}
+
+uint8_t SensorBank::getStableBits() const {
+    return stableBits;
+}
+
+uint8_t SensorBank::getRawBits() const {
+    return rawBits;
+}
+
+uint8_t SensorBank::getPinCount() const {
+    return pinCount;
+}
+
+uint8_t SensorBank::countHighSamples(uint8_t history) {
+    uint8_t count = 0;
+    while (history) {
+        history &= (uint8_t)(history - 1);
+        count++;
+    }
+    return count;
+}
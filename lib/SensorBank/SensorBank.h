@@ -0,0 +1,112 @@
+#ifndef SENSORBANK_H
+#define SENSORBANK_H
+
+#include <Arduino.h>
+
+// ===== 센서 뱅크 설정 =====
+#define SENSOR_BANK_MAX_PINS 8           // 등록 가능한 최대 입력 핀 수
+#define SENSOR_BANK_TICK_MS 2            // 샘플링 주기 (밀리초)
+#define SENSOR_BANK_HISTORY 8            // 핀별로 보관하는 최근 샘플 수 (비트 이력, 최대 8)
+#define SENSOR_BANK_HIGH_THRESHOLD 6     // 최근 샘플 중 HIGH 가 이 개수 이상이면 HIGH 로 전환
+#define SENSOR_BANK_LOW_THRESHOLD 2      // 최근 샘플 중 HIGH 가 이 개수 이하이면 LOW 로 전환
+
+/**
+ * @brief 입력 핀 일괄 샘플링 클래스
+ * 
+ * 등록된 센서 핀을 고정 주기마다 포트 입력 레지스터(PINx)에서 한 번에 읽어
+ * 모든 센서가 같은 시점의 스냅샷을 갖게 합니다.
+ * 핀별 최근 샘플 이력으로 다수결 디바운스를 적용하며, 두 임계값 사이에서는
+ * 이전 상태를 유지하므로 분말이 흩날려 생기는 짧은 깜빡임은 무시됩니다.
+ */
+class SensorBank {
+public:
+    /**
+     * @brief 생성자
+     */
+    SensorBank();
+
+    // ===== 핀 등록 및 초기화 메서드 =====
+    /**
+     * @brief 입력 핀 등록 (센서 클래스의 begin()에서 호출)
+     * @param pin 핀 번호
+     * @return 뱅크 내 인덱스 (등록 실패 시 -1)
+     */
+    int8_t addPin(uint8_t pin);
+    
+    /**
+     * @brief 포트 레지스터 주소 계산 및 초기 샘플로 이력 채우기 (모든 센서 begin() 후 호출)
+     */
+    void begin();
+
+    // ===== 샘플링 메서드 =====
+    /**
+     * @brief 샘플링 주기가 지났으면 모든 핀을 한 번에 샘플링
+     * @param currentTime 현재 시간 (밀리초)
+     * @return true: 이번 호출에서 샘플링함
+     */
+    bool update(unsigned long currentTime);
+    
+    /**
+     * @brief 모든 핀을 즉시 한 번 샘플링하고 디바운스 상태 갱신
+     */
+    void sample();
+
+    // ===== 상태 반환 메서드 =====
+    /**
+     * @brief 디바운스된 핀 레벨 반환 (캐시된 스냅샷, 하드웨어 접근 없음)
+     * @param index addPin() 이 반환한 인덱스
+     * @return HIGH 또는 LOW
+     */
+    int read(int8_t index) const;
+    
+    /**
+     * @brief 디바운스된 전체 핀 레벨 (비트 i = 인덱스 i)
+     */
+    uint8_t getStableBits() const;
+    
+    /**
+     * @brief 마지막 샘플의 원시 핀 레벨 (비트 i = 인덱스 i)
+     */
+    uint8_t getRawBits() const;
+    
+    /**
+     * @brief 등록된 핀 수
+     */
+    uint8_t getPinCount() const;
+
+private:
+    /**
+     * @brief 서로 다른 포트별 입력 레지스터 (핀마다 읽지 않고 포트당 한 번 읽음)
+     */
+    struct PortSlot {
+        volatile uint8_t* inputRegister;   // PINx 레지스터 주소
+        uint8_t value;                     // 이번 샘플에서 읽은 값
+    };
+    
+    /**
+     * @brief 핀별 매핑과 샘플 이력
+     */
+    struct PinSlot {
+        uint8_t pin;                       // 핀 번호
+        uint8_t portSlot;                  // ports[] 인덱스
+        uint8_t bitMask;                   // 포트 내 비트
+        uint8_t history;                   // 최근 샘플 (LSB 가 최신, 1 = HIGH)
+    };
+    
+    /**
+     * @brief 이력의 HIGH 샘플 수 계산
+     */
+    static uint8_t countHighSamples(uint8_t history);
+
+    static const uint8_t HISTORY_MASK = (uint8_t)((1u << SENSOR_BANK_HISTORY) - 1);
+    
+    PortSlot ports[SENSOR_BANK_MAX_PINS];  // 사용하는 포트 목록
+    PinSlot pins[SENSOR_BANK_MAX_PINS];    // 등록된 핀 목록
+    uint8_t portCount;                     // 사용하는 포트 수
+    uint8_t pinCount;                      // 등록된 핀 수
+    uint8_t stableBits;                    // 디바운스된 핀 레벨
+    uint8_t rawBits;                       // 마지막 원시 샘플
+    unsigned long lastSampleTime;          // 마지막 샘플링 시각 (밀리초)
+};
+
+#endif // SENSORBANK_H
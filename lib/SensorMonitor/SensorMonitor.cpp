@@ -0,0 +1,46 @@
+#include "SensorMonitor.h"
+
+SensorMonitor::SensorMonitor(uint8_t sensorCount, uint8_t debounceSamples)
+    : sensorMask(0), debounceSamples(debounceSamples), stableBits(0) {
+    if (sensorCount > SENSOR_MONITOR_MAX_SENSORS) {
+        sensorCount = SENSOR_MONITOR_MAX_SENSORS;
+    }
+    sensorMask = (uint8_t)((1u << sensorCount) - 1);
+    memset(pendingCounts, 0, sizeof(pendingCounts));
+}
+
+void SensorMonitor::begin(uint8_t rawBits) {
+    stableBits = rawBits & sensorMask;
+    memset(pendingCounts, 0, sizeof(pendingCounts));
+}
+
+uint8_t SensorMonitor::update(uint8_t rawBits) {
+    uint8_t differentBits = (rawBits ^ stableBits) & sensorMask;
+    uint8_t changedBits = 0;
+    
+    for (uint8_t i = 0; i < SENSOR_MONITOR_MAX_SENSORS; i++) {
+        uint8_t bit = (uint8_t)(1 << i);
+        
+        if (!(differentBits & bit)) {
+            // 안정 상태와 같은 샘플이 들어오면 진행 중이던 변경을 취소합니다 (채터링 무시).
+            pendingCounts[i] = 0;
+            continue;
+        }
+        
+        if (++pendingCounts[i] >= debounceSamples) {
+            stableBits ^= bit;
+            changedBits |= bit;
+            pendingCounts[i] = 0;
+        }
+    }
+    
+    return changedBits;
+}
+
+uint8_t SensorMonitor::getStableBits() const {
+    return stableBits;
+}
+
+uint8_t SensorMonitor::getSensorMask() const {
+    return sensorMask;
+}
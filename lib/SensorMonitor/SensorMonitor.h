@@ -0,0 +1,59 @@
+#ifndef SENSORMONITOR_H
+#define SENSORMONITOR_H
+
+#include <Arduino.h>
+
+// ===== 디바운스 설정 =====
+#define SENSOR_MONITOR_MAX_SENSORS 8     // 비트마스크(uint8_t)로 관리하는 최대 센서 수
+#define SENSOR_DEBOUNCE_SAMPLES 3        // 상태 변경으로 인정하는 연속 샘플 수
+
+/**
+ * @brief 센서 상태 디바운스 및 변경 감지 클래스
+ * 
+ * 센서별 "HIGH" 상태를 한 비트로 묶은 원시 샘플을 받아,
+ * 같은 값이 SENSOR_DEBOUNCE_SAMPLES 번 연속으로 들어와야 안정 상태를 바꿉니다.
+ * 안정 상태가 바뀐 비트를 반환하므로 호출 측은 변경된 센서만 전송할 수 있습니다.
+ */
+class SensorMonitor {
+public:
+    /**
+     * @brief 생성자
+     * @param sensorCount 센서 수 (최대 SENSOR_MONITOR_MAX_SENSORS)
+     * @param debounceSamples 상태 변경으로 인정하는 연속 샘플 수
+     */
+    SensorMonitor(uint8_t sensorCount, uint8_t debounceSamples = SENSOR_DEBOUNCE_SAMPLES);
+
+    // ===== 초기화 메서드 =====
+    /**
+     * @brief 초기 안정 상태 설정 (setup()에서 첫 샘플로 호출)
+     * @param rawBits 센서별 원시 상태 비트
+     */
+    void begin(uint8_t rawBits);
+
+    // ===== 샘플 처리 메서드 =====
+    /**
+     * @brief 새 샘플 반영
+     * @param rawBits 센서별 원시 상태 비트
+     * @return 이번 샘플로 안정 상태가 바뀐 센서 비트 (변경 없으면 0)
+     */
+    uint8_t update(uint8_t rawBits);
+
+    // ===== 정보 반환 메서드 =====
+    /**
+     * @brief 디바운스된 안정 상태 비트 반환
+     */
+    uint8_t getStableBits() const;
+    
+    /**
+     * @brief 사용 중인 모든 센서 비트 반환
+     */
+    uint8_t getSensorMask() const;
+
+private:
+    uint8_t sensorMask;                                  // 사용 중인 센서 비트
+    uint8_t debounceSamples;                             // 상태 변경 인정 샘플 수
+    uint8_t stableBits;                                  // 디바운스된 안정 상태
+    uint8_t pendingCounts[SENSOR_MONITOR_MAX_SENSORS];   // 안정 상태와 다른 연속 샘플 수
+};
+
+#endif // SENSORMONITOR_H
@@ -1,46 +1,322 @@
 #include "SerialCommand.h"
+#include <EEPROM.h>
+#include "Channels.h"  // ChannelConfig 정의 (프로젝트 include/)
 
-SerialCommand::SerialCommand(int baudRate) : baudRate(baudRate) {
+// 지원하는 통신 속도 (16MHz 에서 250k/500k/1M 은 오차 없이 나뉩니다)
+static const uint32_t SUPPORTED_BAUD_RATES[] = { 9600, 57600, 115200, 250000, 500000, 1000000 };
+
+SerialCommand::SerialCommand(const ChannelConfig* channels, uint32_t baudRate, int eepromAddress, uint8_t busEnablePin)
+    : channels(channels), defaultBaudRate(baudRate), baudRate(baudRate), eepromAddress(eepromAddress), baudPending(false),
+      baudSwitchMillis(0), baudConfirmTimeout(0), busEnablePin(busEnablePin), requestBroadcast(false), requestMicros(0),
+      busTurnHeld(false), statusDropped(0), lineLength(0), lineOverflow(false), lineFiltered(false),
+      protocolMode(PROTOCOL_ASCII), telemetryMode(TELEMETRY_SNAPSHOT), batchStepCount(0), bus(::Serial), tx(bus) {
+    lineBuffer[0] = '\0';
+    
+    // 접두사 조회 테이블 구성 (채널 + 채널이 아닌 명령)
+    memset(prefixTypes, COMMAND_UNKNOWN, sizeof(prefixTypes));
+    for (uint8_t i = 0; i < CHANNEL_COUNT; i++) {
+        prefixTypes[channels[i].prefix - 'A'] = channels[i].type;
+    }
+    prefixTypes[CMD_PREFIX_DC_MOTOR - 'A'] = COMMAND_DC_MOTOR;
+    prefixTypes[CMD_PREFIX_RECIPE - 'A'] = COMMAND_RECIPE;
+    prefixTypes[CMD_PREFIX_STATS - 'A'] = COMMAND_STATS;
+    prefixTypes[CMD_PREFIX_JOURNAL - 'A'] = COMMAND_JOURNAL;
+    prefixTypes[CMD_PREFIX_STATUS - 'A'] = COMMAND_STATUS;
 }
 
 void SerialCommand::begin() {
+    // 저장된 속도로 시작하되, 호스트가 그 속도를 모를 수 있으므로 확인이 없으면 기본 속도로 돌아갑니다.
+    uint32_t storedRate = loadBaudRate();
+    baudRate = (storedRate != 0) ? storedRate : defaultBaudRate;
     ::Serial.begin(baudRate);
+    baudPending = baudRate != defaultBaudRate;
+    baudSwitchMillis = millis();
+    baudConfirmTimeout = BAUD_BOOT_CONFIRM_MS;
+    
+    bus.begin(busEnablePin, baudRate);
+    bus.setAddress(loadNodeAddress());
+}
+
+void SerialCommand::update() {
+    bus.update();
+    tx.setPaused(!bus.isMyTurn());
+    tx.update();
+    
+    // 멀티드롭: 쌓인 응답을 모두 넘겼고 이어서 보낼 보고도 없으면 차례 끝 표시를 보내고 바로 창을 닫습니다.
+    // 차례 끝 표시는 대기열을 거치지 않으므로 그 뒤에 새로 쌓인 메시지가 끼어 나가지 않습니다.
+    if (bus.isMultiDrop() && bus.isWindowOpen() && tx.isEmpty() && !busTurnHeld &&
+        bus.availableForWrite() >= BUS_END_MAX_LENGTH) {
+        reportBusEnd();
+        bus.closeWindow();
+    }
+}
+
+void SerialCommand::holdBusTurn(bool hold) {
+    busTurnHeld = hold;
+}
+
+TxQueue& SerialCommand::getOutput() {
+    return tx;
 }
 
 Command SerialCommand::readCommand() {
-    Command cmd;
-    cmd.type = COMMAND_NONE;
-    cmd.value = 0.0;
-    cmd.isValid = false;
-    cmd.errorMessage = "";
+    checkBaudTimeout();
     
-    if (::Serial.available()) {
-        String commandString = ::Serial.readStringUntil('\n');
-        commandString.trim();
+    // 도착한 바이트만 라인 버퍼에 옮기고 즉시 반환합니다 (블로킹 없음).
+    while (::Serial.available()) {
+        char c = (char)::Serial.read();
+        char terminator = (protocolMode == PROTOCOL_BINARY) ? (char)FRAME_DELIMITER : '\n';
         
-        if (commandString.length() == 0) {
+        if (c == terminator) {
+            bool overflowed = lineOverflow;
+            bool filtered = lineFiltered;
+            uint8_t length = lineLength;
+            lineBuffer[lineLength] = '\0';
+            lineLength = 0;
+            lineOverflow = false;
+            lineFiltered = false;
+            
+            if (filtered) {
+                bus.countFiltered();
+                continue;
+            }
+            
+            // 멀티드롭: 주소를 확인한 뒤에만 응답합니다 (다른 노드 앞으로 온 줄에 에러로 답하면 충돌).
+            const char* line = lineBuffer;
+            if (bus.isMultiDrop() && protocolMode == PROTOCOL_ASCII) {
+                uint8_t target;
+                line = splitAddress(lineBuffer, target);
+                if (!acceptRequest(target)) {
+                    continue;
+                }
+            }
+            
+            if (overflowed) {
+                if (bus.isMultiDrop() && protocolMode == PROTOCOL_BINARY) {
+                    continue;  // 주소를 알 수 없는 프레임에는 응답하지 않습니다.
+                }
+                Command cmd = makeEmptyCommand();
+                cmd.type = COMMAND_UNKNOWN;
+                cmd.error = ERROR_LINE_TOO_LONG;
+                return cmd;
+            }
+            
+            if (protocolMode == PROTOCOL_BINARY) {
+                if (length == 0) {
+                    continue;  // 연속된 구분자는 무시
+                }
+                Command cmd = parseFrame((const uint8_t*)lineBuffer, length);
+                rejectStandaloneStir(cmd);
+                return cmd;
+            }
+            
+            // 순서 번호를 먼저 떼어 모드/속도/주소 명령도 ACK/NAK 로 응답합니다.
+            uint16_t sequence;
+            const char* text = splitSequence(line, sequence);
+            if (handleModeSwitch(text, sequence) || handleBaudSwitch(text, sequence) || handleAddressCommand(text, sequence)
+                || handleTelemetryMode(text, sequence)) {
+                return makeEmptyCommand();
+            }
+            
+            // 남은 바이트는 다음 명령이므로 버리지 않고 다음 호출에서 이어서 읽습니다.
+            Command cmd = isBatchLine(text) ? parseBatch(text) : parseCommand(text);
+            rejectStandaloneStir(cmd);
+            cmd.sequence = sequence;
             return cmd;
         }
         
-        cmd.rawCommand = commandString;
-        cmd.type = getCommandType(commandString);
+        if (lineFiltered) {
+            continue;
+        }
+        if (lineLength == 0 && bus.isMultiDrop() && protocolMode == PROTOCOL_ASCII && c != BUS_ADDRESS_PREFIX) {
+            // 주소 없는 줄(다른 노드의 응답 등)은 버퍼에 담지 않고 줄 끝까지 건너뜁니다.
+            lineFiltered = true;
+            continue;
+        }
         
-        if (cmd.type == COMMAND_UNKNOWN) {
-            cmd.errorMessage = "Unknown command: " + commandString;
+        if (lineLength < LINE_BUFFER_SIZE - 1) {
+            lineBuffer[lineLength++] = c;
+        } else {
+            lineOverflow = true;  // 줄 끝까지 버리고 에러로 보고
+        }
+    }
+    
+    return makeEmptyCommand();
+}
+
+Command SerialCommand::parseCommand(const char* commandString) {
+    Command cmd = makeEmptyCommand();
+    
+    // 앞뒤 공백 제거 (복사 없이 범위만 계산)
+    while (isspace((unsigned char)*commandString)) {
+        commandString++;
+    }
+    size_t length = strlen(commandString);
+    while (length > 0 && isspace((unsigned char)commandString[length - 1])) {
+        length--;
+    }
+    
+    if (length == 0) {
+        return cmd;
+    }
+    
+    size_t rawLength = length < COMMAND_TEXT_SIZE - 1 ? length : COMMAND_TEXT_SIZE - 1;
+    memcpy(cmd.rawCommand, commandString, rawLength);
+    cmd.rawCommand[rawLength] = '\0';
+    
+    char prefix = (char)toupper((unsigned char)*commandString);
+    if (prefix == CMD_PREFIX_QUANTITY || prefix == CMD_PREFIX_CALIBRATE) {
+        // 두 번째 문자가 대상 채널 접두사입니다 (예: "QS5", "KW120").
+        CommandType channel = (length >= 2) ? getCommandType(commandString + 1) : COMMAND_NONE;
+        bool isChannel = getChannelConfig(channel) != nullptr;
+        
+        if (prefix == CMD_PREFIX_CALIBRATE && length == 1) {
+            cmd.type = COMMAND_CALIBRATE;  // 보정값 조회
+        } else if (!isChannel) {
+            cmd.type = COMMAND_UNKNOWN;
+            cmd.error = ERROR_UNKNOWN_COMMAND;
             return cmd;
+        } else if (prefix == CMD_PREFIX_CALIBRATE) {
+            cmd.type = COMMAND_CALIBRATE;
+            cmd.target = channel;
+            cmd.value = (float)atof(commandString + 2);
+        } else {
+            cmd.type = channel;
+            cmd.isQuantity = true;
+            cmd.value = (float)atof(commandString + 2);
         }
         
-        if (cmd.type != COMMAND_NONE) {
-            cmd.value = extractValue(commandString);
-            cmd.isValid = validateCommand(cmd);
+        cmd.isValid = validateCommand(cmd);
+        return cmd;
+    }
+    
+    cmd.type = getCommandType(commandString);
+    
+    if (cmd.type == COMMAND_UNKNOWN) {
+        cmd.error = ERROR_UNKNOWN_COMMAND;
+        return cmd;
+    }
+    
+    if (cmd.type != COMMAND_NONE) {
+        cmd.value = extractValue(commandString);
+        cmd.isValid = validateCommand(cmd);
+    }
+    
+    return cmd;
+}
+
+Command SerialCommand::parseBatch(const char* line) {
+    Command batch = makeEmptyCommand();
+    batch.type = COMMAND_BATCH;
+    batchStepCount = 0;
+    
+    uint8_t group = 0;
+    const char* start = line;
+    while (true) {
+        // 구분자까지를 한 단계로 잘라 한 줄 명령과 같은 방법으로 파싱합니다.
+        const char* end = start;
+        while (*end != '\0' && *end != BATCH_SEQUENCE_SEPARATOR && *end != BATCH_PARALLEL_SEPARATOR) {
+            end++;
         }
         
-        // 시리얼 버퍼 비우기
-        while (::Serial.available()) {
-            ::Serial.read();
+        char stepText[LINE_BUFFER_SIZE];
+        size_t length = (size_t)(end - start);
+        memcpy(stepText, start, length);
+        stepText[length] = '\0';
+        Command step = parseCommand(stepText);
+        
+        // 빈 단계, 대기열/조회 명령, 단계 수 초과는 줄 전체 형식 오류로 거부합니다.
+        bool isStepType = getChannelConfig(step.type) != nullptr || step.type == COMMAND_DC_MOTOR;
+        bool isFormatError = step.type == COMMAND_NONE || batchStepCount >= BATCH_MAX_STEPS;
+        if (isFormatError) {
+            step.error = ERROR_UNKNOWN_COMMAND;
+        } else if (step.type != COMMAND_UNKNOWN && !isStepType) {
+            step.error = ERROR_UNSUPPORTED;
+        } else if (step.isValid) {
+            BatchStep& entry = batchSteps[batchStepCount++];
+            entry.type = (uint8_t)step.type;
+            entry.group = group;
+            entry.value = step.value;
+            entry.isQuantity = step.isQuantity;
         }
+        
+        if (step.error != ERROR_NONE) {
+            batch.target = isFormatError ? COMMAND_BATCH : step.type;
+            batch.error = step.error;
+            batch.value = batchStepCount + 1;
+            memcpy(batch.rawCommand, step.rawCommand, COMMAND_TEXT_SIZE);
+            batchStepCount = 0;
+            return batch;
+        }
+        
+        if (*end == '\0') {
+            break;
+        }
+        if (*end == BATCH_SEQUENCE_SEPARATOR) {
+            group++;
+        }
+        start = end + 1;
+    }
+    
+    batch.value = batchStepCount;
+    batch.isValid = true;
+    return batch;
+}
+
+uint8_t SerialCommand::getBatchStepCount() const {
+    return batchStepCount;
+}
+
+const BatchStep& SerialCommand::getBatchStep(uint8_t index) const {
+    return batchSteps[index < batchStepCount ? index : 0];
+}
+
+void SerialCommand::rejectStandaloneStir(Command& cmd) {
+    // 진동 모터는 재료 분배와 여러 단계 명령의 교반 단계로만 돌립니다.
+    if (cmd.type == COMMAND_DC_MOTOR && cmd.isValid) {
+        cmd.isValid = false;
+        cmd.error = ERROR_UNSUPPORTED;
+    }
+}
+
+const char* SerialCommand::splitSequence(const char* line, uint16_t& sequence) {
+    sequence = SEQUENCE_NONE;
+    
+    const char* cursor = line;
+    while (*cursor == ' ') {
+        cursor++;
     }
     
+    // 숫자 1~5자리 + ':' 일 때만 순서 번호로 봅니다 (명령은 항상 영문자로 시작).
+    uint32_t value = 0;
+    uint8_t digits = 0;
+    while (isdigit((unsigned char)*cursor) && digits < 5) {
+        value = value * 10 + (uint32_t)(*cursor - '0');
+        cursor++;
+        digits++;
+    }
+    
+    if (digits == 0 || *cursor != SEQUENCE_SEPARATOR || value > 0xFFFF) {
+        return line;
+    }
+    sequence = (uint16_t)value;
+    return cursor + 1;
+}
+
+bool SerialCommand::isBatchLine(const char* line) {
+    return strchr(line, BATCH_SEQUENCE_SEPARATOR) != nullptr || strchr(line, BATCH_PARALLEL_SEPARATOR) != nullptr;
+}
+
+Command SerialCommand::makeEmptyCommand() {
+    Command cmd;
+    cmd.type = COMMAND_NONE;
+    cmd.value = 0.0;
+    cmd.target = COMMAND_NONE;
+    cmd.isQuantity = false;
+    cmd.sequence = SEQUENCE_NONE;
+    cmd.isValid = false;
+    cmd.error = ERROR_NONE;
+    cmd.rawCommand[0] = '\0';
     return cmd;
 }
 
@@ -49,75 +325,1053 @@ bool SerialCommand::validateCommand(const Command& cmd) {
         return false;
     }
     
-    if (cmd.value < MIN_DURATION) {
-        cmd.errorMessage = "Duration too short (minimum: " + String(MIN_DURATION) + "s)";
-        return false;
+    if (cmd.type == COMMAND_STATS || cmd.type == COMMAND_JOURNAL || cmd.type == COMMAND_STATUS) {
+        // 조회 명령은 값을 사용하지 않습니다.
+        return true;
+    }
+    
+    if (cmd.type == COMMAND_CALIBRATE && cmd.target == COMMAND_NONE) {
+        return true;  // 보정값 조회
+    }
+    
+    if (cmd.type == COMMAND_CALIBRATE || cmd.isQuantity) {
+        // 작동 시간 범위는 보정값으로 변환한 뒤 확인합니다.
+        if (!(cmd.value > 0)) {
+            cmd.error = ERROR_INVALID_QUANTITY;
+            return false;
+        }
+        return true;
+    }
+    
+    if (cmd.type == COMMAND_RECIPE) {
+        // 레시피 번호는 1 이상의 정수 (존재 여부는 레시피 테이블에서 확인)
+        if (cmd.value < 1 || cmd.value > MAX_RECIPE_ID || cmd.value != (float)(int)cmd.value) {
+            cmd.error = ERROR_INVALID_RECIPE;
+            return false;
+        }
+        return true;
     }
     
-    if (cmd.type == COMMAND_SUGAR && cmd.value > MAX_SUGAR_DURATION) {
-        cmd.errorMessage = "Sugar duration too long (maximum: " + String(MAX_SUGAR_DURATION) + "s)";
+    if (cmd.value < MIN_DURATION) {
+        cmd.error = ERROR_DURATION_TOO_SHORT;
         return false;
     }
     
-    if (cmd.type == COMMAND_WATER && cmd.value > MAX_WATER_DURATION) {
-        cmd.errorMessage = "Water duration too long (maximum: " + String(MAX_WATER_DURATION) + "s)";
+    float maxDuration = getMaxDuration(cmd.type);
+    if (maxDuration > 0 && cmd.value > maxDuration) {
+        cmd.error = ERROR_DURATION_TOO_LONG;
         return false;
     }
     
     return true;
 }
 
-CommandType SerialCommand::getCommandType(const String& commandString) {
-    if (commandString.length() == 0) {
-        return COMMAND_NONE;
-    }
-    
+CommandType SerialCommand::getCommandType(const char* commandString) const {
     // 첫 번째 문자 찾기 (공백 무시)
-    size_t startPos = 0;
-    while (startPos < commandString.length() && commandString[startPos] == ' ') {
-        startPos++;
+    while (*commandString == ' ') {
+        commandString++;
     }
     
-    if (startPos >= commandString.length()) {
+    if (*commandString == '\0') {
         return COMMAND_NONE;
     }
     
-    char firstChar = commandString[startPos];
+    char firstChar = (char)toupper((unsigned char)*commandString);
     
-    if (firstChar == 'S' || firstChar == 's') {
-        return COMMAND_SUGAR;
-    } else if (firstChar == 'W' || firstChar == 'w') {
-        return COMMAND_WATER;
+    if (firstChar < 'A' || firstChar > 'Z') {
+        return COMMAND_UNKNOWN;
     }
     
-    return COMMAND_UNKNOWN;
+    return (CommandType)prefixTypes[firstChar - 'A'];
+}
+
+const ChannelConfig* SerialCommand::getChannelConfig(CommandType type) const {
+    if (type < CHANNEL_FIRST_COMMAND || type >= CHANNEL_FIRST_COMMAND + CHANNEL_COUNT) {
+        return nullptr;
+    }
+    return &channels[type - CHANNEL_FIRST_COMMAND];
 }
 
-float SerialCommand::extractValue(const String& commandString) {
+float SerialCommand::extractValue(const char* commandString) {
     // 첫 번째 문자 찾기 (공백 무시)
-    size_t startPos = 0;
-    while (startPos < commandString.length() && commandString[startPos] == ' ') {
-        startPos++;
+    while (*commandString == ' ') {
+        commandString++;
     }
     
-    if (startPos >= commandString.length()) {
+    if (*commandString == '\0') {
         return 0.0;
     }
     
-    // 명령 문자 건너뛰기
-    startPos++;
+    // 명령 문자 건너뛰기 (값 앞의 공백은 atof 가 무시)
+    return (float)atof(commandString + 1);
+}
+
+void SerialCommand::printError(const __FlashStringHelper* error) {
+    Print& out = tx.begin(TX_LANE_EVENT);
+    out.print(F("ERROR: "));
+    out.println(error);
+    tx.end();
+}
+
+void SerialCommand::printSuccess(const __FlashStringHelper* message) {
+    Print& out = tx.begin(TX_LANE_EVENT);
+    out.print(F("SUCCESS: "));
+    out.println(message);
+    tx.end();
+}
+
+void SerialCommand::reportAccepted(CommandType type, float value) {
+    if (protocolMode == PROTOCOL_BINARY) {
+        uint16_t valueCs = (type == COMMAND_RECIPE) ? (uint16_t)value : toCentiseconds(value);
+        uint8_t payload[] = { FRAME_OP_ACCEPTED, (uint8_t)type, (uint8_t)(valueCs & 0xFF), (uint8_t)(valueCs >> 8) };
+        writeFrame(payload, sizeof(payload));
+        return;
+    }
+    
+    Print& out = tx.begin(TX_LANE_EVENT);
+    out.print(F("SUCCESS: "));
+    out.print(getCommandName(type));
+    out.print(F(" command received: "));
+    if (type == COMMAND_BATCH) {
+        out.print((int)value);
+        out.println(F(" steps"));
+    } else if (type == COMMAND_RECIPE) {
+        out.println((int)value);
+    } else {
+        out.print(value);
+        out.println('s');
+    }
+    tx.end();
+}
+
+void SerialCommand::reportCompleted(CommandType type, uint8_t arg) {
+    if (protocolMode == PROTOCOL_BINARY) {
+        uint8_t payload[] = { FRAME_OP_COMPLETED, (uint8_t)type, arg };
+        writeFrame(payload, sizeof(payload));
+        return;
+    }
+    
+    Print& out = tx.begin(TX_LANE_EVENT);
+    out.print(F("SUCCESS: "));
+    out.print(getCommandName(type));
+    switch (type) {
+        case COMMAND_WATER:
+            out.println(F(" pumping completed"));
+            break;
+        case COMMAND_DC_MOTOR:
+            out.println(F(" operation completed"));
+            break;
+        case COMMAND_RECIPE:
+            out.print(' ');
+            out.print(arg);
+            out.println(F(" completed"));
+            break;
+        case COMMAND_BATCH:
+            out.print(F(" of "));
+            out.print(arg);
+            out.println(F(" steps completed"));
+            break;
+        case COMMAND_JOURNAL:
+            out.println(F(" dump completed"));
+            break;
+        default:
+            out.println(F(" dispensing completed"));
+            break;
+    }
+    tx.end();
+}
+
+void SerialCommand::reportError(CommandError error, CommandType type, float value, const char* detail) {
+    if (protocolMode == PROTOCOL_BINARY) {
+        uint8_t payload[] = { FRAME_OP_ERROR, (uint8_t)error, (uint8_t)type };
+        writeFrame(payload, sizeof(payload));
+        return;
+    }
+    
+    // 에러 문구는 플래시 문자열 조각을 바로 출력하여 조립합니다 (동적 메모리 사용 없음).
+    Print& out = tx.begin(TX_LANE_EVENT);
+    out.print(F("ERROR: "));
+    switch (error) {
+        case ERROR_UNKNOWN_COMMAND:
+            if (detail != nullptr) {
+                out.print(F("Unknown command: "));
+                out.println(detail);
+            } else {
+                out.println(F("Unknown command frame"));
+            }
+            break;
+        case ERROR_LINE_TOO_LONG:
+            out.print(F("Command too long (maximum: "));
+            out.print(LINE_BUFFER_SIZE - 1);
+            out.println(F(" chars)"));
+            break;
+        case ERROR_BAD_FRAME:
+            out.println(F("Corrupted frame"));
+            break;
+        case ERROR_DURATION_TOO_SHORT:
+            out.print(F("Duration too short (minimum: "));
+            out.print(MIN_DURATION);
+            out.println(F("s)"));
+            break;
+        case ERROR_DURATION_TOO_LONG:
+            out.print(getCommandName(type));
+            out.print(F(" duration too long (maximum: "));
+            out.print(getMaxDuration(type));
+            out.println(F("s)"));
+            break;
+        case ERROR_INVALID_RECIPE:
+            out.print(F("Invalid recipe id (1-"));
+            out.print(MAX_RECIPE_ID);
+            out.println(')');
+            break;
+        case ERROR_UNKNOWN_RECIPE:
+            out.print(F("Unknown recipe: "));
+            out.println((int)value);
+            break;
+        case ERROR_RECIPE_ABORTED:
+            out.print(F("Recipe "));
+            out.print((int)value);
+            out.println(F(" aborted"));
+            break;
+        case ERROR_QUEUE_FULL:
+            out.print(F("Command queue is full: "));
+            out.println(detail != nullptr ? detail : getCommandName(type));
+            break;
+        case ERROR_OUT_OF_STOCK:
+            out.print(getCommandName(type));
+            out.println(F(" stock is too low to dispense!"));
+            break;
+        case ERROR_INVALID_QUANTITY:
+            out.println(F("Quantity must be greater than 0"));
+            break;
+        case ERROR_NOT_CALIBRATED:
+            out.print(getCommandName(type));
+            out.println(F(" is not calibrated"));
+            break;
+        case ERROR_NO_REFERENCE_RUN:
+            out.print(F("Run a timed "));
+            out.print(getCommandName(type));
+            out.println(F(" dispense before calibrating"));
+            break;
+        case ERROR_BATCH_REJECTED:
+            out.print(F("Batch rejected at step "));
+            out.print((int)value);
+            out.println(F(" (nothing dispensed)"));
+            break;
+        case ERROR_BATCH_ABORTED:
+            out.print(F("Batch aborted at step "));
+            out.println((int)value);
+            break;
+        case ERROR_UNSUPPORTED_BAUD:
+            out.print(F("Unsupported baud rate: "));
+            out.println((uint32_t)value);
+            break;
+        case ERROR_BAUD_NOT_CONFIRMED:
+            out.print(F("Baud rate "));
+            out.print((uint32_t)value);
+            out.print(F(" not confirmed, back to "));
+            out.println(defaultBaudRate);
+            break;
+        case ERROR_INVALID_ADDRESS:
+            out.print(F("Invalid node address: "));
+            out.print((int)value);
+            out.print(F(" (0-"));
+            out.print(BUS_ADDRESS_MAX);
+            out.println(F(", not by broadcast)"));
+            break;
+        case ERROR_UNSUPPORTED:
+            if (type == COMMAND_DC_MOTOR) {
+                out.println(F("DC Motor command is now integrated into ingredient dispensing."));
+            } else {
+                out.print(getCommandName(type));
+                out.println(F(" command is not supported"));
+            }
+            break;
+        default:
+            out.println(F("Unknown error"));
+            break;
+    }
+    tx.end();
+}
+
+void SerialCommand::reportCommandError(const Command& cmd) {
+    if (cmd.type == COMMAND_BATCH) {
+        // 문제 단계의 에러를 먼저 알리고, 줄 전체가 거부되었음을 알립니다.
+        if (cmd.target != COMMAND_BATCH) {
+            reportError(cmd.error, cmd.target, 0.0f, cmd.rawCommand);
+        }
+        reportError(ERROR_BATCH_REJECTED, COMMAND_BATCH, cmd.value, cmd.rawCommand);
+        return;
+    }
     
-    // 값 부분 추출
-    String valueStr = commandString.substring(startPos);
-    valueStr.trim(); // 값 부분의 공백 제거
+    CommandType type = (cmd.type == COMMAND_CALIBRATE && cmd.target != COMMAND_NONE) ? cmd.target : cmd.type;
+    reportError(cmd.error, type, cmd.value, cmd.rawCommand[0] != '\0' ? cmd.rawCommand : nullptr);
+}
+
+void SerialCommand::reportCalibration(CommandType type, float rate) {
+    if (protocolMode == PROTOCOL_BINARY) {
+        uint16_t rateCs = toCentiseconds(rate);  // 초당 분배량 × 100
+        uint8_t payload[] = { FRAME_OP_CALIBRATION, (uint8_t)type, (uint8_t)(rateCs & 0xFF), (uint8_t)(rateCs >> 8) };
+        writeFrame(payload, sizeof(payload));
+        return;
+    }
+    
+    const ChannelConfig* config = getChannelConfig(type);
+    Print& out = tx.begin(TX_LANE_EVENT);
+    out.print(F("SUCCESS: "));
+    out.print(getCommandName(type));
+    out.print(F(" calibration: "));
+    if (rate > 0 && config != nullptr) {
+        out.print(rate);
+        out.print(' ');
+        out.print(config->unit);
+        out.println(F("/s"));
+    } else {
+        out.println(F("none"));
+    }
+    tx.end();
+}
+
+void SerialCommand::reportJournalEntry(uint32_t sequence, uint8_t bootCount, CommandType type,
+                                       uint32_t uptimeSeconds, uint16_t requestedCs, uint16_t actualCs) {
+    if (protocolMode == PROTOCOL_BINARY) {
+        uint8_t payload[] = {
+            FRAME_OP_JOURNAL,
+            (uint8_t)sequence, (uint8_t)(sequence >> 8), (uint8_t)(sequence >> 16), (uint8_t)(sequence >> 24),
+            bootCount, (uint8_t)type,
+            (uint8_t)uptimeSeconds, (uint8_t)(uptimeSeconds >> 8), (uint8_t)(uptimeSeconds >> 16), (uint8_t)(uptimeSeconds >> 24),
+            (uint8_t)(requestedCs & 0xFF), (uint8_t)(requestedCs >> 8),
+            (uint8_t)(actualCs & 0xFF), (uint8_t)(actualCs >> 8)
+        };
+        writeFrame(payload, sizeof(payload));
+        return;
+    }
+    
+    // 덤프 양이 많으므로 한 줄을 짧은 CSV 로 보냅니다: J,일련번호,부팅,채널,경과초,요청cs,실제cs
+    Print& out = tx.begin(TX_LANE_EVENT);
+    out.print(F("J,"));
+    out.print(sequence);
+    out.print(',');
+    out.print(bootCount);
+    out.print(',');
+    out.print(getCommandName(type));
+    out.print(',');
+    out.print(uptimeSeconds);
+    out.print(',');
+    out.print(requestedCs);
+    out.print(',');
+    out.println(actualCs);
+    tx.end();
+}
+
+void SerialCommand::reportLifetimeCounter(CommandType type, uint32_t cycles, uint32_t onTimeCs) {
+    if (protocolMode == PROTOCOL_BINARY) {
+        uint8_t payload[] = {
+            FRAME_OP_COUNTER, (uint8_t)type,
+            (uint8_t)cycles, (uint8_t)(cycles >> 8), (uint8_t)(cycles >> 16), (uint8_t)(cycles >> 24),
+            (uint8_t)onTimeCs, (uint8_t)(onTimeCs >> 8), (uint8_t)(onTimeCs >> 16), (uint8_t)(onTimeCs >> 24)
+        };
+        writeFrame(payload, sizeof(payload));
+        return;
+    }
+    
+    // L,채널,작동 횟수,누적 작동 시간(cs)
+    Print& out = tx.begin(TX_LANE_EVENT);
+    out.print(F("L,"));
+    out.print(getCommandName(type));
+    out.print(',');
+    out.print(cycles);
+    out.print(',');
+    out.println(onTimeCs);
+    tx.end();
+}
+
+void SerialCommand::reportAck(uint16_t sequence, CommandType type) {
+    writeSequenceEvent(FRAME_OP_ACK, sequence, ERROR_NONE, type);
+}
+
+void SerialCommand::reportNak(uint16_t sequence, CommandError error, CommandType type) {
+    writeSequenceEvent(FRAME_OP_NAK, sequence, error, type);
+}
+
+void SerialCommand::reportFailed(uint16_t sequence, CommandError error, CommandType type) {
+    writeSequenceEvent(FRAME_OP_FAIL, sequence, error, type);
+}
+
+void SerialCommand::reportDone(uint16_t sequence, CommandType type, uint16_t requestedCs, uint16_t actualCs) {
+    if (sequence == SEQUENCE_NONE) {
+        return;
+    }
     
-    return valueStr.toFloat();
+    if (protocolMode == PROTOCOL_BINARY) {
+        uint8_t payload[] = {
+            FRAME_OP_DONE, (uint8_t)(sequence & 0xFF), (uint8_t)(sequence >> 8), (uint8_t)type,
+            (uint8_t)(requestedCs & 0xFF), (uint8_t)(requestedCs >> 8),
+            (uint8_t)(actualCs & 0xFF), (uint8_t)(actualCs >> 8)
+        };
+        writeFrame(payload, sizeof(payload), TX_LANE_EVENT, true);
+        return;
+    }
+    
+    // DONE,순서번호,이름,요청cs,실제cs
+    Print& out = tx.begin(TX_LANE_EVENT, true);
+    out.print(F("DONE,"));
+    out.print(sequence);
+    out.print(',');
+    out.print(getCommandName(type));
+    out.print(',');
+    out.print(requestedCs);
+    out.print(',');
+    out.println(actualCs);
+    tx.end();
+}
+
+void SerialCommand::writeSequenceEvent(uint8_t opcode, uint16_t sequence, CommandError error, CommandType type) {
+    if (sequence == SEQUENCE_NONE) {
+        return;
+    }
+    
+    if (protocolMode == PROTOCOL_BINARY) {
+        // ACK 는 에러 코드 없이 [sequence u16][type] 까지만 보냅니다.
+        uint8_t payload[] = { opcode, (uint8_t)(sequence & 0xFF), (uint8_t)(sequence >> 8), (uint8_t)type, (uint8_t)error };
+        writeFrame(payload, opcode == FRAME_OP_ACK ? sizeof(payload) - 1 : sizeof(payload), TX_LANE_EVENT, true);
+        return;
+    }
+    
+    // ACK,순서번호 / NAK,순서번호,에러코드 / FAIL,순서번호,에러코드
+    Print& out = tx.begin(TX_LANE_EVENT, true);
+    switch (opcode) {
+        case FRAME_OP_ACK:  out.print(F("ACK,"));  break;
+        case FRAME_OP_NAK:  out.print(F("NAK,"));  break;
+        default:            out.print(F("FAIL,")); break;
+    }
+    out.print(sequence);
+    if (opcode == FRAME_OP_ACK) {
+        out.println();
+    } else {
+        out.print(',');
+        out.println((int)error);
+    }
+    tx.end();
+}
+
+void SerialCommand::reportStatus(const NodeStatus& status) {
+    // 버스로 보낼 상태는 SerialCommand 가 아는 송신 상태를 더해 만듭니다.
+    const TxLaneStats& events = tx.getStats(TX_LANE_EVENT);
+    uint16_t dropped = events.dropped + events.lost;
+    uint8_t flags = status.flags;
+    if (!tx.isEmpty()) {
+        flags |= NODE_STATUS_OUTPUT;
+    }
+    if (dropped != statusDropped) {
+        flags |= NODE_STATUS_DROPPED;
+        statusDropped = dropped;
+    }
+    if (baudPending) {
+        flags |= NODE_STATUS_BAUD_PENDING;
+    }
+    
+    uint8_t message[BUS_SLOT_BYTES];
+    uint8_t length;
+    if (protocolMode == PROTOCOL_BINARY) {
+        uint8_t payload[] = { FRAME_OP_STATUS, flags, status.busyChannels, status.sensorBits, status.queued };
+        length = encodeFrame(payload, sizeof(payload), message);
+    } else {
+        // "#주소,P,플래그,분배 중 채널,센서,대기 명령 수" (값은 16진수 2자리, 최대 20바이트)
+        static const char HEX_DIGITS[] = "0123456789ABCDEF";
+        const uint8_t fields[] = { flags, status.busyChannels, status.sensorBits, status.queued };
+        uint8_t address = bus.getAddress();
+        length = 0;
+        message[length++] = BUS_RESPONSE_PREFIX;
+        if (address >= 100) {
+            message[length++] = '0' + address / 100;
+        }
+        if (address >= 10) {
+            message[length++] = '0' + (address / 10) % 10;
+        }
+        message[length++] = '0' + address % 10;
+        message[length++] = ',';
+        message[length++] = CMD_PREFIX_STATUS;
+        for (uint8_t i = 0; i < sizeof(fields); i++) {
+            message[length++] = ',';
+            message[length++] = HEX_DIGITS[fields[i] >> 4];
+            message[length++] = HEX_DIGITS[fields[i] & 0x0F];
+        }
+        message[length++] = '\r';
+        message[length++] = '\n';
+    }
+    
+    // 방송 폴링은 자기 슬롯에만 보내고, 그 밖에는 일반 응답처럼 대기열로 보냅니다.
+    if (bus.isMultiDrop() && requestBroadcast) {
+        bus.scheduleSlot(requestMicros, message, length);
+        return;
+    }
+    tx.begin(TX_LANE_EVENT).write(message, length);
+    tx.end();
+}
+
+void SerialCommand::reportBusEnd() {
+    if (protocolMode == PROTOCOL_BINARY) {
+        uint8_t payload[] = { FRAME_OP_BUS_END };
+        uint8_t encoded[FRAME_MAX_ENCODED];
+        bus.write(encoded, encodeFrame(payload, sizeof(payload), encoded));
+        return;
+    }
+    
+    bus.print(BUS_RESPONSE_PREFIX);
+    bus.print(bus.getAddress());
+    bus.println(F(",END"));
+}
+
+void SerialCommand::reportNodeAddress(uint8_t address) {
+    Print& out = tx.begin(TX_LANE_EVENT);
+    out.print(F("SUCCESS: Node address "));
+    if (address != BUS_ADDRESS_NONE) {
+        out.println(address);
+    } else {
+        out.println(F("none (point-to-point)"));
+    }
+    tx.end();
+}
+
+float SerialCommand::getMaxDuration(CommandType type) const {
+    const ChannelConfig* config = getChannelConfig(type);
+    return config != nullptr ? config->maxDuration : 0.0f;
+}
+
+void SerialCommand::sendTelemetryFrame(uint8_t stateBits, uint8_t changedBits) {
+    // 스냅샷 모드는 기존 호스트가 읽던 [상태] 프레임을 그대로 보냅니다.
+    uint8_t payload[] = { FRAME_OP_TELEMETRY, stateBits, changedBits };
+    uint8_t length = (telemetryMode == TELEMETRY_EVENT) ? sizeof(payload) : sizeof(payload) - 1;
+    writeFrame(payload, length, TX_LANE_TELEMETRY);
+}
+
+void SerialCommand::reportTelemetryMode() {
+    Print& out = tx.begin(TX_LANE_EVENT);
+    out.print(F("SUCCESS: Telemetry mode "));
+    out.println(telemetryMode == TELEMETRY_EVENT ? F("event") : F("snapshot"));
+    tx.end();
+}
+
+const char* SerialCommand::getCommandName(CommandType type) const {
+    const ChannelConfig* config = getChannelConfig(type);
+    if (config != nullptr) {
+        return config->name;
+    }
+    
+    switch (type) {
+        case COMMAND_DC_MOTOR: return "DC Motor";
+        case COMMAND_RECIPE:   return "Recipe";
+        case COMMAND_STATS:    return "Stats";
+        case COMMAND_CALIBRATE: return "Calibration";
+        case COMMAND_JOURNAL:  return "Journal";
+        case COMMAND_BATCH:    return "Batch";
+        case COMMAND_STATUS:   return "Status";
+        default:               return "Unknown";
+    }
+}
+
+ProtocolMode SerialCommand::getProtocolMode() const {
+    return protocolMode;
+}
+
+bool SerialCommand::isBinaryMode() const {
+    return protocolMode == PROTOCOL_BINARY;
 }
 
-void SerialCommand::printError(const String& error) {
-    ::Serial.println("ERROR: " + error);
+TelemetryMode SerialCommand::getTelemetryMode() const {
+    return telemetryMode;
 }
 
-void SerialCommand::printSuccess(const String& message) {
-    ::Serial.println("SUCCESS: " + message);
-} 
\ No newline at end of file
+uint8_t SerialCommand::getNodeAddress() const {
+    return bus.getAddress();
+}
+
+bool SerialCommand::isMultiDrop() const {
+    return bus.isMultiDrop();
+}
+
+const BusStats& SerialCommand::getBusStats() const {
+    return bus.getStats();
+}
+
+void SerialCommand::resetBusStats() {
+    bus.resetStats();
+}
+
+bool SerialCommand::handleModeSwitch(const char* line, uint16_t sequence) {
+    while (*line == ' ') {
+        line++;
+    }
+    
+    if (*line != CMD_PREFIX_BINARY_MODE && *line != 'b') {
+        return false;
+    }
+    
+    if (extractValue(line) != BINARY_PROTOCOL_VERSION) {
+        printError(F("Unsupported protocol version"));
+        reportNak(sequence, ERROR_UNSUPPORTED, COMMAND_NONE);
+        return true;
+    }
+    
+    // 확인 응답은 텍스트로 보내고, 이후부터 바이너리 프레임을 사용합니다.
+    reportAck(sequence, COMMAND_NONE);
+    printSuccess(F("Binary protocol enabled"));
+    protocolMode = PROTOCOL_BINARY;
+    return true;
+}
+
+bool SerialCommand::handleBaudSwitch(const char* line, uint16_t sequence) {
+    while (*line == ' ') {
+        line++;
+    }
+    
+    if (toupper((unsigned char)*line) != CMD_PREFIX_BAUD) {
+        return false;
+    }
+    
+    const char* valueText = line + 1;
+    while (*valueText == ' ') {
+        valueText++;
+    }
+    
+    // 버스의 한 노드만 속도를 바꾸거나 확정하면 나머지 노드와 속도가 갈라지므로 방송으로만 받습니다.
+    if (bus.isMultiDrop() && !requestBroadcast) {
+        printError(F("Baud rate must be changed by broadcast on the bus"));
+        reportNak(sequence, ERROR_UNSUPPORTED, COMMAND_NONE);
+        return true;
+    }
+    
+    if (*valueText == '\0') {
+        // "Y": 지금 속도에서 온 확인이므로 확정하고 저장합니다.
+        // 부팅 때 확인이 없어 기본 속도로 돌아온 경우에도 이 확인이 있어야 저장값이 기본 속도로 바뀝니다.
+        baudPending = false;
+        saveBaudRate(baudRate);
+        reportAck(sequence, COMMAND_NONE);
+        reportBaudRate(baudRate, true);
+        return true;
+    }
+    
+    uint32_t requested = strtoul(valueText, nullptr, 10);
+    if (!isSupportedBaudRate(requested)) {
+        reportError(ERROR_UNSUPPORTED_BAUD, COMMAND_NONE, (float)requested);
+        reportNak(sequence, ERROR_UNSUPPORTED_BAUD, COMMAND_NONE);
+        return true;
+    }
+    
+    // 응답은 현재 속도로 보낸 뒤 속도를 바꿉니다.
+    // 버스 방송에는 응답 차례가 없어 응답이 대기열에 남은 채 새 속도로 나가게 되므로 보내지 않습니다.
+    // (호스트는 새 속도에서 방송 "Y" 로 확정하고, 그 응답은 다음 차례에 나갑니다.)
+    if (!bus.isMultiDrop()) {
+        reportAck(sequence, COMMAND_NONE);
+        reportBaudRate(requested, false);
+    }
+    applyBaudRate(requested);
+    baudPending = true;
+    baudSwitchMillis = millis();
+    baudConfirmTimeout = BAUD_CONFIRM_TIMEOUT_MS;
+    return true;
+}
+
+bool SerialCommand::handleAddressCommand(const char* line, uint16_t sequence) {
+    while (*line == ' ') {
+        line++;
+    }
+    
+    if (toupper((unsigned char)*line) != CMD_PREFIX_ADDRESS) {
+        return false;
+    }
+    
+    const char* valueText = line + 1;
+    while (*valueText == ' ') {
+        valueText++;
+    }
+    
+    if (*valueText == '\0') {
+        reportAck(sequence, COMMAND_NONE);
+        reportNodeAddress(bus.getAddress());
+        return true;
+    }
+    
+    // 방송으로 주소를 바꾸면 모든 노드가 같은 주소가 되므로 거부합니다.
+    long requested = isdigit((unsigned char)*valueText) ? atol(valueText) : -1;
+    if (requested < 0 || requested > BUS_ADDRESS_MAX || (bus.isMultiDrop() && requestBroadcast)) {
+        reportError(ERROR_INVALID_ADDRESS, COMMAND_NONE, (float)requested);
+        reportNak(sequence, ERROR_INVALID_ADDRESS, COMMAND_NONE);
+        return true;
+    }
+    
+    // 1:1 연결에서 멀티드롭으로 바꿀 때는 응답을 먼저 보낸 뒤 주소를 적용합니다 (이후에는 요청을 받아야 송신).
+    reportAck(sequence, COMMAND_NONE);
+    reportNodeAddress((uint8_t)requested);
+    if (!bus.isMultiDrop()) {
+        tx.flush();
+    }
+    bus.setAddress((uint8_t)requested);
+    tx.setPaused(!bus.isMyTurn());
+    uint32_t storedRate = loadBaudRate();
+    saveLinkSettings(storedRate != 0 ? storedRate : defaultBaudRate, (uint8_t)requested);
+    return true;
+}
+
+bool SerialCommand::handleTelemetryMode(const char* line, uint16_t sequence) {
+    while (*line == ' ') {
+        line++;
+    }
+    
+    if (toupper((unsigned char)*line) != CMD_PREFIX_TELEMETRY) {
+        return false;
+    }
+    
+    const char* valueText = line + 1;
+    while (*valueText == ' ') {
+        valueText++;
+    }
+    
+    if (*valueText == '\0') {
+        reportAck(sequence, COMMAND_NONE);
+        reportTelemetryMode();
+        return true;
+    }
+    
+    if ((*valueText != '0' && *valueText != '1') || valueText[1] != '\0') {
+        printError(F("Unsupported telemetry mode"));
+        reportNak(sequence, ERROR_UNSUPPORTED, COMMAND_NONE);
+        return true;
+    }
+    
+    telemetryMode = (*valueText == '1') ? TELEMETRY_EVENT : TELEMETRY_SNAPSHOT;
+    reportAck(sequence, COMMAND_NONE);
+    reportTelemetryMode();
+    return true;
+}
+
+const char* SerialCommand::splitAddress(const char* line, uint8_t& target) {
+    target = BUS_ADDRESS_NONE;
+    if (*line != BUS_ADDRESS_PREFIX) {
+        return line;
+    }
+    
+    // "@*" 또는 "@" + 숫자 1~3자리, 뒤의 공백 하나는 선택 (순서 번호가 이어지면 공백 필요)
+    const char* cursor = line + 1;
+    if (*cursor == BUS_BROADCAST_CHAR) {
+        target = BUS_ADDRESS_BROADCAST;
+        cursor++;
+    } else {
+        uint16_t value = 0;
+        uint8_t digits = 0;
+        while (isdigit((unsigned char)*cursor) && digits < 3) {
+            value = value * 10 + (uint16_t)(*cursor - '0');
+            cursor++;
+            digits++;
+        }
+        if (digits == 0 || value == BUS_ADDRESS_NONE || value > BUS_ADDRESS_MAX) {
+            return line;
+        }
+        target = (uint8_t)value;
+    }
+    
+    if (*cursor == ' ') {
+        cursor++;
+    }
+    return cursor;
+}
+
+bool SerialCommand::acceptRequest(uint8_t target) {
+    if (!bus.accepts(target)) {
+        bus.countFiltered();
+        return false;
+    }
+    
+    requestBroadcast = target == BUS_ADDRESS_BROADCAST;
+    requestMicros = micros();
+    if (!requestBroadcast) {
+        bus.scheduleWindow(requestMicros);
+        tx.setPaused(false);  // 이번 요청을 처리하며 만드는 응답은 창이 열릴 때까지 대기열에 쌓입니다.
+    }
+    return true;
+}
+
+void SerialCommand::applyBaudRate(uint32_t baudRate) {
+    tx.flush();  // 대기열과 하드웨어 버퍼가 모두 나갈 때까지 기다립니다 (속도 변경 때 한 번, 버스에서 차례를 기다리는 중이면 하드웨어 버퍼만)
+    this->baudRate = baudRate;
+    ::Serial.begin(baudRate);
+    bus.setBaudRate(baudRate);
+    lineLength = 0;  // 이전 속도에서 받다 만 줄은 버립니다.
+    lineOverflow = false;
+    lineFiltered = false;
+}
+
+void SerialCommand::checkBaudTimeout() {
+    if (!baudPending || millis() - baudSwitchMillis < baudConfirmTimeout) {
+        return;
+    }
+    
+    // 이번 실행에서만 기본 속도로 돌아갑니다. 저장값은 확인("Y")이 올 때까지 그대로 둡니다.
+    uint32_t failedRate = baudRate;
+    baudPending = false;
+    applyBaudRate(defaultBaudRate);
+    reportError(ERROR_BAUD_NOT_CONFIRMED, COMMAND_NONE, (float)failedRate);
+}
+
+uint32_t SerialCommand::loadBaudRate() const {
+    if (eepromAddress < 0 || EEPROM.read(eepromAddress) != LINK_SETTINGS_MAGIC
+        || EEPROM.read(eepromAddress + 1) != LINK_SETTINGS_VERSION) {
+        return 0;
+    }
+    uint32_t stored;
+    EEPROM.get(eepromAddress + 2, stored);
+    return isSupportedBaudRate(stored) ? stored : 0;
+}
+
+uint8_t SerialCommand::loadNodeAddress() const {
+    if (eepromAddress < 0 || EEPROM.read(eepromAddress) != LINK_SETTINGS_MAGIC
+        || EEPROM.read(eepromAddress + 1) != LINK_SETTINGS_VERSION) {
+        return BUS_ADDRESS_NONE;
+    }
+    uint8_t stored = EEPROM.read(eepromAddress + 6);
+    return stored <= BUS_ADDRESS_MAX ? stored : BUS_ADDRESS_NONE;
+}
+
+void SerialCommand::saveBaudRate(uint32_t baudRate) {
+    saveLinkSettings(baudRate, bus.getAddress());
+}
+
+void SerialCommand::saveLinkSettings(uint32_t baudRate, uint8_t address) {
+    if (eepromAddress < 0) {
+        return;
+    }
+    EEPROM.update(eepromAddress, LINK_SETTINGS_MAGIC);
+    EEPROM.update(eepromAddress + 1, LINK_SETTINGS_VERSION);
+    EEPROM.put(eepromAddress + 2, baudRate);  // 바뀐 바이트만 기록
+    EEPROM.update(eepromAddress + 6, address);
+}
+
+void SerialCommand::reportBaudRate(uint32_t baudRate, bool confirmed) {
+    Print& out = tx.begin(TX_LANE_EVENT);
+    out.print(F("SUCCESS: Baud rate "));
+    out.print(baudRate);
+    if (confirmed) {
+        out.println(F(" confirmed"));
+    } else {
+        out.println(F(" requested, confirm with Y at the new rate"));
+    }
+    tx.end();
+}
+
+uint32_t SerialCommand::getBaudRate() const {
+    return baudRate;
+}
+
+bool SerialCommand::isBaudPending() const {
+    return baudPending;
+}
+
+bool SerialCommand::isSupportedBaudRate(uint32_t baudRate) {
+    for (uint8_t i = 0; i < sizeof(SUPPORTED_BAUD_RATES) / sizeof(SUPPORTED_BAUD_RATES[0]); i++) {
+        if (SUPPORTED_BAUD_RATES[i] == baudRate) {
+            return true;
+        }
+    }
+    return false;
+}
+
+Command SerialCommand::parseFrame(const uint8_t* frame, uint8_t length) {
+    Command cmd = makeEmptyCommand();
+    uint8_t decoded[LINE_BUFFER_SIZE];
+    uint8_t decodedLength = cobsDecode(frame, length, decoded);
+    
+    // 최소 길이: opcode + CRC
+    if (decodedLength < 2 || crc8(decoded, decodedLength - 1) != decoded[decodedLength - 1]) {
+        if (bus.isMultiDrop()) {
+            return cmd;  // 누구 앞인지 알 수 없는 손상된 프레임에는 응답하지 않습니다.
+        }
+        cmd.type = COMMAND_UNKNOWN;
+        cmd.error = ERROR_BAD_FRAME;
+        return cmd;
+    }
+    
+    const uint8_t* payload = decoded;
+    uint8_t payloadLength = decodedLength - 1;
+    
+    if (bus.isMultiDrop()) {
+        // [주소][opcode]...: 다른 노드의 응답 프레임(opcode 최상위 비트)과 다른 주소 앞 프레임은 버립니다.
+        if (payloadLength < 2 || (decoded[1] & 0x80) != 0) {
+            bus.countFiltered();
+            return cmd;
+        }
+        if (!acceptRequest(decoded[0])) {
+            return cmd;
+        }
+        payload++;
+        payloadLength--;
+    }
+    
+    switch (payload[0]) {
+        case FRAME_OP_COMMAND: {
+            // 여러 단계 명령은 텍스트 줄로만 받습니다.
+            if ((payloadLength != 4 && payloadLength != 6)
+                || payload[1] == COMMAND_NONE || payload[1] == COMMAND_BATCH || payload[1] >= COMMAND_UNKNOWN) {
+                cmd.type = COMMAND_UNKNOWN;
+                cmd.error = ERROR_UNKNOWN_COMMAND;
+                return cmd;
+            }
+            
+            uint16_t value = (uint16_t)payload[2] | ((uint16_t)payload[3] << 8);
+            cmd.type = (CommandType)payload[1];
+            cmd.value = (cmd.type == COMMAND_RECIPE) ? (float)value : value / 100.0f;
+            cmd.sequence = (payloadLength == 6) ? (uint16_t)(payload[4] | ((uint16_t)payload[5] << 8)) : SEQUENCE_NONE;
+            cmd.isValid = validateCommand(cmd);
+            return cmd;
+        }
+        
+        case FRAME_OP_QUANTITY: {
+            if ((payloadLength != 4 && payloadLength != 6) || getChannelConfig((CommandType)payload[1]) == nullptr) {
+                cmd.type = COMMAND_UNKNOWN;
+                cmd.error = ERROR_UNKNOWN_COMMAND;
+                return cmd;
+            }
+            
+            uint16_t quantity = (uint16_t)payload[2] | ((uint16_t)payload[3] << 8);
+            cmd.type = (CommandType)payload[1];
+            cmd.value = quantity / 10.0f;
+            cmd.isQuantity = true;
+            cmd.sequence = (payloadLength == 6) ? (uint16_t)(payload[4] | ((uint16_t)payload[5] << 8)) : SEQUENCE_NONE;
+            cmd.isValid = validateCommand(cmd);
+            return cmd;
+        }
+        
+        case FRAME_OP_STATUS_POLL: {
+            if (payloadLength != 1) {
+                cmd.type = COMMAND_UNKNOWN;
+                cmd.error = ERROR_UNKNOWN_COMMAND;
+                return cmd;
+            }
+            cmd.type = COMMAND_STATUS;
+            cmd.isValid = true;
+            return cmd;
+        }
+        
+        case FRAME_OP_TELEMETRY_MODE: {
+            uint16_t sequence = (payloadLength == 4) ? (uint16_t)(payload[2] | ((uint16_t)payload[3] << 8)) : SEQUENCE_NONE;
+            if ((payloadLength != 2 && payloadLength != 4) || payload[1] > TELEMETRY_EVENT) {
+                reportError(ERROR_UNSUPPORTED, COMMAND_NONE);
+                reportNak(sequence, ERROR_UNSUPPORTED, COMMAND_NONE);
+                return cmd;
+            }
+            telemetryMode = (TelemetryMode)payload[1];
+            reportAck(sequence, COMMAND_NONE);
+            return cmd;
+        }
+        
+        case FRAME_OP_ASCII_MODE: {
+            uint8_t reply[] = { FRAME_OP_MODE, (uint8_t)PROTOCOL_ASCII };
+            writeFrame(reply, sizeof(reply));
+            protocolMode = PROTOCOL_ASCII;
+            return cmd;
+        }
+        
+        default:
+            cmd.type = COMMAND_UNKNOWN;
+            cmd.error = ERROR_UNKNOWN_COMMAND;
+            return cmd;
+    }
+}
+
+uint8_t SerialCommand::encodeFrame(const uint8_t* payload, uint8_t length, uint8_t* output) const {
+    uint8_t raw[FRAME_MAX_PAYLOAD + 2];
+    
+    if (length > FRAME_MAX_PAYLOAD) {
+        return 0;
+    }
+    
+    // 멀티드롭 버스에서는 응답에도 노드 주소를 붙여 호스트가 보낸 노드를 알 수 있게 합니다.
+    uint8_t rawLength = 0;
+    if (bus.isMultiDrop()) {
+        raw[rawLength++] = bus.getAddress();
+    }
+    memcpy(raw + rawLength, payload, length);
+    rawLength += length;
+    raw[rawLength] = crc8(raw, rawLength);
+    
+    uint8_t encodedLength = cobsEncode(raw, rawLength + 1, output);
+    output[encodedLength++] = FRAME_DELIMITER;
+    return encodedLength;
+}
+
+void SerialCommand::writeFrame(const uint8_t* payload, uint8_t length, TxLane lane, bool reserved) {
+    uint8_t encoded[FRAME_MAX_ENCODED];
+    uint8_t encodedLength = encodeFrame(payload, length, encoded);
+    if (encodedLength == 0) {
+        return;
+    }
+    tx.begin(lane, reserved).write(encoded, encodedLength);
+    tx.end();
+}
+
+uint8_t SerialCommand::crc8(const uint8_t* data, uint8_t length) {
+    uint8_t crc = 0x00;
+    
+    for (uint8_t i = 0; i < length; i++) {
+        crc ^= data[i];
+        for (uint8_t bit = 0; bit < 8; bit++) {
+            crc = (crc & 0x80) ? (uint8_t)((crc << 1) ^ 0x07) : (uint8_t)(crc << 1);
+        }
+    }
+    
+    return crc;
+}
+
+uint8_t SerialCommand::cobsEncode(const uint8_t* input, uint8_t length, uint8_t* output) {
+    uint8_t codeIndex = 0;
+    uint8_t writeIndex = 1;
+    uint8_t code = 1;
+    
+    for (uint8_t i = 0; i < length; i++) {
+        if (input[i] == 0) {
+            output[codeIndex] = code;
+            codeIndex = writeIndex++;
+            code = 1;
+        } else {
+            output[writeIndex++] = input[i];
+            code++;
+            // 프레임이 254 바이트를 넘지 않으므로 0xFF 블록 분할은 필요하지 않습니다.
+        }
+    }
+    
+    output[codeIndex] = code;
+    return writeIndex;
+}
+
+uint8_t SerialCommand::cobsDecode(const uint8_t* input, uint8_t length, uint8_t* output) {
+    uint8_t readIndex = 0;
+    uint8_t writeIndex = 0;
+    
+    while (readIndex < length) {
+        uint8_t code = input[readIndex++];
+        
+        if (code == 0 || readIndex + code - 1 > length) {
+            return 0;
+        }
+        
+        for (uint8_t i = 1; i < code; i++) {
+            output[writeIndex++] = input[readIndex++];
+        }
+        
+        if (code < 0xFF && readIndex < length) {
+            output[writeIndex++] = 0;
+        }
+    }
+    
+    return writeIndex;
+}
+
+uint16_t SerialCommand::toCentiseconds(float value) {
+    if (value <= 0) {
+        return 0;
+    }
+    if (value >= 655.35f) {
+        return 0xFFFF;
+    }
+    return (uint16_t)(value * 100.0f + 0.5f);
+}
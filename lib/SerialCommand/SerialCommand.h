@@ -2,6 +2,8 @@
 #define SERIALCOMMAND_H
 
 #include <Arduino.h>
+#include <BusLink.h>
+#include <TxQueue.h>
 
 // ===== 명령 타입 정의 =====
 enum CommandType {
@@ -12,45 +14,277 @@ enum CommandType {
     COMMAND_ICEDTEA,     // 아이스티 분배 명령
     COMMAND_GREENTEA,     // 녹차 분배 명령
     COMMAND_CUP, // 컵 디스펜스 명령
+    COMMAND_DC_MOTOR,    // DC 모터(진동) 명령
+    COMMAND_RECIPE,      // 레시피 실행 명령
+    COMMAND_STATS,       // 실행 시간 통계 조회 명령 (조회 후 초기화)
+    COMMAND_CALIBRATE,   // 분배량 보정 명령
+    COMMAND_JOURNAL,     // 분배 기록/누적 사용량 덤프 명령
+    COMMAND_BATCH,       // 여러 단계 명령 줄 (값: 단계 수)
+    COMMAND_STATUS,      // 노드 상태 조회 (멀티드롭 버스 폴링용 짧은 응답)
     COMMAND_UNKNOWN      // 알 수 없는 명령
 };
 
+// ===== 분배 채널 설정 =====
+// 분배 채널은 COMMAND_SUGAR 부터 COMMAND_CUP 까지이며, 설정 테이블(include/Channels.h)은 이 순서를 따릅니다.
+#define CHANNEL_FIRST_COMMAND COMMAND_SUGAR
+#define CHANNEL_COUNT (COMMAND_CUP - COMMAND_SUGAR + 1)
+
+// 분배 채널이 아닌 명령의 접두사 (채널 접두사는 설정 테이블에 정의)
+#define CMD_PREFIX_DC_MOTOR 'D'
+#define CMD_PREFIX_RECIPE   'R'
+#define CMD_PREFIX_STATS    'T'
+#define CMD_PREFIX_CALIBRATE 'K'   // "KS12.5": 마지막 설탕 분배에서 12.5g 이 나옴, "K": 보정값 조회
+#define CMD_PREFIX_QUANTITY  'Q'   // "QS5": 설탕 5g, "QW150": 물 150ml (보정값으로 시간 변환)
+#define CMD_PREFIX_JOURNAL   'J'   // 분배 기록 전체와 누적 사용량 덤프
+#define CMD_PREFIX_BAUD      'Y'   // "Y250000": 통신 속도 변경 요청, "Y": 지금 속도를 확정 (텍스트 모드 전용, 버스에서는 방송 전용)
+#define CMD_PREFIX_STATUS    'P'   // 노드 상태 조회 ("@* P": 버스의 모든 노드를 슬롯 순서대로 폴링)
+#define CMD_PREFIX_ADDRESS   'A'   // "A3": 노드 주소 3 으로 멀티드롭 사용, "A0": 1:1 연결, "A": 조회 (텍스트 모드 전용)
+#define CMD_PREFIX_TELEMETRY 'E'   // "E1": 센서 변경 이벤트 전송, "E0": 1초마다 전체 상태 (기본값), "E": 조회
+
+// 채널 설정 항목 (정의: include/Channels.h, SerialCommand 는 테이블 포인터만 보관)
+struct ChannelConfig;
+
+// ===== 에러 코드 정의 (바이너리 프로토콜에서 그대로 전송) =====
+enum CommandError {
+    ERROR_NONE,              // 에러 없음
+    ERROR_UNKNOWN_COMMAND,   // 알 수 없는 명령
+    ERROR_LINE_TOO_LONG,     // 명령 줄 길이 초과
+    ERROR_BAD_FRAME,         // 프레임 손상 (COBS/CRC 오류)
+    ERROR_DURATION_TOO_SHORT,// 작동 시간 너무 짧음
+    ERROR_DURATION_TOO_LONG, // 작동 시간 너무 김
+    ERROR_INVALID_RECIPE,    // 잘못된 레시피 번호
+    ERROR_UNKNOWN_RECIPE,    // 등록되지 않은 레시피
+    ERROR_RECIPE_ABORTED,    // 레시피 실행 중단
+    ERROR_QUEUE_FULL,        // 명령 대기열 가득 참
+    ERROR_OUT_OF_STOCK,      // 재고 부족
+    ERROR_UNSUPPORTED,       // 지원하지 않는 명령
+    ERROR_INVALID_QUANTITY,  // 분배량이 0 이하
+    ERROR_NOT_CALIBRATED,    // 보정되지 않은 채널에 분배량 명령
+    ERROR_NO_REFERENCE_RUN,  // 보정 기준이 될 시간 분배 기록 없음
+    ERROR_BATCH_REJECTED,    // 여러 단계 명령 줄 전체 거부 (값: 문제 단계 번호)
+    ERROR_BATCH_ABORTED,     // 여러 단계 명령 실행 중단 (값: 중단된 단계 번호)
+    ERROR_UNSUPPORTED_BAUD,  // 지원하지 않는 통신 속도 (값: 요청한 속도)
+    ERROR_BAUD_NOT_CONFIRMED,// 새 통신 속도에서 확인이 오지 않아 기본 속도로 복귀 (값: 요청했던 속도)
+    ERROR_INVALID_ADDRESS    // 잘못된 노드 주소 또는 방송으로 주소 변경 (값: 요청한 주소)
+};
+
+// ===== 통신 프로토콜 모드 =====
+enum ProtocolMode {
+    PROTOCOL_ASCII,          // 줄 단위 텍스트 (기본값, 기존 호스트 호환)
+    PROTOCOL_BINARY          // COBS 프레임 + CRC-8
+};
+
+// ===== 센서 텔레메트리 모드 =====
+// 부팅 때는 항상 TELEMETRY_SNAPSHOT 이며, 호스트가 "E1" (바이너리: FRAME_OP_TELEMETRY_MODE) 로 바꿉니다.
+// 스냅샷: INTERVAL_SENSOR_REPORT 마다 모든 키를 담은 JSON / [상태] 프레임 (기존 형식 그대로)
+// 이벤트: 디바운스된 상태가 바뀌면 바뀐 키만 담은 JSON / [상태][변경] 프레임을 즉시 보내고,
+//        INTERVAL_SENSOR_HEARTBEAT 동안 변경이 없으면 모든 키 / [상태][0] 하트비트를 보냅니다.
+// 모드를 바꾸면 바로 전체 상태를 한 번 보내 호스트가 변경을 적용할 기준을 갖게 합니다.
+enum TelemetryMode {
+    TELEMETRY_SNAPSHOT,      // 주기적 전체 상태 (기본값, 기존 호스트 호환)
+    TELEMETRY_EVENT          // 변경 즉시 + 느린 하트비트
+};
+
+// ===== 바이너리 프레임 정의 =====
+// 프레임: COBS( [opcode][payload...][CRC-8] ) + 0x00 구분자 (멀티드롭 버스: opcode 앞에 [주소])
+// 시간 값은 1/100초 단위 uint16 (리틀 엔디언) 고정소수점입니다.
+#define FRAME_DELIMITER        0x00
+#define FRAME_MAX_PAYLOAD      16     // opcode 포함, CRC 제외
+#define FRAME_MAX_ENCODED      (FRAME_MAX_PAYLOAD + 4)   // 주소 + 페이로드 + CRC 의 COBS 인코딩 + 구분자
+
+// 호스트 → 장치 (명령 프레임 끝에 [sequence lo][sequence hi] 를 붙이면 순서 번호 응답을 보냄)
+#define FRAME_OP_COMMAND       0x01   // [type][value_cs lo][value_cs hi] (레시피: value = 번호)
+#define FRAME_OP_QUANTITY      0x02   // [type][quantity×10 lo][quantity×10 hi] (g 또는 ml)
+#define FRAME_OP_STATUS_POLL   0x03   // 노드 상태 조회 (방송이면 슬롯 순서대로 응답)
+#define FRAME_OP_TELEMETRY_MODE 0x04  // [TelemetryMode][seq lo][seq hi] (순서 번호는 선택, ACK/NAK 용)
+#define FRAME_OP_ASCII_MODE    0x0F   // 텍스트 프로토콜로 복귀
+
+// 장치 → 호스트
+#define FRAME_OP_ACCEPTED      0x81   // [type][value_cs lo][value_cs hi]
+#define FRAME_OP_COMPLETED     0x82   // [type][arg]
+#define FRAME_OP_ERROR         0x83   // [error][type]
+#define FRAME_OP_TELEMETRY     0x84   // 스냅샷 모드: [상태 비트마스크], 이벤트 모드: [상태][변경 비트마스크] (변경 0: 하트비트)
+#define FRAME_OP_MODE          0x85   // [ProtocolMode]
+#define FRAME_OP_CALIBRATION   0x86   // [type][rate×100 lo][rate×100 hi] (초당 분배량, 0: 미보정)
+#define FRAME_OP_JOURNAL       0x87   // [sequence u32][boot][type][uptime_s u32][requested_cs u16][actual_cs u16]
+#define FRAME_OP_COUNTER       0x88   // [type][cycles u32][on_cs u32] (DC 모터: 진동 릴레이 전환 횟수)
+#define FRAME_OP_ACK           0x89   // [sequence u16][type] 명령 접수
+#define FRAME_OP_NAK           0x8A   // [sequence u16][type][error] 명령 거부 (실행되지 않음)
+#define FRAME_OP_DONE          0x8B   // [sequence u16][type][requested_cs u16][actual_cs u16] 실행 완료
+#define FRAME_OP_FAIL          0x8C   // [sequence u16][type][error] 접수 후 실행 실패/중단
+#define FRAME_OP_STATUS        0x8D   // [flags][분배 중 채널][센서 상태][대기 명령 수] (NodeStatus)
+#define FRAME_OP_BUS_END       0x8E   // 멀티드롭 버스에서 이번 차례의 응답 끝
+
+// 텍스트 모드에서 바이너리 모드로 전환하는 명령 (예: "B1")
+#define CMD_PREFIX_BINARY_MODE 'B'
+#define BINARY_PROTOCOL_VERSION 1
+
+// ===== 통신 속도 협상 =====
+// 호스트가 "Y250000" 을 보내면 현재 속도로 응답한 뒤 새 속도로 바꾸고, 호스트도 속도를 바꾼 다음
+// 새 속도에서 "Y" 를 보내야 확정됩니다. 제한 시간 안에 확인이 없으면 이번 실행에서만 기본 속도로 돌아갑니다.
+// EEPROM 에는 "Y" 로 확정한 속도만 저장되어 다음 부팅에 사용되며, 부팅 때도 같은 방식으로 확인을 기다립니다.
+// 부팅 때 기본 속도로 돌아갔더라도 저장값은 남아 있고, 기본 속도에서 "Y" 를 받아야 기본 속도가 저장됩니다.
+// 멀티드롭 버스에서는 방송("@* Y250000", "@* Y")으로만 받고 1:1 요청은 NAK 로 거부합니다.
+#define BAUD_CONFIRM_TIMEOUT_MS 2000     // 속도 변경 후 확인을 기다리는 시간
+#define BAUD_BOOT_CONFIRM_MS 10000       // 저장된 속도로 부팅한 뒤 확인을 기다리는 시간
+#define LINK_SETTINGS_MAGIC 0xB5         // EEPROM 통신 설정 영역 표시
+#define LINK_SETTINGS_VERSION 1
+
+// ===== 멀티드롭 버스 (선택) =====
+// 노드 주소를 정하면("A3", EEPROM 에 저장) 여러 장치가 RS-485 반이중 버스 하나를 나눠 씁니다.
+// 텍스트 명령 앞에 "@3 S2", "@3 17:S2" 처럼 주소를 붙이고, "@*" 는 모든 노드에 보냅니다.
+// 주소가 없거나 다른 줄은 응답 없이 버립니다 (다른 노드의 응답 줄도 '#' 으로 시작하므로 버려짐).
+// 노드는 자기 앞으로 온 요청을 받은 뒤에만 송신합니다: 그때까지 쌓인 응답과 완료 보고를 모두 보내고
+// "#3,END" 로 차례를 끝내며, 호스트는 이 줄을 받은 뒤 다음 요청을 보냅니다.
+// 방송 명령에는 바로 응답하지 않고 응답을 다음 차례에 함께 보냅니다. 단, 방송 상태 폴링 "@* P" 에는
+// 주소 순서대로 한 슬롯씩 "#3,P,플래그,분배 중 채널,센서,대기 명령 수" (16진수 2자리) 한 줄로 응답합니다.
+// 바이너리 모드에서는 프레임의 opcode 앞에 주소 바이트를 붙이며, 응답 프레임에도 노드 주소가 붙습니다.
+// 버스에서는 텔레메트리를 보내지 않으므로 센서 상태는 상태 폴링으로 확인합니다.
+// 버스의 모든 노드는 같은 프로토콜 모드를 써야 하고, 통신 속도는 "@* Y250000" 뒤 "@* Y" 처럼 방송으로 함께 바꿉니다.
+#define BUS_ADDRESS_PREFIX '@'
+#define BUS_BROADCAST_CHAR '*'
+#define BUS_RESPONSE_PREFIX '#'
+#define BUS_END_MAX_LENGTH 10            // 차례 끝 표시의 최대 길이 ("#247,END\r\n", 바이트)
+
+// 상태 응답 플래그 (NodeStatus::flags)
+#define NODE_STATUS_BUSY 0x01            // 분배/레시피/여러 단계 명령 실행 중
+#define NODE_STATUS_OUTPUT 0x02          // 보낼 응답이 남아 있음 (1:1 요청으로 가져가야 함)
+#define NODE_STATUS_DROPPED 0x04         // 지난 상태 응답 이후 차례를 기다리다 버린 응답이 있음
+#define NODE_STATUS_BAUD_PENDING 0x08    // 새 통신 속도 확인 대기 중
+
+// ===== 순서 번호 (선택) =====
+// 텍스트 명령 앞에 "17:" 처럼 번호를 붙이면 (예: "17:S2", "18:U1.5;S1+W8") 기존 응답에 더해
+// 기계가 읽기 쉬운 응답을 보냅니다: 접수 "ACK,17", 거부 "NAK,17,에러코드",
+// 완료 "DONE,17,이름,요청cs,실제cs", 접수 후 실패 "FAIL,17,에러코드". 번호 0 은 번호 없음과 같습니다.
+#define SEQUENCE_SEPARATOR ':'
+#define SEQUENCE_NONE 0
+
+// ===== 여러 단계 명령 줄 (텍스트 모드 전용) =====
+// "U1.5;S1+C2+W8;D3": ';' 로 나눈 그룹은 앞 그룹이 모두 끝난 뒤 차례로, '+' 로 묶은 단계는 동시에 실행합니다.
+// 각 단계는 한 줄 명령과 같은 형식이며 분배 채널, 분배량(Q), DC 모터 교반(D) 명령만 쓸 수 있습니다.
+#define BATCH_MAX_STEPS 8
+#define BATCH_SEQUENCE_SEPARATOR ';'
+#define BATCH_PARALLEL_SEPARATOR '+'
+
 // ===== 명령 구조체 =====
+#define COMMAND_TEXT_SIZE 12   // 에러 메시지용 원본 명령 보관 길이 (종료 문자 포함)
+
 struct Command {
     CommandType type;        // 명령 타입
-    float value;            // 명령 값 (초)
-    String rawCommand;      // 원본 명령 문자열
+    float value;            // 명령 값 (초, 레시피 명령은 레시피 번호, 수량/보정 명령은 g 또는 ml)
+    CommandType target;     // 보정 명령의 대상 채널 (COMMAND_NONE: 보정값 조회)
+    bool isQuantity;        // true: value 가 초가 아니라 분배량
+    uint16_t sequence;      // 호스트가 붙인 순서 번호 (SEQUENCE_NONE: 없음)
+    char rawCommand[COMMAND_TEXT_SIZE];  // 원본 명령 문자열 (길면 잘림)
     bool isValid;           // 명령 유효성
-    mutable String errorMessage;    // 에러 메시지 (mutable로 const 함수에서도 수정 가능)
+    mutable CommandError error;     // 에러 코드 (mutable로 const 함수에서도 수정 가능)
+};
+
+/**
+ * @brief 노드 상태 (상태 조회 응답)
+ */
+struct NodeStatus {
+    uint8_t flags;          // NODE_STATUS_* 비트 (OUTPUT, DROPPED, BAUD_PENDING 은 SerialCommand 가 채움)
+    uint8_t busyChannels;   // 분배 중인 채널 비트 (비트 i = 채널 설정 테이블 i번째)
+    uint8_t sensorBits;     // 디바운스된 센서 상태 (텔레메트리 비트와 같음)
+    uint8_t queued;         // 대기열의 명령 수
+};
+
+/**
+ * @brief 여러 단계 명령 줄의 한 단계
+ */
+struct BatchStep {
+    uint8_t type;           // 명령 타입 (CommandType)
+    uint8_t group;          // 실행 그룹 (같은 그룹은 동시에, 그룹 번호 순서대로 실행)
+    float value;            // 작동 시간 (초) 또는 분배량 (isQuantity)
+    bool isQuantity;        // true: value 가 분배량 (실행 전에 보정값으로 시간 변환)
 };
 
 /**
  * @brief 시리얼 명령 처리 클래스
  * 
  * 시리얼 통신을 통해 명령을 받아 파싱하고 검증합니다.
- * 설탕 분배(S)와 물 펌핑(W) 명령을 지원합니다.
+ * 분배 명령의 접두사, 이름, 최대 시간은 채널 설정 테이블에서 가져옵니다.
+ * 기본은 텍스트 프로토콜이며, 호스트가 "B1" 을 보내면 COBS + CRC-8
+ * 바이너리 프레임 프로토콜로 전환합니다.
+ * 응답은 TxQueue 에 쌓아 보내므로 출력 메서드는 송신을 기다리지 않습니다.
+ * 노드 주소가 있으면 BusLink 가 정한 응답 시간 창 안에서만 송신합니다 (멀티드롭 버스).
  */
 class SerialCommand {
 public:
     /**
      * @brief 생성자
-     * @param baudRate 시리얼 통신 속도 (기본값: 9600)
+     * @param channels 분배 채널 설정 테이블 (CHANNEL_COUNT 개, CommandType 순서)
+     * @param baudRate 기본 시리얼 통신 속도 (속도 변경 실패 시 복귀하는 속도, 기본값: 9600)
+     * @param eepromAddress 확정된 통신 속도와 노드 주소를 저장할 EEPROM 주소 (-1: 저장 안 함)
+     * @param busEnablePin RS-485 트랜시버 송신 허용(DE) 핀 (BUS_NO_PIN: 없음)
      */
-    SerialCommand(int baudRate = 9600);
+    SerialCommand(const ChannelConfig* channels, uint32_t baudRate = 9600, int eepromAddress = -1,
+                  uint8_t busEnablePin = BUS_NO_PIN);
 
     // ===== 초기화 메서드 =====
     /**
-     * @brief 시리얼 통신 초기화
+     * @brief 시리얼 통신 초기화 (EEPROM 에 확정된 속도가 있으면 그 속도로 시작하고 확인을 기다림, 저장된 노드 주소 적용)
      */
     void begin();
     
+    /**
+     * @brief 송신 진행 (매 loop()에서 호출, 멀티드롭 버스에서는 자기 차례에만 송신)
+     */
+    void update();
+    
+    /**
+     * @brief 멀티드롭 차례를 끝내지 않고 붙잡기 (여러 줄 보고가 loop() 마다 나누어 쌓이는 동안)
+     *
+     * 붙잡은 동안에는 대기열이 잠깐 비어도 차례 끝 표시를 보내지 않고 응답 창을 열어 둡니다.
+     * @param hold true: 이어서 보낼 보고가 남아 있음
+     */
+    void holdBusTurn(bool hold);
+    
+    /**
+     * @brief 송신 대기열 (텔레메트리/통계 등 직접 출력하는 메시지와 매 loop() 송신에 사용)
+     */
+    TxQueue& getOutput();
+    
     // ===== 명령 처리 메서드 =====
     /**
-     * @brief 시리얼에서 명령 읽기 및 파싱
-     * @return 파싱된 명령 구조체
+     * @brief 시리얼에서 명령 읽기 및 파싱 (논블로킹)
+     *
+     * 호출될 때마다 수신된 바이트만 라인 버퍼에 누적하고 즉시 반환합니다.
+     * 줄바꿈('\n')까지 한 줄이 모두 도착했을 때만 파싱된 명령을 반환합니다.
+     * @return 파싱된 명령 구조체 (완성된 줄이 없으면 COMMAND_NONE)
      */
     Command readCommand();
     
+    /**
+     * @brief 명령 문자열 한 줄을 파싱하고 검증
+     * @param commandString 명령 문자열
+     * @return 파싱된 명령 구조체
+     */
+    Command parseCommand(const char* commandString);
+    
+    /**
+     * @brief 여러 단계 명령 줄을 파싱하고 단계마다 검증 (하나라도 실패하면 전체 거부)
+     *
+     * 성공하면 단계들을 getBatchStep() 으로 조회할 수 있습니다.
+     * 실패하면 반환 명령의 target/rawCommand/error 에 문제 단계의 타입, 원본, 에러를,
+     * value 에 문제 단계 번호(1부터)를 담습니다.
+     * @param line 명령 줄
+     * @return COMMAND_BATCH 명령 (value: 단계 수)
+     */
+    Command parseBatch(const char* line);
+    
+    /**
+     * @brief 마지막으로 파싱한 여러 단계 명령 줄의 단계 수
+     */
+    uint8_t getBatchStepCount() const;
+    
+    /**
+     * @brief 마지막으로 파싱한 여러 단계 명령 줄의 단계 조회
+     * @param index 단계 번호 (0부터)
+     */
+    const BatchStep& getBatchStep(uint8_t index) const;
+    
     /**
      * @brief 명령 유효성 검증
      * @param cmd 검증할 명령
@@ -58,39 +292,430 @@ public:
      */
     bool validateCommand(const Command& cmd);
     
-    // ===== 정적 유틸리티 메서드 =====
     /**
-     * @brief 명령 문자열에서 타입 추출
+     * @brief 단독 진동(D) 명령을 지원하지 않는 명령으로 표시 (여러 단계 명령의 교반 단계는 허용)
+     * @param cmd 해석한 명령
+     */
+    void rejectStandaloneStir(Command& cmd);
+    
+    /**
+     * @brief 명령 문자열에서 타입 추출 (접두사 테이블 O(1) 조회)
      * @param commandString 명령 문자열
      * @return 명령 타입
      */
-    static CommandType getCommandType(const String& commandString);
+    CommandType getCommandType(const char* commandString) const;
+    
+    /**
+     * @brief 명령 타입의 채널 설정 반환
+     * @param type 명령 타입
+     * @return 채널 설정 (분배 채널이 아니면 nullptr)
+     */
+    const ChannelConfig* getChannelConfig(CommandType type) const;
+    
+    /**
+     * @brief 명령 타입의 표시 이름 반환
+     * @param type 명령 타입
+     * @return 이름 (예: "Sugar")
+     */
+    const char* getCommandName(CommandType type) const;
+    
+    // ===== 정적 유틸리티 메서드 =====
     
     /**
      * @brief 명령 문자열에서 값 추출
      * @param commandString 명령 문자열
      * @return 추출된 값 (초)
      */
-    static float extractValue(const String& commandString);
+    static float extractValue(const char* commandString);
+    
+    /**
+     * @brief CRC-8 계산 (다항식 0x07, 초기값 0x00)
+     * @param data 데이터
+     * @param length 데이터 길이
+     * @return CRC 값
+     */
+    static uint8_t crc8(const uint8_t* data, uint8_t length);
+    
+    /**
+     * @brief COBS 인코딩 (구분자 0x00 미포함)
+     * @param input 원본 데이터
+     * @param length 원본 길이
+     * @param output 인코딩 결과 버퍼 (length + 1 바이트 이상)
+     * @return 인코딩된 길이
+     */
+    static uint8_t cobsEncode(const uint8_t* input, uint8_t length, uint8_t* output);
+    
+    /**
+     * @brief COBS 디코딩
+     * @param input 인코딩된 데이터 (구분자 제외)
+     * @param length 인코딩된 길이
+     * @param output 디코딩 결과 버퍼 (length 바이트 이상)
+     * @return 디코딩된 길이 (형식 오류 시 0)
+     */
+    static uint8_t cobsDecode(const uint8_t* input, uint8_t length, uint8_t* output);
+    
+    // ===== 프로토콜 모드 =====
+    /**
+     * @brief 현재 프로토콜 모드 반환
+     */
+    ProtocolMode getProtocolMode() const;
+    
+    /**
+     * @brief 현재 시리얼 통신 속도
+     */
+    uint32_t getBaudRate() const;
+    
+    /**
+     * @brief 통신 속도 변경 후 확인을 기다리는 중인지 확인
+     */
+    bool isBaudPending() const;
+    
+    /**
+     * @brief 지원하는 통신 속도인지 확인
+     */
+    static bool isSupportedBaudRate(uint32_t baudRate);
+    
+    /**
+     * @brief 바이너리 프로토콜 사용 여부
+     */
+    bool isBinaryMode() const;
+    
+    /**
+     * @brief 센서 텔레메트리 모드 (호스트가 정함, 부팅 때는 TELEMETRY_SNAPSHOT)
+     */
+    TelemetryMode getTelemetryMode() const;
+    
+    // ===== 멀티드롭 버스 =====
+    /**
+     * @brief 노드 주소 (BUS_ADDRESS_NONE: 1:1 연결)
+     */
+    uint8_t getNodeAddress() const;
+    
+    /**
+     * @brief 멀티드롭 버스 사용 여부 (노드 주소가 설정됨)
+     */
+    bool isMultiDrop() const;
+    
+    /**
+     * @brief 버스 통계 (응답 창, 슬롯, 수신 필터)
+     */
+    const BusStats& getBusStats() const;
+    
+    /**
+     * @brief 버스 통계 초기화
+     */
+    void resetBusStats();
     
     // ===== 메시지 출력 메서드 =====
     /**
      * @brief 에러 메시지 출력
-     * @param error 에러 메시지
+     * @param error 에러 메시지 (F() 플래시 문자열)
      */
-    void printError(const String& error);
+    void printError(const __FlashStringHelper* error);
     
     /**
      * @brief 성공 메시지 출력
-     * @param message 성공 메시지
+     * @param message 성공 메시지 (F() 플래시 문자열)
+     */
+    void printSuccess(const __FlashStringHelper* message);
+    
+    // ===== 응답 보고 메서드 (프로토콜 모드에 맞게 전송) =====
+    /**
+     * @brief 명령 실행 시작 보고
+     * @param type 명령 타입
+     * @param value 명령 값 (초, 레시피 명령은 레시피 번호)
+     */
+    void reportAccepted(CommandType type, float value);
+    
+    /**
+     * @brief 명령 실행 완료 보고
+     * @param type 명령 타입
+     * @param arg 부가 정보 (레시피 명령은 레시피 번호)
+     */
+    void reportCompleted(CommandType type, uint8_t arg = 0);
+    
+    /**
+     * @brief 에러 보고 (텍스트 모드에서는 에러 코드로 문구를 만들어 출력)
+     * @param error 에러 코드
+     * @param type 관련 명령 타입
+     * @param value 관련 값 (레시피 번호 등)
+     * @param detail 원본 명령 문자열 (없으면 nullptr)
+     */
+    void reportError(CommandError error, CommandType type = COMMAND_NONE, float value = 0.0f, const char* detail = nullptr);
+    
+    /**
+     * @brief 파싱/검증에 실패한 명령의 에러 보고
+     * @param cmd 실패한 명령
+     */
+    void reportCommandError(const Command& cmd);
+    
+    /**
+     * @brief 채널 보정값 보고
+     * @param type 채널 명령 타입
+     * @param rate 초당 분배량 (0: 미보정)
+     */
+    void reportCalibration(CommandType type, float rate);
+    
+    /**
+     * @brief 분배 기록 한 건 보고
+     * @param sequence 기록 일련번호
+     * @param bootCount 기록 당시 부팅 번호
+     * @param type 채널 명령 타입
+     * @param uptimeSeconds 기록 당시 부팅 후 경과 시간 (초)
+     * @param requestedCs 요청 작동 시간 (1/100초)
+     * @param actualCs 실제 작동 시간 (1/100초)
+     */
+    void reportJournalEntry(uint32_t sequence, uint8_t bootCount, CommandType type,
+                            uint32_t uptimeSeconds, uint16_t requestedCs, uint16_t actualCs);
+    
+    /**
+     * @brief 액추에이터 누적 사용량 보고
+     * @param type 채널 명령 타입 (COMMAND_DC_MOTOR: 진동 릴레이)
+     * @param cycles 작동 횟수 (서보 열림/닫힘, 펌프/릴레이 전환)
+     * @param onTimeCs 누적 작동 시간 (1/100초)
      */
-    void printSuccess(const String& message);
+    void reportLifetimeCounter(CommandType type, uint32_t cycles, uint32_t onTimeCs);
+    
+    // ===== 순서 번호 응답 (번호가 SEQUENCE_NONE 이면 보내지 않음) =====
+    /**
+     * @brief 명령 접수 보고 (대기열에 넣었거나 즉시 처리함)
+     * @param sequence 순서 번호
+     * @param type 명령 타입
+     */
+    void reportAck(uint16_t sequence, CommandType type);
+    
+    /**
+     * @brief 명령 거부 보고 (파싱/검증 실패, 대기열 가득 참: 아무것도 실행되지 않음)
+     * @param sequence 순서 번호
+     * @param error 에러 코드
+     * @param type 명령 타입
+     */
+    void reportNak(uint16_t sequence, CommandError error, CommandType type);
+    
+    /**
+     * @brief 명령 실행 완료 보고
+     * @param sequence 순서 번호
+     * @param type 명령 타입
+     * @param requestedCs 요청 작동 시간 (1/100초, 레시피/여러 단계 명령은 0)
+     * @param actualCs 측정된 실제 작동 시간 (1/100초)
+     */
+    void reportDone(uint16_t sequence, CommandType type, uint16_t requestedCs, uint16_t actualCs);
+    
+    /**
+     * @brief 접수한 명령의 실행 실패/중단 보고 (재고 부족, 보정 없음, 레시피 중단 등)
+     * @param sequence 순서 번호
+     * @param error 에러 코드
+     * @param type 명령 타입
+     */
+    void reportFailed(uint16_t sequence, CommandError error, CommandType type);
+    
+    /**
+     * @brief 노드 상태 보고 (방송 폴링이면 이 노드의 슬롯에, 아니면 일반 응답으로 전송)
+     * @param status 노드 상태 (flags 에는 NODE_STATUS_BUSY 만 채워 전달)
+     */
+    void reportStatus(const NodeStatus& status);
+    
+    /**
+     * @brief 센서 상태 비트마스크 전송 (바이너리 모드 전용)
+     * @param stateBits 센서 상태 비트마스크
+     * @param changedBits 이번에 상태가 바뀐 센서 비트 (하트비트는 0, 스냅샷 모드에서는 보내지 않음)
+     */
+    void sendTelemetryFrame(uint8_t stateBits, uint8_t changedBits);
 
 private:
-    int baudRate;                                    // 시리얼 통신 속도
-    static constexpr float MAX_SUGAR_DURATION = 10.0f;  // 최대 설탕 분배 시간 (초)
-    static constexpr float MAX_WATER_DURATION = 30.0f;  // 최대 물 펌핑 시간 (초)
+    /**
+     * @brief 빈 명령 구조체 생성
+     */
+    static Command makeEmptyCommand();
+    
+    /**
+     * @brief 수신된 바이너리 프레임 해석
+     * @param frame COBS 인코딩된 프레임 (구분자 제외)
+     * @param length 프레임 길이
+     * @return 파싱된 명령 구조체
+     */
+    Command parseFrame(const uint8_t* frame, uint8_t length);
+    
+    /**
+     * @brief 바이너리 프레임 만들기 (멀티드롭이면 주소 추가, CRC 추가, COBS 인코딩, 구분자 추가)
+     * @param payload opcode 로 시작하는 페이로드
+     * @param length 페이로드 길이 (FRAME_MAX_PAYLOAD 이하)
+     * @param output 프레임 버퍼 (FRAME_MAX_ENCODED 바이트 이상)
+     * @return 프레임 길이 (페이로드가 너무 길면 0)
+     */
+    uint8_t encodeFrame(const uint8_t* payload, uint8_t length, uint8_t* output) const;
+    
+    /**
+     * @brief 바이너리 프레임 전송 (CRC 추가, COBS 인코딩, 구분자 추가)
+     * @param payload opcode 로 시작하는 페이로드
+     * @param length 페이로드 길이 (FRAME_MAX_PAYLOAD 이하)
+     * @param lane 송신 우선순위
+     * @param reserved true: 예약 메시지 (ACK/NAK/DONE/FAIL, 대기열이 차도 버리지 않도록 예약 자리 사용)
+     */
+    void writeFrame(const uint8_t* payload, uint8_t length, TxLane lane = TX_LANE_EVENT, bool reserved = false);
+    
+    /**
+     * @brief 텍스트 명령 줄이 프로토콜 전환 요청이면 처리
+     * @param line 명령 줄 (순서 번호를 뗀 뒤)
+     * @param sequence 순서 번호 (ACK/NAK 용, 없으면 SEQUENCE_NONE)
+     * @return true: 전환 요청을 처리함
+     */
+    bool handleModeSwitch(const char* line, uint16_t sequence);
+    
+    /**
+     * @brief 텍스트 명령 줄이 통신 속도 변경/확인 요청이면 처리
+     * @param line 명령 줄 (순서 번호를 뗀 뒤)
+     * @param sequence 순서 번호 (ACK/NAK 용, 없으면 SEQUENCE_NONE)
+     * @return true: 요청을 처리함
+     */
+    bool handleBaudSwitch(const char* line, uint16_t sequence);
+    
+    /**
+     * @brief 텍스트 명령 줄이 노드 주소 설정/조회 요청이면 처리
+     * @param line 명령 줄 (버스 주소와 순서 번호를 뗀 뒤)
+     * @param sequence 순서 번호 (ACK/NAK 용, 없으면 SEQUENCE_NONE)
+     * @return true: 요청을 처리함
+     */
+    bool handleAddressCommand(const char* line, uint16_t sequence);
+    
+    /**
+     * @brief 텍스트 명령 줄이 텔레메트리 모드 변경/조회 요청이면 처리
+     * @param line 명령 줄 (버스 주소와 순서 번호를 뗀 뒤)
+     * @param sequence 순서 번호 (ACK/NAK 용, 없으면 SEQUENCE_NONE)
+     * @return true: 요청을 처리함
+     */
+    bool handleTelemetryMode(const char* line, uint16_t sequence);
+    
+    /**
+     * @brief 명령 줄 앞의 버스 주소 ("@3 ", "@* ") 분리
+     * @param line 명령 줄
+     * @param target 분리한 주소 (형식이 틀리면 BUS_ADDRESS_NONE)
+     * @return 주소 뒤의 명령 문자열
+     */
+    static const char* splitAddress(const char* line, uint8_t& target);
+    
+    /**
+     * @brief 버스 요청을 받을지 결정하고, 1:1 요청이면 응답 창 예약 (수신 필터)
+     * @param target 요청의 주소
+     * @return false: 다른 노드 앞으로 온 요청 (응답 없이 버림)
+     */
+    bool acceptRequest(uint8_t target);
+    
+    /**
+     * @brief 이번 차례의 응답 끝 표시 전송 ("#3,END" 또는 FRAME_OP_BUS_END)
+     *
+     * 대기열을 거치지 않고 하드웨어 송신 버퍼로 바로 씁니다 (BUS_END_MAX_LENGTH 바이트 자리를 확인한 뒤 호출).
+     */
+    void reportBusEnd();
+    
+    /**
+     * @brief 노드 주소 응답 전송 ("SUCCESS: Node address 3")
+     * @param address 노드 주소 (BUS_ADDRESS_NONE: 1:1 연결)
+     */
+    void reportNodeAddress(uint8_t address);
+    
+    /**
+     * @brief 텔레메트리 모드 응답 전송 ("SUCCESS: Telemetry mode snapshot/event")
+     */
+    void reportTelemetryMode();
+    
+    /**
+     * @brief 통신 속도 변경 (보낼 응답을 모두 보낸 뒤 UART 재설정)
+     * @param baudRate 새 통신 속도
+     */
+    void applyBaudRate(uint32_t baudRate);
+    
+    /**
+     * @brief 확인 제한 시간이 지났으면 이번 실행에서만 기본 속도로 복귀 (readCommand()에서 호출, 저장값 유지)
+     */
+    void checkBaudTimeout();
+    
+    /**
+     * @brief EEPROM 에 확정된 통신 속도 읽기 (없거나 잘못된 값이면 0)
+     */
+    uint32_t loadBaudRate() const;
+    
+    /**
+     * @brief EEPROM 에 저장된 노드 주소 읽기 (없거나 잘못된 값이면 BUS_ADDRESS_NONE)
+     */
+    uint8_t loadNodeAddress() const;
+    
+    /**
+     * @brief 확정된 통신 속도를 EEPROM 에 저장
+     */
+    void saveBaudRate(uint32_t baudRate);
+    
+    /**
+     * @brief 통신 설정 영역 전체 저장 (매직, 버전, 속도, 노드 주소)
+     */
+    void saveLinkSettings(uint32_t baudRate, uint8_t address);
+    
+    /**
+     * @brief 통신 속도 응답 전송 ("SUCCESS: Baud rate 250000 requested/confirmed")
+     * @param baudRate 통신 속도
+     * @param confirmed true: 확정됨, false: 새 속도에서 확인 대기
+     */
+    void reportBaudRate(uint32_t baudRate, bool confirmed);
+    
+    /**
+     * @brief 초 단위 값을 1/100초 고정소수점으로 변환
+     */
+    static uint16_t toCentiseconds(float value);
+    
+    /**
+     * @brief 명령 타입별 최대 작동 시간 (초, 제한 없으면 0)
+     */
+    float getMaxDuration(CommandType type) const;
+
+    /**
+     * @brief 명령 줄이 여러 단계 명령인지 확인 (구분자 포함 여부)
+     */
+    static bool isBatchLine(const char* line);
+    
+    /**
+     * @brief 명령 줄 앞의 순서 번호 ("17:") 분리
+     * @param line 명령 줄
+     * @param sequence 분리한 순서 번호 (없으면 SEQUENCE_NONE)
+     * @return 순서 번호 뒤의 명령 문자열
+     */
+    static const char* splitSequence(const char* line, uint16_t& sequence);
+    
+    /**
+     * @brief 순서 번호 응답 전송 (ACK/NAK/FAIL 공통)
+     * @param opcode FRAME_OP_ACK, FRAME_OP_NAK, FRAME_OP_FAIL
+     * @param sequence 순서 번호
+     * @param error 에러 코드 (ACK 는 사용하지 않음)
+     * @param type 명령 타입
+     */
+    void writeSequenceEvent(uint8_t opcode, uint16_t sequence, CommandError error, CommandType type);
+
+    static constexpr uint8_t LINE_BUFFER_SIZE = 64;     // 명령 한 줄 최대 길이 (종료 문자 포함, 여러 단계 명령 포함)
+
+    const ChannelConfig* channels;                   // 분배 채널 설정 테이블
+    uint8_t prefixTypes[26];                         // 'A'~'Z' 접두사 → CommandType 조회 테이블
+    uint32_t defaultBaudRate;                        // 기본 통신 속도 (확인 실패 시 복귀)
+    uint32_t baudRate;                               // 현재 통신 속도
+    int eepromAddress;                               // 통신 설정 EEPROM 주소 (-1: 저장 안 함)
+    bool baudPending;                                // 새 속도에서 확인을 기다리는 중
+    uint32_t baudSwitchMillis;                       // 속도를 바꾼 시각
+    uint32_t baudConfirmTimeout;                     // 확인을 기다리는 시간 (밀리초)
+    uint8_t busEnablePin;                            // RS-485 송신 허용 핀
+    bool requestBroadcast;                           // 마지막으로 받은 버스 요청이 방송인지
+    uint32_t requestMicros;                          // 마지막으로 받은 버스 요청의 수신 시각
+    bool busTurnHeld;                                // 이어서 보낼 보고가 있어 차례 끝 표시를 미룸
+    uint16_t statusDropped;                          // 마지막 상태 응답 때의 버린 응답 수
+    char lineBuffer[LINE_BUFFER_SIZE];               // 수신 중인 명령 줄
+    uint8_t lineLength;                              // 라인 버퍼에 누적된 문자 수
+    bool lineOverflow;                               // 현재 줄이 버퍼 크기를 초과했는지 여부
+    bool lineFiltered;                               // 현재 줄이 버스 주소 없는 줄이라 버리는 중
+    ProtocolMode protocolMode;                       // 현재 프로토콜 모드
+    TelemetryMode telemetryMode;                     // 현재 센서 텔레메트리 모드
+    BatchStep batchSteps[BATCH_MAX_STEPS];           // 마지막으로 파싱한 여러 단계 명령
+    uint8_t batchStepCount;                          // batchSteps 의 단계 수
+    BusLink bus;                                     // 멀티드롭 송신 시간 창 (tx 의 송신 포트)
+    TxQueue tx;                                      // 우선순위별 송신 대기열
     static constexpr float MIN_DURATION = 0.01f;        // 최소 작동 시간 (초)
+    static constexpr uint8_t MAX_RECIPE_ID = 255;       // 최대 레시피 번호
 };
 
 #endif // SERIALCOMMAND_H 
\ No newline at end of file
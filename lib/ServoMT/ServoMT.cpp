@@ -1,11 +1,37 @@
 #include "ServoMT.h"
+#include "Channels.h"  // ChannelConfig 정의 (프로젝트 include/)
+
+ServoMT::ServoMT(int pin, const char* name)
+    : servoPin(pin), currentAngle(SERVO_ANGLE_MIN), targetAngle(SERVO_ANGLE_MIN),
+      position(SERVO_ANGLE_MIN), velocity(0.0f), maxSpeed(SERVO_DEFAULT_SPEED),
+      acceleration(SERVO_DEFAULT_ACCEL), lastUpdateMicros(0), cutOffAngle(SERVO_ANGLE_MIN), cutOffCount(0), seenCutOffCount(0), name(name) {
+}
+
+ServoMT::ServoMT()
+    : servoPin(-1), currentAngle(SERVO_ANGLE_MIN), targetAngle(SERVO_ANGLE_MIN),
+      position(SERVO_ANGLE_MIN), velocity(0.0f), maxSpeed(SERVO_DEFAULT_SPEED),
+      acceleration(SERVO_DEFAULT_ACCEL), lastUpdateMicros(0), cutOffAngle(SERVO_ANGLE_MIN), cutOffCount(0), seenCutOffCount(0), name(nullptr) {
+}
+
+void ServoMT::begin(const ChannelConfig& config) {
+    servoPin = config.actuatorPin;
+    name = config.name;
+    begin(config.closedAngle);
+}
+
+void ServoMT::begin(int initialAngle) {
+    if (initialAngle < SERVO_ANGLE_MIN) initialAngle = SERVO_ANGLE_MIN;
+    if (initialAngle > SERVO_ANGLE_MAX) initialAngle = SERVO_ANGLE_MAX;
+    targetAngle = initialAngle;
+    position = initialAngle;
+    velocity = 0.0f;
 
-ServoMT::ServoMT(int pin, String name) 
-    : servoPin(pin), currentAngle(SERVO_ANGLE_MIN), name(name) {
     pinMode(servoPin, OUTPUT);
-    servo.attach(servoPin);
-    servo.write(currentAngle);  // 초기 각도 설정
-    Serial.println(name + " ServoMT initialized");
+    servo.attach(servoPin, SERVO_PULSE_MIN_US, SERVO_PULSE_MAX_US);
+    writeAngle(position);  // 초기 각도 설정
+    lastUpdateMicros = micros();
+    Serial.print(name);
+    Serial.println(F(" ServoMT initialized"));
 }
 
 void ServoMT::setAngle(int angle) {
@@ -13,8 +39,80 @@ void ServoMT::setAngle(int angle) {
     if (angle < SERVO_ANGLE_MIN) angle = SERVO_ANGLE_MIN;
     if (angle > SERVO_ANGLE_MAX) angle = SERVO_ANGLE_MAX;
 
-    servo.write(angle);
-    currentAngle = angle;
+    targetAngle = angle;
+    if (maxSpeed <= 0.0f) {
+        // 프로파일 없음: 바로 이동
+        position = angle;
+        velocity = 0.0f;
+        writeAngle(position);
+    }
+}
+
+void ServoMT::cutOff(int angle) {
+    if (angle < SERVO_ANGLE_MIN) angle = SERVO_ANGLE_MIN;
+    if (angle > SERVO_ANGLE_MAX) angle = SERVO_ANGLE_MAX;
+
+    targetAngle = angle;
+    cutOffAngle = angle;
+    cutOffCount++;
+    writeAngle(angle);
+}
+
+void ServoMT::setMotionLimits(float maxSpeed, float acceleration) {
+    this->maxSpeed = maxSpeed;
+    this->acceleration = acceleration > 0.0f ? acceleration : SERVO_DEFAULT_ACCEL;
+}
+
+void ServoMT::update() {
+    uint32_t now = micros();
+    float dt = (now - lastUpdateMicros) / 1000000.0f;
+    lastUpdateMicros = now;
+
+    noInterrupts();
+    int target = targetAngle;  // 인터럽트가 바꿀 수 있으므로 한 번에 읽기
+    uint8_t cutOffs = cutOffCount;
+    int cutAngle = cutOffAngle;
+    interrupts();
+
+    // 지난 update() 뒤에 cutOff() 가 펄스를 바꿨으면 프로파일도 그 각도에 멈춘 상태에서 이어갑니다.
+    // (그 사이 setAngle() 로 다시 연 경우 닫힘 각도부터 프로파일을 따라 엽니다.)
+    if (cutOffs != seenCutOffCount) {
+        seenCutOffCount = cutOffs;
+        position = cutAngle;
+        velocity = 0.0f;
+    }
+
+    if (maxSpeed <= 0.0f || (position == target && velocity == 0.0f)) {
+        return;
+    }
+
+    // 남은 거리에서 제때 멈출 수 있는 속도(√(2·a·d))와 최대 속도 중 작은 값을 목표 속도로 삼고,
+    // 속도 변화는 가감속도 이내로 제한합니다 (사다리꼴 프로파일).
+    float error = target - position;
+    float direction = error > 0 ? 1.0f : -1.0f;
+    float desiredSpeed = sqrtf(2.0f * acceleration * fabsf(error));
+    if (desiredSpeed > maxSpeed) {
+        desiredSpeed = maxSpeed;
+    }
+    float deltaV = direction * desiredSpeed - velocity;
+    float maxDeltaV = acceleration * dt;
+    if (deltaV > maxDeltaV) deltaV = maxDeltaV;
+    if (deltaV < -maxDeltaV) deltaV = -maxDeltaV;
+    velocity += deltaV;
+    position += velocity * dt;
+
+    // 목표를 지나쳤으면 목표에 멈춥니다.
+    if ((target - position) * direction <= 0.0f) {
+        position = target;
+        velocity = 0.0f;
+    }
+
+    // 계산하는 동안 cutOff() 가 펄스를 바꿨으면 그 출력을 덮어쓰지 않습니다 (다음 update() 에서 맞춤).
+    noInterrupts();
+    if (cutOffCount == cutOffs) {
+        writeAngle(position);
+    }
+    interrupts();
 }
 
 void ServoMT::setMaxAngle() {
@@ -29,6 +127,21 @@ int ServoMT::getCurrentAngle() const {
     return currentAngle;
 }
 
-String ServoMT::getName() const {
+int ServoMT::getTargetAngle() const {
+    return targetAngle;
+}
+
+bool ServoMT::isInPosition() const {
+    // cutOff() 뒤 update() 가 아직 위치를 맞추지 않았으면 프로파일상 위치를 믿을 수 없습니다.
+    return cutOffCount == seenCutOffCount && position == targetAngle && velocity == 0.0f;
+}
+
+const char* ServoMT::getName() const {
     return name;
 }
+
+void ServoMT::writeAngle(float angle) {
+    int pulse = SERVO_PULSE_MIN_US + (int)(angle * (SERVO_PULSE_MAX_US - SERVO_PULSE_MIN_US) / SERVO_ANGLE_MAX + 0.5f);
+    servo.writeMicroseconds(pulse);
+    currentAngle = (int)(angle + 0.5f);
+}
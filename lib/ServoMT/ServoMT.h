@@ -4,32 +4,87 @@
 #include <Arduino.h>
 #include <Servo.h>
 
+// 채널 설정 항목 (정의: include/Channels.h)
+struct ChannelConfig;
+
 // ===== 서보 모터 각도 제한 =====
 #define SERVO_ANGLE_MIN 0
-#define SERVO_ANGLE_MAX 90
+#define SERVO_ANGLE_MAX 180
+
+// ===== 서보 펄스 폭 (Servo 라이브러리 기본값과 동일) =====
+#define SERVO_PULSE_MIN_US 544           // 0도 펄스 폭 (마이크로초)
+#define SERVO_PULSE_MAX_US 2400          // 180도 펄스 폭 (마이크로초)
+
+// ===== 기본 동작 프로파일 =====
+#define SERVO_DEFAULT_SPEED 400.0f       // 최대 속도 (도/초)
+#define SERVO_DEFAULT_ACCEL 4000.0f      // 가감속도 (도/초²)
 
 /**
  * @brief 서보 모터 제어 클래스
  * 
  * Arduino Servo 라이브러리를 래핑하여 더 편리한 인터페이스를 제공합니다.
  * 각도 제한, 상태 추적, 이름 관리 기능을 포함합니다.
+ * 
+ * setAngle() 은 목표 각도만 정하고, update() 가 호출될 때마다 최대 속도와
+ * 가감속도를 지키는 사다리꼴 속도 프로파일로 조금씩 이동합니다.
+ * 출력은 writeMicroseconds() 로 보내 1도보다 세밀하게 움직입니다.
+ * 속도를 0으로 설정하면 이전처럼 목표 각도로 바로 이동합니다.
  */
 class ServoMT {
 public:
     /**
      * @brief 생성자
      * @param pin 서보 모터 연결 핀 번호
-     * @param name 서보 모터 식별 이름
+     * @param name 서보 모터 식별 이름 (문자열 상수)
+     */
+    ServoMT(int pin, const char* name);
+
+    /**
+     * @brief 기본 생성자 (핀과 이름은 begin(const ChannelConfig&)에서 설정)
+     */
+    ServoMT();
+
+    // ===== 초기화 메서드 =====
+    /**
+     * @brief 서보 연결 및 초기 각도 설정 (setup()에서 호출)
+     * @param initialAngle 시작 각도 (프로파일 없이 바로 이동)
+     */
+    void begin(int initialAngle = SERVO_ANGLE_MIN);
+
+    /**
+     * @brief 채널 설정의 핀과 이름으로 서보 연결 (닫힘 각도에서 시작)
+     * @param config 분배 채널 설정 (ACTUATOR_SERVO)
      */
-    ServoMT(int pin, String name);
+    void begin(const ChannelConfig& config);
 
     // ===== 각도 제어 메서드 =====
     /**
-     * @brief 서보 모터 각도 설정
-     * @param angle 설정할 각도 (0-90도)
+     * @brief 서보 모터 목표 각도 설정 (인터럽트에서도 호출 가능)
+     * @param angle 설정할 각도 (SERVO_ANGLE_MIN ~ SERVO_ANGLE_MAX)
      */
     void setAngle(int angle);
     
+    /**
+     * @brief 프로파일 없이 바로 지정 각도 펄스 출력 (분배 종료 타이머 인터럽트용)
+     *
+     * 분배 종료 시각에 게이트가 닫히기 시작해야 하므로 loop() 를 기다리지 않고 인터럽트 안에서 펄스를 바꿉니다.
+     * 프로파일상 위치는 다음 update() 에서 이 각도로 맞추고, 그 뒤의 setAngle() 은 이 각도부터 프로파일을 따릅니다.
+     * @param angle 닫힘 각도 (SERVO_ANGLE_MIN ~ SERVO_ANGLE_MAX)
+     */
+    void cutOff(int angle);
+    
+    /**
+     * @brief 동작 프로파일 설정
+     * @param maxSpeed 최대 속도 (도/초, 0: 목표 각도로 바로 이동)
+     * @param acceleration 가감속도 (도/초²)
+     */
+    void setMotionLimits(float maxSpeed, float acceleration);
+    
+    /**
+     * @brief 목표 각도를 향해 한 단계 이동 (매 loop()에서 호출, 논블로킹)
+     */
+    void update();
+    
     /**
      * @brief 서보 모터 최대 각도로 설정 (열림)
      */
@@ -43,21 +98,46 @@ public:
     // ===== 상태 조회 메서드 =====
     /**
      * @brief 현재 서보 모터 각도 반환
-     * @return 현재 각도
+     * @return 현재 각도 (이동 중이면 지금 출력 중인 각도)
      */
     int getCurrentAngle() const;
     
+    /**
+     * @brief 목표 각도 반환
+     */
+    int getTargetAngle() const;
+    
+    /**
+     * @brief 목표 각도에 도착해 정지했는지 여부
+     */
+    bool isInPosition() const;
+    
     /**
      * @brief 서보 모터 이름 반환
      * @return 서보 모터 이름
      */
-    String getName() const;
+    const char* getName() const;
 
 private:
+    /**
+     * @brief 각도를 펄스 폭으로 변환하여 출력
+     * @param angle 출력할 각도 (소수 허용)
+     */
+    void writeAngle(float angle);
+
     int servoPin;           // 서보 모터 핀 번호
-    int currentAngle;       // 현재 각도
+    int currentAngle;       // 현재 각도 (정수 반올림)
+    volatile int targetAngle;  // 목표 각도 (분배 종료 인터럽트에서도 변경)
+    float position;         // 프로파일상 현재 각도 (도)
+    float velocity;         // 현재 속도 (도/초, 부호 = 방향)
+    float maxSpeed;         // 최대 속도 (도/초, 0: 즉시 이동)
+    float acceleration;     // 가감속도 (도/초²)
+    uint32_t lastUpdateMicros;  // 직전 update() 시각
+    volatile int cutOffAngle;     // 마지막 cutOff() 가 출력한 각도
+    volatile uint8_t cutOffCount; // cutOff() 호출 횟수 (update() 계산 중 끊겼는지 확인)
+    uint8_t seenCutOffCount;      // update() 가 마지막으로 반영한 cutOffCount
     Servo servo;           // Arduino Servo 객체
-    String name;           // 서보 모터 이름
+    const char* name;      // 서보 모터 이름
 };
 
 #endif // SERVOMT_H
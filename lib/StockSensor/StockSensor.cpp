@@ -1,16 +1,33 @@
 #include "StockSensor.h"
+#include "Channels.h"  // ChannelConfig 정의 (프로젝트 include/)
 
-StockSensor::StockSensor(int laserPin, int lightSensorPin, String name) 
-    : laserPin(laserPin), lightSensorPin(lightSensorPin), currentLightValue(STOCK_STATE_EMPTY), laserState(false), name(name) {
-    
+StockSensor::StockSensor(SensorBank& bank, int laserPin, int lightSensorPin, const char* name) 
+    : bank(&bank), bankIndex(-1), laserPin(laserPin), lightSensorPin(lightSensorPin), currentLightValue(STOCK_STATE_EMPTY), laserState(false), name(name) {
+}
+
+StockSensor::StockSensor()
+    : bank(nullptr), bankIndex(-1), laserPin(-1), lightSensorPin(-1), currentLightValue(STOCK_STATE_EMPTY), laserState(false), name(nullptr) {
+}
+
+void StockSensor::begin(SensorBank& bank, const ChannelConfig& config) {
+    this->bank = &bank;
+    laserPin = config.laserPin;
+    lightSensorPin = config.sensorPin;
+    name = config.name;
+    begin();
+}
+
+void StockSensor::begin() {
     pinMode(laserPin, OUTPUT);
     pinMode(lightSensorPin, INPUT);
+    bankIndex = bank->addPin(lightSensorPin);
     
     // 레이저 초기 상태: OFF
     digitalWrite(laserPin, LOW);
     laserState = false;
     
-    Serial.println(name + " StockSensor initialized");
+    Serial.print(name);
+    Serial.println(F(" StockSensor initialized"));
 } 
 
 void StockSensor::turnOnLaser() {
@@ -28,7 +45,7 @@ bool StockSensor::isLaserOn() const {
 }
 
 int StockSensor::readLightSensor() {
-    currentLightValue = digitalRead(lightSensorPin);
+    currentLightValue = bankIndex >= 0 ? bank->read(bankIndex) : digitalRead(lightSensorPin);
     return currentLightValue;
 }
 
@@ -42,12 +59,12 @@ bool StockSensor::isStockEmpty() {
     return (currentLightValue == STOCK_STATE_EMPTY);
 }
 
-String StockSensor::getStockStateString() {
+const char* StockSensor::getStockStateString() {
     readLightSensor();  // 현재 상태 업데이트
     if (currentLightValue == STOCK_STATE_FULL) {
-        return "LOW";   // 재고 있음 (레이저 빛 차단)
+        return STR_STOCK_STATE_FULL;   // 재고 있음 (레이저 빛 차단)
     } else {
-        return "HIGH";  // 재고 없음 (레이저 빛 감지)
+        return STR_STOCK_STATE_EMPTY;  // 재고 없음 (레이저 빛 감지)
     }
 }
 
@@ -63,6 +80,6 @@ int StockSensor::getLightSensorPin() const {
     return lightSensorPin;
 }
 
-String StockSensor::getName() const {
+const char* StockSensor::getName() const {
     return name;
 } 
\ No newline at end of file
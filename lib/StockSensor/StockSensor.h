@@ -2,26 +2,54 @@
 #define STOCKSENSOR_H
 
 #include <Arduino.h>
+#include <SensorBank.h>
+
+// 채널 설정 항목 (정의: include/Channels.h)
+struct ChannelConfig;
 
 // ===== 재고 상태 정의 =====
 #define STOCK_STATE_EMPTY HIGH    // 재고 없음 (레이저 빛 감지)
 #define STOCK_STATE_FULL LOW      // 재고 있음 (레이저 빛 차단)
 
+// ===== 재고 상태 문자열 (JSON 값으로 사용) =====
+#define STR_STOCK_STATE_FULL "LOW"     // 재고 있음
+#define STR_STOCK_STATE_EMPTY "HIGH"   // 재고 없음
+
 /**
  * @brief 재고 감지 센서 제어 클래스
  * 
  * 레이저 모듈과 조도 센서를 조합하여 재고 상태를 감지합니다.
  * 레이저 빛이 차단되면 재고가 있는 것으로 판단합니다.
+ * 조도 센서 값은 SensorBank 가 일괄 샘플링/디바운스한 스냅샷에서 읽습니다.
  */
 class StockSensor {
 public:
     /**
      * @brief 생성자
+     * @param bank 조도 센서 핀을 샘플링하는 센서 뱅크
      * @param laserPin 레이저 모듈 연결 핀 번호
      * @param lightSensorPin 조도 센서 연결 핀 번호
-     * @param name 재고 센서 식별 이름
+     * @param name 재고 센서 식별 이름 (문자열 상수)
+     */
+    StockSensor(SensorBank& bank, int laserPin, int lightSensorPin, const char* name);
+
+    /**
+     * @brief 기본 생성자 (센서 뱅크, 핀과 이름은 begin(SensorBank&, const ChannelConfig&)에서 설정)
+     */
+    StockSensor();
+
+    // ===== 초기화 메서드 =====
+    /**
+     * @brief 핀 설정, 센서 뱅크 등록 및 레이저 OFF (setup()에서 SensorBank::begin() 전에 호출)
+     */
+    void begin();
+
+    /**
+     * @brief 채널 설정의 레이저/조도 센서 핀과 이름으로 초기화 (SensorBank::begin() 전에 호출)
+     * @param bank 조도 센서 핀을 샘플링하는 센서 뱅크
+     * @param config 분배 채널 설정 (SENSOR_STOCK)
      */
-    StockSensor(int laserPin, int lightSensorPin, String name);
+    void begin(SensorBank& bank, const ChannelConfig& config);
 
     // ===== 레이저 제어 메서드 =====
     /**
@@ -42,7 +70,7 @@ public:
 
     // ===== 센서 읽기 메서드 =====
     /**
-     * @brief 조도 센서 상태 읽기
+     * @brief 조도 센서 상태 읽기 (센서 뱅크의 디바운스된 스냅샷)
      * @return 센서 값 (HIGH: 빛 감지, LOW: 빛 차단)
      */
     int readLightSensor();
@@ -63,9 +91,9 @@ public:
     // ===== 정보 반환 메서드 =====
     /**
      * @brief 현재 재고 상태 문자열 반환
-     * @return "LOW" (재고 있음) 또는 "HIGH" (재고 없음)
+     * @return "LOW" (재고 있음) 또는 "HIGH" (재고 없음), 정적 문자열
      */
-    String getStockStateString();
+    const char* getStockStateString();
     
     /**
      * @brief 조도 센서 값 반환
@@ -89,14 +117,16 @@ public:
      * @brief 재고 센서 이름 반환
      * @return 이름
      */
-    String getName() const;
+    const char* getName() const;
 
 private:
+    SensorBank* bank;       // 조도 센서 샘플링 뱅크
+    int8_t bankIndex;       // 센서 뱅크 내 인덱스 (-1: 미등록, digitalRead 사용)
     int laserPin;           // 레이저 모듈 핀 번호
     int lightSensorPin;     // 조도 센서 핀 번호
     int currentLightValue;  // 현재 조도 센서 값
     bool laserState;        // 레이저 모듈 상태
-    String name;           // 재고 센서 이름
+    const char* name;      // 재고 센서 이름
 };
 
 #endif // STOCKSENSOR_H 
\ No newline at end of file
@@ -0,0 +1,60 @@
+#include "TaskScheduler.h"
+
+TaskScheduler::TaskScheduler()
+    : taskCount(0) {
+}
+
+int8_t TaskScheduler::add(TaskFunction function, const char* name, uint16_t budgetUs, uint8_t arg) {
+    if (taskCount >= TASK_SCHEDULER_MAX_TASKS || function == nullptr) {
+        return -1;
+    }
+
+    Task& task = tasks[taskCount];
+    task.function = function;
+    task.name = name;
+    task.arg = arg;
+    task.resumePoint = 0;
+    task.waitEvents = 0;
+    task.events = 0;
+    task.budgetUs = budgetUs;
+    task.startMicros = 0;
+    task.maxRunMicros = 0;
+    task.overruns = 0;
+    return taskCount++;
+}
+
+void TaskScheduler::run(uint16_t dueEvents) {
+    for (uint8_t i = 0; i < taskCount; i++) {
+        Task& task = tasks[i];
+        if (task.waitEvents != 0 && !(task.waitEvents & dueEvents)) {
+            continue;  // 기다리는 이벤트가 아직 없음
+        }
+
+        task.events = dueEvents;
+        task.startMicros = micros();
+        task.function(task);
+
+        uint32_t elapsed = micros() - task.startMicros;
+        if (elapsed > task.maxRunMicros) {
+            task.maxRunMicros = elapsed;
+        }
+        if (elapsed > task.budgetUs && task.overruns < 0xFFFF) {
+            task.overruns++;
+        }
+    }
+}
+
+uint8_t TaskScheduler::getTaskCount() const {
+    return taskCount;
+}
+
+const Task& TaskScheduler::getTask(uint8_t index) const {
+    return tasks[index < taskCount ? index : 0];
+}
+
+void TaskScheduler::resetStats() {
+    for (uint8_t i = 0; i < taskCount; i++) {
+        tasks[i].maxRunMicros = 0;
+        tasks[i].overruns = 0;
+    }
+}
@@ -0,0 +1,120 @@
+#ifndef TASKSCHEDULER_H
+#define TASKSCHEDULER_H
+
+#include <Arduino.h>
+
+// ===== 스케줄러 설정 =====
+#define TASK_SCHEDULER_MAX_TASKS 16      // 최대 태스크 수
+
+// ===== 스택 없는 코루틴 매크로 (protothread 방식) =====
+// 태스크 함수 본문을 TASK_BEGIN/TASK_END 로 감싸면 TASK_YIELD/TASK_WAIT_* 지점에서 반환했다가
+// 다음 실행 때 그 지점부터 이어서 실행합니다. 재개 위치는 Task::resumePoint 에 줄 번호로 저장되므로
+// 대기 지점을 지나 유지해야 하는 값은 지역 변수가 아니라 전역/정적 변수나 Task 필드에 두어야 합니다.
+// (switch 문을 사용하므로 TASK_BEGIN ~ TASK_END 사이에 다른 switch 문을 두지 마세요.)
+#define TASK_BEGIN(task) switch ((task).resumePoint) { case 0:
+
+// 재개 위치를 저장한 뒤 바로 아래 case 로 이어지는 것은 의도된 동작입니다 (-Wimplicit-fallthrough 표시).
+#if defined(__GNUC__) && __GNUC__ >= 7
+#define TASK_FALLTHROUGH __attribute__((fallthrough))
+#else
+#define TASK_FALLTHROUGH do { } while (0)
+#endif
+
+#define TASK_YIELD(task) \
+    do { (task).resumePoint = __LINE__; return; case __LINE__:; } while (0)
+
+#define TASK_WAIT_UNTIL(task, condition) \
+    do { (task).resumePoint = __LINE__; TASK_FALLTHROUGH; case __LINE__: if (!(condition)) return; } while (0)
+
+#define TASK_WAIT_EVENT(task, eventMask) \
+    do { (task).waitEvents = (eventMask); (task).resumePoint = __LINE__; return; \
+         case __LINE__: (task).waitEvents = 0; } while (0)
+
+#define TASK_END(task) } (task).resumePoint = 0
+
+struct Task;
+
+/**
+ * @brief 태스크 함수 (한 번 호출에 짧게 실행하고 반환)
+ */
+typedef void (*TaskFunction)(Task& task);
+
+/**
+ * @brief 협력형 태스크 (스케줄러 슬롯 하나)
+ */
+struct Task {
+    TaskFunction function;      // 태스크 함수
+    const char* name;           // 이름 (통계 출력용)
+    uint8_t arg;                // 태스크 인자 (같은 함수를 채널마다 등록할 때 채널 번호 등)
+    uint16_t resumePoint;       // 코루틴 재개 위치 (0: 처음부터)
+    uint16_t waitEvents;        // 기다리는 이벤트 비트 (0: 매번 실행)
+    uint16_t events;            // 이번 실행에서 받은 이벤트 비트
+    uint16_t budgetUs;          // 한 번 실행의 시간 예산 (마이크로초)
+    uint32_t startMicros;       // 이번 실행 시작 시각
+    uint32_t maxRunMicros;      // 통계: 가장 긴 실행 시간
+    uint16_t overruns;          // 통계: 시간 예산 초과 횟수
+
+    /**
+     * @brief 이번 실행이 시간 예산을 다 썼는지 확인 (반복 작업을 나눌 때 사용)
+     */
+    bool isOverBudget() const {
+        return (uint32_t)(micros() - startMicros) >= budgetUs;
+    }
+};
+
+/**
+ * @brief 협력형 태스크 스케줄러
+ *
+ * 등록된 태스크를 순서대로 한 번씩 실행합니다 (선점 없음).
+ * 이벤트를 기다리는 태스크는 해당 이벤트가 들어온 회차에만 실행되고,
+ * 태스크마다 실행 시간을 재어 시간 예산 초과를 기록합니다.
+ * 동적 메모리를 쓰지 않으며, 하드웨어에 의존하지 않아 호스트(native)에서도 그대로 동작합니다.
+ */
+class TaskScheduler {
+public:
+    /**
+     * @brief 생성자
+     */
+    TaskScheduler();
+
+    // ===== 태스크 등록 메서드 =====
+    /**
+     * @brief 태스크 등록 (setup()에서 호출, 등록 순서대로 실행)
+     * @param function 태스크 함수
+     * @param name 이름 (문자열 상수)
+     * @param budgetUs 한 번 실행의 시간 예산 (마이크로초)
+     * @param arg 태스크 인자
+     * @return 태스크 번호 (슬롯이 없으면 -1)
+     */
+    int8_t add(TaskFunction function, const char* name, uint16_t budgetUs, uint8_t arg = 0);
+
+    // ===== 실행 메서드 =====
+    /**
+     * @brief 모든 태스크를 한 번씩 실행 (매 loop()에서 호출)
+     * @param dueEvents 이번 회차에 발생한 이벤트 비트 (TimerWheel::poll() 결과 등)
+     */
+    void run(uint16_t dueEvents);
+
+    // ===== 통계 메서드 =====
+    /**
+     * @brief 등록된 태스크 수
+     */
+    uint8_t getTaskCount() const;
+
+    /**
+     * @brief 태스크 조회
+     * @param index 태스크 번호
+     */
+    const Task& getTask(uint8_t index) const;
+
+    /**
+     * @brief 모든 태스크의 실행 시간 통계 초기화
+     */
+    void resetStats();
+
+private:
+    Task tasks[TASK_SCHEDULER_MAX_TASKS];   // 태스크 슬롯
+    uint8_t taskCount;                      // 등록된 태스크 수
+};
+
+#endif // TASKSCHEDULER_H
@@ -0,0 +1,101 @@
+#include "TimerWheel.h"
+
+TimerWheel::TimerWheel()
+    : activeMask(0), nextDeadline(0), lastPollTime(0) {
+    for (uint8_t i = 0; i < TIMER_WHEEL_SLOTS; i++) {
+        deadlines[i] = 0;
+        periods[i] = 0;
+    }
+}
+
+void TimerWheel::begin(uint32_t now) {
+    activeMask = 0;
+    lastPollTime = now;
+}
+
+void TimerWheel::schedule(uint8_t slot, uint32_t delayMs) {
+    scheduleAt(slot, lastPollTime + delayMs);
+}
+
+void TimerWheel::scheduleAt(uint8_t slot, uint32_t deadline) {
+    if (slot >= TIMER_WHEEL_SLOTS) {
+        return;
+    }
+    deadlines[slot] = deadline;
+    periods[slot] = 0;
+    activeMask |= TIMER_EVENT(slot);
+    updateNextDeadline();
+}
+
+void TimerWheel::schedulePeriodic(uint8_t slot, uint32_t periodMs) {
+    if (slot >= TIMER_WHEEL_SLOTS || periodMs == 0) {
+        return;
+    }
+    deadlines[slot] = lastPollTime + periodMs;
+    periods[slot] = periodMs;
+    activeMask |= TIMER_EVENT(slot);
+    updateNextDeadline();
+}
+
+void TimerWheel::cancel(uint8_t slot) {
+    if (slot >= TIMER_WHEEL_SLOTS) {
+        return;
+    }
+    activeMask &= ~TIMER_EVENT(slot);
+    updateNextDeadline();
+}
+
+uint16_t TimerWheel::poll(uint32_t now) {
+    lastPollTime = now;
+    if (activeMask == 0 || !isDue(now, nextDeadline)) {
+        return 0;  // 대부분의 반복은 여기서 끝납니다.
+    }
+
+    uint16_t dueMask = 0;
+    for (uint8_t i = 0; i < TIMER_WHEEL_SLOTS; i++) {
+        uint16_t bit = TIMER_EVENT(i);
+        if (!(activeMask & bit) || !isDue(now, deadlines[i])) {
+            continue;
+        }
+        dueMask |= bit;
+        if (periods[i] == 0) {
+            activeMask &= ~bit;
+        } else {
+            // 위상을 유지하며 다음 주기로, 한 주기 이상 밀렸으면 지금부터 다시 시작
+            deadlines[i] += periods[i];
+            if (isDue(now, deadlines[i])) {
+                deadlines[i] = now + periods[i];
+            }
+        }
+    }
+    updateNextDeadline();
+    return dueMask;
+}
+
+bool TimerWheel::isScheduled(uint8_t slot) const {
+    return slot < TIMER_WHEEL_SLOTS && (activeMask & TIMER_EVENT(slot));
+}
+
+uint32_t TimerWheel::getDeadline(uint8_t slot) const {
+    return slot < TIMER_WHEEL_SLOTS ? deadlines[slot] : 0;
+}
+
+bool TimerWheel::isDue(uint32_t now, uint32_t deadline) {
+    return (int32_t)(now - deadline) >= 0;
+}
+
+void TimerWheel::updateNextDeadline() {
+    // 만기 시각끼리 부호 있는 차이로 비교하여 가장 이른 슬롯을 고릅니다 (오버플로 안전).
+    bool found = false;
+    uint32_t nearest = 0;
+    for (uint8_t i = 0; i < TIMER_WHEEL_SLOTS; i++) {
+        if (!(activeMask & TIMER_EVENT(i))) {
+            continue;
+        }
+        if (!found || (int32_t)(deadlines[i] - nearest) < 0) {
+            nearest = deadlines[i];
+            found = true;
+        }
+    }
+    nextDeadline = nearest;
+}
@@ -0,0 +1,103 @@
+#ifndef TIMERWHEEL_H
+#define TIMERWHEEL_H
+
+#include <Arduino.h>
+
+// ===== 타이머 슬롯 설정 =====
+#define TIMER_WHEEL_SLOTS 16                      // 최대 슬롯 수 (이벤트 비트마스크 크기)
+#define TIMER_EVENT(slot) ((uint16_t)1 << (slot))  // 슬롯 번호 → poll() 결과 비트
+
+/**
+ * @brief 고정 슬롯 소프트웨어 타이머 (밀리초 단위 만기 관리)
+ *
+ * 슬롯마다 만기 시각(32비트)과 반복 주기를 저장하고, poll() 이 만기된 슬롯을
+ * 이벤트 비트마스크로 돌려줍니다. 가장 가까운 만기 시각을 따로 보관하므로
+ * 만기된 슬롯이 없으면 poll() 은 비교 한 번으로 끝납니다.
+ * 시각 비교는 (int32_t)(now - deadline) >= 0 으로 하여 millis() 가 약 49.7일마다
+ * 0으로 돌아가도 올바르게 동작합니다 (한 번에 설정 가능한 지연은 약 24.8일 이하).
+ */
+class TimerWheel {
+public:
+    /**
+     * @brief 생성자
+     */
+    TimerWheel();
+
+    // ===== 초기화 메서드 =====
+    /**
+     * @brief 모든 슬롯 해제 및 기준 시각 설정 (setup()에서 호출)
+     * @param now 현재 시각 (밀리초)
+     */
+    void begin(uint32_t now);
+
+    // ===== 슬롯 설정 메서드 =====
+    /**
+     * @brief 한 번 만기되는 타이머 설정 (이미 설정되어 있으면 다시 설정)
+     * @param slot 슬롯 번호 (0 ~ TIMER_WHEEL_SLOTS-1)
+     * @param delayMs 마지막 poll() 시각부터 만기까지의 시간 (밀리초)
+     */
+    void schedule(uint8_t slot, uint32_t delayMs);
+
+    /**
+     * @brief 절대 시각에 만기되는 타이머 설정
+     * @param slot 슬롯 번호
+     * @param deadline 만기 시각 (millis() 기준)
+     */
+    void scheduleAt(uint8_t slot, uint32_t deadline);
+
+    /**
+     * @brief 주기적으로 만기되는 타이머 설정
+     * @param slot 슬롯 번호
+     * @param periodMs 반복 주기 (밀리초, 0 초과)
+     */
+    void schedulePeriodic(uint8_t slot, uint32_t periodMs);
+
+    /**
+     * @brief 타이머 해제
+     * @param slot 슬롯 번호
+     */
+    void cancel(uint8_t slot);
+
+    // ===== 만기 확인 메서드 =====
+    /**
+     * @brief 만기된 슬롯 확인 (매 loop()에서 한 번 호출)
+     *
+     * 한 번 만기되는 슬롯은 해제하고, 주기 슬롯은 다음 만기 시각으로 옮깁니다.
+     * 주기보다 오래 밀렸으면 놓친 만기는 한 번으로 합칩니다.
+     * @param now 현재 시각 (밀리초)
+     * @return 만기된 슬롯의 비트마스크 (TIMER_EVENT(slot))
+     */
+    uint16_t poll(uint32_t now);
+
+    // ===== 상태 조회 메서드 =====
+    /**
+     * @brief 슬롯이 설정되어 있는지 확인
+     */
+    bool isScheduled(uint8_t slot) const;
+
+    /**
+     * @brief 슬롯의 만기 시각 반환 (설정되지 않았으면 의미 없음)
+     */
+    uint32_t getDeadline(uint8_t slot) const;
+
+    /**
+     * @brief 시각이 만기 시각에 도달했는지 확인 (오버플로 안전)
+     * @param now 현재 시각
+     * @param deadline 만기 시각
+     */
+    static bool isDue(uint32_t now, uint32_t deadline);
+
+private:
+    /**
+     * @brief 설정된 슬롯 중 가장 가까운 만기 시각 다시 계산
+     */
+    void updateNextDeadline();
+
+    uint32_t deadlines[TIMER_WHEEL_SLOTS];  // 슬롯별 만기 시각
+    uint32_t periods[TIMER_WHEEL_SLOTS];    // 슬롯별 반복 주기 (0: 한 번)
+    uint16_t activeMask;                    // 설정된 슬롯 비트마스크
+    uint32_t nextDeadline;                  // 가장 가까운 만기 시각
+    uint32_t lastPollTime;                  // 마지막 poll() 시각 (schedule() 기준)
+};
+
+#endif // TIMERWHEEL_H
@@ -0,0 +1,60 @@
+#include "TimingStats.h"
+
+TimingStats::TimingStats() {
+    reset();
+}
+
+void TimingStats::record(int32_t value) {
+    if (count == 0 || value < minValue) minValue = value;
+    if (count == 0 || value > maxValue) maxValue = value;
+    count++;
+    sum += value;
+    
+    uint16_t& bucket = buckets[bucketIndex(value)];
+    if (bucket < 0xFFFF) {
+        bucket++;
+    }
+}
+
+void TimingStats::reset() {
+    count = 0;
+    minValue = 0;
+    maxValue = 0;
+    sum = 0;
+    memset(buckets, 0, sizeof(buckets));
+}
+
+uint32_t TimingStats::getCount() const {
+    return count;
+}
+
+int32_t TimingStats::getMin() const {
+    return minValue;
+}
+
+int32_t TimingStats::getMax() const {
+    return maxValue;
+}
+
+int32_t TimingStats::getMean() const {
+    return count > 0 ? (int32_t)(sum / (int64_t)count) : 0;
+}
+
+uint16_t TimingStats::getBucket(uint8_t index) const {
+    return index < TIMING_STATS_BUCKETS ? buckets[index] : 0;
+}
+
+uint8_t TimingStats::bucketIndex(int32_t value) {
+    if (value < 1) {
+        return 0;
+    }
+    
+    // 비트 길이 = 버킷 번호 (1 → 1, 2~3 → 2, 4~7 → 3, ...)
+    uint8_t index = 0;
+    uint32_t magnitude = (uint32_t)value;
+    while (magnitude != 0 && index < TIMING_STATS_BUCKETS - 1) {
+        magnitude >>= 1;
+        index++;
+    }
+    return index;
+}
@@ -0,0 +1,76 @@
+#ifndef TIMINGSTATS_H
+#define TIMINGSTATS_H
+
+#include <Arduino.h>
+
+// ===== 히스토그램 설정 =====
+// 버킷 0: 1us 미만(음수 포함), 버킷 i: 2^(i-1) ~ 2^i - 1 us, 마지막 버킷: 그 이상 전부
+#define TIMING_STATS_BUCKETS 16
+
+/**
+ * @brief 시간 측정값 통계 클래스
+ * 
+ * 측정값(마이크로초)의 개수, 최소/최대/평균과 로그 스케일 히스토그램을 누적합니다.
+ * 동적 메모리 없이 고정 크기로 동작하며, 버킷 카운트는 포화(65535)되어 넘치지 않습니다.
+ */
+class TimingStats {
+public:
+    /**
+     * @brief 생성자
+     */
+    TimingStats();
+
+    // ===== 측정 메서드 =====
+    /**
+     * @brief 측정값 추가
+     * @param value 측정값 (마이크로초, 음수 허용)
+     */
+    void record(int32_t value);
+    
+    /**
+     * @brief 누적 통계 초기화
+     */
+    void reset();
+
+    // ===== 정보 반환 메서드 =====
+    /**
+     * @brief 측정 횟수
+     */
+    uint32_t getCount() const;
+    
+    /**
+     * @brief 최솟값 (측정 없으면 0)
+     */
+    int32_t getMin() const;
+    
+    /**
+     * @brief 최댓값 (측정 없으면 0)
+     */
+    int32_t getMax() const;
+    
+    /**
+     * @brief 평균값 (측정 없으면 0)
+     */
+    int32_t getMean() const;
+    
+    /**
+     * @brief 히스토그램 버킷 카운트
+     * @param index 버킷 번호 (0 ~ TIMING_STATS_BUCKETS-1)
+     */
+    uint16_t getBucket(uint8_t index) const;
+    
+    /**
+     * @brief 측정값이 속하는 버킷 번호
+     * @param value 측정값 (마이크로초)
+     */
+    static uint8_t bucketIndex(int32_t value);
+
+private:
+    uint32_t count;                             // 측정 횟수
+    int32_t minValue;                           // 최솟값
+    int32_t maxValue;                           // 최댓값
+    int64_t sum;                                // 합계 (평균 계산용)
+    uint16_t buckets[TIMING_STATS_BUCKETS];     // 로그 스케일 히스토그램
+};
+
+#endif // TIMINGSTATS_H
@@ -0,0 +1,226 @@
+#include "TxQueue.h"
+
+TxQueue::TxQueue(Print& port)
+    : port(port), openLane(TX_LANE_NONE), chunkStart(0), openFailed(false), openReserved(false),
+      sendLane(TX_LANE_NONE), sendRemaining(0), sendContinued(false), telemetryWaiting(false),
+      paused(false) {
+    uint8_t* buffers[TX_LANE_COUNT] = { eventBuffer, telemetryBuffer };
+    const uint16_t sizes[TX_LANE_COUNT] = { TX_QUEUE_EVENT_SIZE, TX_QUEUE_TELEMETRY_SIZE };
+    const uint16_t reserves[TX_LANE_COUNT] = { TX_QUEUE_EVENT_RESERVE, 0 };
+    for (uint8_t i = 0; i < TX_LANE_COUNT; i++) {
+        lanes[i].buffer = buffers[i];
+        lanes[i].mask = sizes[i] - 1;
+        lanes[i].reserve = reserves[i];
+        lanes[i].readIndex = 0;
+        lanes[i].commitIndex = 0;
+        lanes[i].writeIndex = 0;
+    }
+    resetStats();
+}
+
+Print& TxQueue::begin(TxLane lane, bool reserved) {
+    if (openLane != TX_LANE_NONE) {
+        end();  // 이전 메시지를 닫지 않았으면 그대로 완료합니다.
+    }
+    if (lane >= TX_LANE_COUNT) {
+        return *this;
+    }
+
+    openLane = lane;
+    openFailed = false;
+    openReserved = reserved;
+    reserveHeader(lanes[lane]);  // 첫 조각의 헤더 자리
+    return *this;
+}
+
+void TxQueue::end() {
+    if (openLane == TX_LANE_NONE) {
+        return;
+    }
+
+    Lane& lane = lanes[openLane];
+    if (openFailed) {
+        // 버리기로 한 메시지: 조각을 end() 에서만 송신 대상으로 넘기므로 통째로 되돌릴 수 있습니다.
+        lane.writeIndex = lane.commitIndex;
+        if (openReserved) {
+            lane.stats.lost++;
+        } else {
+            lane.stats.dropped++;
+        }
+    } else {
+        closeChunk(false);
+    }
+    openLane = TX_LANE_NONE;
+}
+
+size_t TxQueue::write(uint8_t c) {
+    if (openLane == TX_LANE_NONE || openFailed) {
+        return 0;
+    }
+
+    Lane& lane = lanes[openLane];
+    if (getChunkLength(lane) >= TX_CHUNK_MAX_LENGTH) {
+        // 조각이 가득 찼으면 닫고 다음 조각의 헤더를 잡습니다.
+        closeChunk(true);
+        if (!reserveHeader(lane)) {
+            return 0;
+        }
+    }
+    if (!checkRoom(lane, 1)) {
+        return 0;
+    }
+
+    lane.buffer[lane.writeIndex & lane.mask] = c;
+    lane.writeIndex++;
+
+    uint16_t used = lane.writeIndex - lane.readIndex;
+    if (used > lane.stats.peakBytes) {
+        lane.stats.peakBytes = used;
+    }
+    return 1;
+}
+
+void TxQueue::update() {
+    if (paused) {
+        return;
+    }
+
+    int space = port.availableForWrite();
+    while (space > 0) {
+        if (sendRemaining == 0) {
+            // 조각 경계: 메시지가 끝났으면 다음 메시지의 우선순위를 고릅니다.
+            if (!sendContinued) {
+                sendLane = selectLane();
+                if (sendLane == TX_LANE_NONE) {
+                    return;
+                }
+            }
+
+            Lane& lane = lanes[sendLane];
+            if (lane.readIndex == lane.commitIndex) {
+                return;  // 같은 메시지의 다음 조각을 아직 쓰는 중
+            }
+            uint8_t header = lane.buffer[lane.readIndex & lane.mask];
+            lane.readIndex++;
+            sendRemaining = header & TX_CHUNK_MAX_LENGTH;
+            sendContinued = (header & TX_CHUNK_CONTINUED) != 0;
+            continue;
+        }
+
+        // 링 끝에서 끊어지지 않는 만큼 한 번에 넘깁니다 (하드웨어 버퍼에 자리가 있으므로 블로킹 없음).
+        Lane& lane = lanes[sendLane];
+        uint16_t position = lane.readIndex & lane.mask;
+        uint16_t count = sendRemaining;
+        if (count > (uint16_t)space) {
+            count = space;
+        }
+        if (count > lane.mask + 1 - position) {
+            count = lane.mask + 1 - position;
+        }
+        port.write(lane.buffer + position, count);
+        lane.readIndex += count;
+        sendRemaining -= count;
+        space -= count;
+    }
+}
+
+void TxQueue::flush() {
+    if (openLane != TX_LANE_NONE) {
+        end();
+    }
+    while (!paused && !isEmpty()) {
+        update();
+        yield();
+    }
+    port.flush();
+}
+
+void TxQueue::setPaused(bool paused) {
+    this->paused = paused;
+}
+
+uint16_t TxQueue::getFree(TxLane lane) const {
+    if (lane >= TX_LANE_COUNT) {
+        return 0;
+    }
+    const Lane& target = lanes[lane];
+    uint16_t free = (target.mask + 1) - (uint16_t)(target.writeIndex - target.readIndex);
+    return free > target.reserve ? free - target.reserve : 0;
+}
+
+bool TxQueue::isEmpty() const {
+    for (uint8_t i = 0; i < TX_LANE_COUNT; i++) {
+        if (lanes[i].readIndex != lanes[i].commitIndex) {
+            return false;
+        }
+    }
+    return sendRemaining == 0;
+}
+
+const TxLaneStats& TxQueue::getStats(TxLane lane) const {
+    return lanes[lane < TX_LANE_COUNT ? lane : TX_LANE_EVENT].stats;
+}
+
+void TxQueue::resetStats() {
+    for (uint8_t i = 0; i < TX_LANE_COUNT; i++) {
+        lanes[i].stats.peakBytes = 0;
+        lanes[i].stats.dropped = 0;
+        lanes[i].stats.lost = 0;
+        lanes[i].stats.deferred = 0;
+    }
+}
+
+void TxQueue::closeChunk(bool continued) {
+    Lane& lane = lanes[openLane];
+    lane.buffer[chunkStart & lane.mask] = getChunkLength(lane) | (continued ? TX_CHUNK_CONTINUED : 0);
+    // 메시지는 마지막 조각을 닫을 때 한꺼번에 넘깁니다.
+    if (!continued) {
+        lane.commitIndex = lane.writeIndex;
+    }
+}
+
+bool TxQueue::reserveHeader(Lane& lane) {
+    if (!checkRoom(lane, 1)) {
+        return false;
+    }
+    chunkStart = lane.writeIndex++;
+    return true;
+}
+
+bool TxQueue::checkRoom(Lane& lane, uint16_t bytes) {
+    if (hasRoom(lane, bytes)) {
+        return true;
+    }
+    // 기다리지 않고 메시지째 버립니다. 텔레메트리는 다음 하트비트로 다시 전송되고,
+    // 여러 줄 보고는 호출자가 getFree() 로 여유를 확인하며 나누어 쌓습니다.
+    // 일반 메시지는 예약 자리 앞에서 버려지므로 예약 메시지는 그 자리에 들어갑니다.
+    openFailed = true;
+    return false;
+}
+
+uint8_t TxQueue::getChunkLength(const Lane& lane) const {
+    return (uint8_t)(lane.writeIndex - chunkStart - 1);
+}
+
+bool TxQueue::hasRoom(const Lane& lane, uint16_t bytes) const {
+    uint16_t limit = (uint16_t)(lane.mask + 1) - (openReserved ? 0 : lane.reserve);
+    return (uint16_t)(lane.writeIndex - lane.readIndex) + bytes <= limit;
+}
+
+uint8_t TxQueue::selectLane() {
+    for (uint8_t i = 0; i < TX_LANE_COUNT; i++) {
+        Lane& lane = lanes[i];
+        if (lane.readIndex == lane.commitIndex) {
+            continue;
+        }
+        // 텔레메트리가 기다리는데 응답을 먼저 보내면 밀린 텔레메트리로 한 번 셉니다.
+        if (i == TX_LANE_TELEMETRY) {
+            telemetryWaiting = false;
+        } else if (!telemetryWaiting && lanes[TX_LANE_TELEMETRY].readIndex != lanes[TX_LANE_TELEMETRY].commitIndex) {
+            telemetryWaiting = true;
+            lanes[TX_LANE_TELEMETRY].stats.deferred++;
+        }
+        return i;
+    }
+    return TX_LANE_NONE;
+}
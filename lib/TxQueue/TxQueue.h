@@ -0,0 +1,183 @@
+#ifndef TXQUEUE_H
+#define TXQUEUE_H
+
+#include <Arduino.h>
+
+// ===== 송신 대기열 크기 (2의 거듭제곱) =====
+#define TX_QUEUE_EVENT_SIZE 512        // 응답/에러/완료 메시지 대기열 (바이트)
+#define TX_QUEUE_EVENT_RESERVE 192     // 응답 대기열 중 예약 메시지(ACK/NAK/DONE/FAIL)만 쓰는 자리 (최장 DONE 줄 5개, 바이트)
+#define TX_QUEUE_TELEMETRY_SIZE 256    // 센서 텔레메트리 대기열 (하트비트 두 줄 정도, 바이트)
+
+// ===== 메시지 조각 헤더 =====
+// 대기열에는 메시지를 [헤더][바이트...] 조각으로 저장합니다. 헤더 하위 7비트는 조각 길이,
+// 최상위 비트는 같은 메시지의 조각이 더 있다는 표시입니다 (긴 메시지는 여러 조각으로 나뉨).
+#define TX_CHUNK_MAX_LENGTH 0x7F
+#define TX_CHUNK_CONTINUED 0x80
+
+/**
+ * @brief 송신 우선순위 (숫자가 작을수록 먼저 전송)
+ */
+enum TxLane : uint8_t {
+    TX_LANE_EVENT,       // 명령 응답, 에러, 완료, ACK/NAK/DONE/FAIL, 기록 덤프, 통계
+    TX_LANE_TELEMETRY,   // 주기/변경 센서 데이터
+    TX_LANE_COUNT,
+    TX_LANE_NONE = 0xFF  // 열린 메시지 없음
+};
+
+/**
+ * @brief 우선순위 대기열별 통계
+ */
+struct TxLaneStats {
+    uint16_t peakBytes;      // 대기열에 쌓였던 최대 바이트 수
+    uint16_t dropped;        // 자리가 없어 버린 일반 메시지 수 (안내 문구, 보고 줄)
+    uint16_t lost;           // 예약 자리까지 가득 차 버린 예약 메시지 수 (0 이어야 정상)
+    uint16_t deferred;       // 더 높은 우선순위 메시지에 밀려 늦게 보낸 메시지 수
+};
+
+/**
+ * @brief 우선순위별 시리얼 송신 대기열
+ *
+ * 메시지를 begin(lane) ~ end() 사이에 이 객체(Print)로 출력하면 펌웨어 쪽 링 버퍼에 쌓고 바로 반환합니다.
+ * update() 가 하드웨어 송신 버퍼(UDRE 인터럽트가 비우는 64바이트)에 남은 자리만큼만 옮기므로
+ * 송신 중에 loop() 가 멈추지 않습니다. 메시지 단위로 우선순위를 정해, 보내는 중인 메시지를 끝낸 뒤
+ * 응답 대기열에 메시지가 있으면 텔레메트리보다 먼저 보냅니다 (메시지끼리 섞이지 않음).
+ * 대기열이 가득 차면 기다리지 않고 새 메시지를 통째로 버리고 셉니다. 짧은 응답은 대기열 크기에 비해
+ * 충분히 작고, 여러 줄을 보내는 보고(기록 덤프, 통계)는 getFree() 로 여유를 확인하며 loop() 마다 나누어 쌓습니다.
+ * 호스트가 순서 번호로 기다리는 ACK/NAK/DONE/FAIL 은 예약 메시지(begin(lane, true))로 쌓습니다.
+ * 일반 메시지는 응답 대기열의 마지막 TX_QUEUE_EVENT_RESERVE 바이트를 쓰지 못하므로, 대기열이 차면
+ * 안내 문구와 보고 줄이 먼저 버려지고 예약 메시지는 남은 자리에 들어갑니다.
+ * 멀티드롭 버스에서 자기 차례를 기다리는 동안에는 송신을 멈추고(setPaused) 메시지를 쌓기만 합니다.
+ */
+class TxQueue : public Print {
+public:
+    /**
+     * @brief 생성자
+     * @param port 실제 송신 포트 (Serial)
+     */
+    explicit TxQueue(Print& port);
+
+    // ===== 메시지 작성 메서드 =====
+    /**
+     * @brief 메시지 시작 (이후 print/write 는 이 메시지에 쌓임)
+     * @param lane 우선순위
+     * @param reserved true: 예약 메시지 (대기열의 예약 자리까지 사용, ACK/NAK/DONE/FAIL 등)
+     * @return 메시지를 출력할 Print (이 객체)
+     */
+    Print& begin(TxLane lane, bool reserved = false);
+
+    /**
+     * @brief 메시지 완료 (이제부터 송신 대상)
+     */
+    void end();
+
+    /**
+     * @brief 열린 메시지에 한 바이트 추가 (begin() 없이 쓴 바이트는 버림)
+     */
+    size_t write(uint8_t c) override;
+    using Print::write;
+
+    // ===== 송신 메서드 =====
+    /**
+     * @brief 하드웨어 송신 버퍼에 자리가 있는 만큼 옮기기 (매 loop()에서 호출, 블로킹 없음)
+     */
+    void update();
+
+    /**
+     * @brief 대기 중인 메시지를 모두 보낼 때까지 기다림 (통신 속도 변경 전 등, 블로킹)
+     */
+    void flush() override;
+
+    /**
+     * @brief 송신 멈춤/재개 (멈춘 동안 메시지는 쌓기만 하고, 자리가 없으면 버림)
+     * @param paused true: 송신 멈춤
+     */
+    void setPaused(bool paused);
+
+    // ===== 상태 조회 메서드 =====
+    /**
+     * @brief 대기열에서 일반 메시지가 쓸 수 있는 남은 자리 (예약 자리 제외, 바이트)
+     * @param lane 우선순위
+     */
+    uint16_t getFree(TxLane lane) const;
+
+    /**
+     * @brief 보낼 메시지가 하나도 없는지 확인
+     */
+    bool isEmpty() const;
+
+    /**
+     * @brief 대기열별 통계
+     * @param lane 우선순위
+     */
+    const TxLaneStats& getStats(TxLane lane) const;
+
+    /**
+     * @brief 통계 초기화
+     */
+    void resetStats();
+
+private:
+    /**
+     * @brief 우선순위 하나의 링 버퍼 (인덱스는 계속 증가하며 크기로 나눈 나머지 위치에 저장)
+     */
+    struct Lane {
+        uint8_t* buffer;         // 저장 공간
+        uint16_t mask;           // 크기 - 1
+        uint16_t readIndex;      // 다음에 보낼 위치
+        uint16_t commitIndex;    // 완성된 조각의 끝 (여기까지만 보냄)
+        uint16_t writeIndex;     // 작성 중인 조각의 끝
+        uint16_t reserve;        // 예약 메시지만 쓰는 자리 (바이트)
+        TxLaneStats stats;       // 통계
+    };
+
+    /**
+     * @brief 작성 중인 조각의 헤더에 길이를 적고 송신 대상으로 넘기기
+     * @param continued true: 같은 메시지의 조각이 더 있음
+     */
+    void closeChunk(bool continued);
+
+    /**
+     * @brief 새 조각의 헤더 자리 잡기
+     * @return false: 자리가 없어 메시지를 버리기로 함
+     */
+    bool reserveHeader(Lane& lane);
+
+    /**
+     * @brief 자리가 있는지 확인하고, 없으면 작성 중인 메시지를 버리기로 함 (기다리지 않음)
+     * @return false: 메시지를 버리기로 함
+     */
+    bool checkRoom(Lane& lane, uint16_t bytes);
+
+    /**
+     * @brief 작성 중인 조각에 쓴 바이트 수
+     */
+    uint8_t getChunkLength(const Lane& lane) const;
+
+    /**
+     * @brief 작성 중인 메시지가 대기열에 n 바이트를 더 넣을 자리가 있는지 확인 (일반 메시지는 예약 자리 제외)
+     */
+    bool hasRoom(const Lane& lane, uint16_t bytes) const;
+
+    /**
+     * @brief 다음에 보낼 우선순위 선택 (보낼 메시지가 없으면 TX_LANE_NONE)
+     */
+    uint8_t selectLane();
+
+    Print& port;                                    // 실제 송신 포트
+    uint8_t eventBuffer[TX_QUEUE_EVENT_SIZE];       // 응답 대기열 저장 공간
+    uint8_t telemetryBuffer[TX_QUEUE_TELEMETRY_SIZE]; // 텔레메트리 대기열 저장 공간
+    Lane lanes[TX_LANE_COUNT];                      // 우선순위별 대기열
+
+    uint8_t openLane;          // 작성 중인 메시지의 우선순위 (TX_LANE_NONE: 없음)
+    uint16_t chunkStart;       // 작성 중인 조각의 헤더 위치
+    bool openFailed;           // 작성 중인 메시지를 버리기로 함 (자리 없음)
+    bool openReserved;         // 작성 중인 메시지가 예약 메시지
+
+    uint8_t sendLane;          // 보내는 중인 메시지의 우선순위 (TX_LANE_NONE: 메시지 경계)
+    uint8_t sendRemaining;     // 보내는 중인 조각의 남은 바이트
+    bool sendContinued;        // 보내는 중인 조각 뒤에 같은 메시지의 조각이 더 있음
+    bool telemetryWaiting;     // 대기 중인 텔레메트리가 이미 밀린 것으로 세어짐
+    bool paused;               // 송신 멈춤 (버스 차례 대기)
+};
+
+#endif // TXQUEUE_H
@@ -0,0 +1,130 @@
+# PlatformIO extra script for env:bench: runs the benchmark firmware under simavr.
+#
+#   pio run -e bench -t bench            run, write $BUILD_DIR/bench.json, compare with bench/baseline.json
+#   pio run -e bench -t bench_baseline   run and store the result as bench/baseline.json
+#
+# The firmware prints one {"bench":...} JSON line per benchmark on UART0 and then
+# sleeps with interrupts disabled, which makes simavr exit. The bench target fails when
+# an average cycle count grows by more than BENCH_TOLERANCE (default 5 %, override with
+# the BENCH_TOLERANCE environment variable) against the baseline, when a baselined
+# benchmark no longer reports, or when no measured baseline exists. The committed
+# baseline is a placeholder marked "_status": "unmeasured" until someone records it
+# with bench_baseline on a machine with simavr.
+
+Import("env")
+
+import json
+import os
+import re
+import shutil
+import subprocess
+import sys
+
+SIMAVR = os.environ.get("SIMAVR", "simavr")
+MCU = "atmega2560"
+TIMEOUT_S = 600
+BENCH_TOLERANCE = float(os.environ.get("BENCH_TOLERANCE", "0.05"))
+BASELINE_UNMEASURED = "unmeasured"
+ANSI_ESCAPE = re.compile(r"\x1b\[[0-9;]*m")
+
+
+def _run_simavr(elf):
+    command = [SIMAVR, "-m", MCU, "-f", env.subst("$BOARD_F_CPU").rstrip("L"), elf]
+    print("Running: %s" % " ".join(command))
+    try:
+        output = subprocess.run(command, stdout=subprocess.PIPE, stderr=subprocess.STDOUT,
+                                universal_newlines=True, timeout=TIMEOUT_S).stdout
+    except FileNotFoundError:
+        sys.stderr.write("simavr not found (set SIMAVR=/path/to/simavr)\n")
+        env.Exit(1)
+    except subprocess.TimeoutExpired:
+        sys.stderr.write("simavr did not finish within %d s\n" % TIMEOUT_S)
+        env.Exit(1)
+
+    results = {}
+    for line in output.splitlines():
+        line = ANSI_ESCAPE.sub("", line).strip()
+        start = line.find('{"bench":')
+        if start < 0:
+            continue
+        record = json.loads(line[start:])
+        name = record.pop("bench")
+        if name != "done":
+            results[name] = record
+    if "memory" not in results:
+        sys.stderr.write("benchmark did not complete:\n%s\n" % output[-2000:])
+        env.Exit(1)
+    return results
+
+
+def _compare(results, baseline):
+    regressions = 0
+    print("")
+    print("===== AVR benchmark (%s @ %s) =====" % (MCU, env.subst("$BOARD_F_CPU")))
+    for name, record in results.items():
+        if name == "memory":
+            continue
+        line = "  %-18s avg %8d cyc  max %8d cyc  %9.1f us  stack %4d B" % (
+            name, record["avg"], record["max"], record["us"], record["stack"])
+        old = baseline.get(name)
+        if old and old.get("avg"):
+            change = (record["avg"] - old["avg"]) / float(old["avg"])
+            line += "  (%+.1f%%)" % (100.0 * change)
+            if change > BENCH_TOLERANCE:
+                line += "  REGRESSION"
+                regressions += 1
+        else:
+            line += "  (new, no baseline)"
+        print(line)
+    for name in sorted(baseline):
+        if name != "memory" and not name.startswith("_") and name not in results:
+            print("  %-18s missing from this run  REGRESSION" % name)
+            regressions += 1
+    memory = results["memory"]
+    print("  SRAM: static %d B, stack peak %d B, free %d / %d B" % (
+        memory["static"], memory["stack_peak"], memory["free"], memory["sram"]))
+    print("=====================================")
+    if regressions:
+        print("%d benchmark regression(s) (cycle threshold +%.1f%%)" % (regressions, 100.0 * BENCH_TOLERANCE))
+    return regressions
+
+
+def _load_baseline(path):
+    """Returns (baseline, problem); problem is a message when there is nothing to compare against."""
+    if not os.path.exists(path):
+        return {}, "no baseline at %s" % path
+    with open(path) as f:
+        baseline = json.load(f)
+    if baseline.get("_status") == BASELINE_UNMEASURED:
+        return {}, "%s is an unmeasured placeholder" % path
+    return baseline, None
+
+
+def _bench(update_baseline):
+    def action(source, target, env):
+        results = _run_simavr(str(source[0]))
+        output = os.path.join(env.subst("$BUILD_DIR"), "bench.json")
+        with open(output, "w") as f:
+            json.dump(results, f, indent=2, sort_keys=True)
+        print("Results written to %s" % output)
+
+        baseline_path = os.path.join(env.subst("$PROJECT_DIR"), "bench", "baseline.json")
+        baseline, problem = _load_baseline(baseline_path)
+        regressions = _compare(results, baseline)
+
+        if update_baseline:
+            shutil.copyfile(output, baseline_path)
+            print("Baseline updated: %s" % baseline_path)
+        elif problem:
+            # Without a measured baseline nothing was checked, so do not report success.
+            sys.stderr.write("%s; record one with: pio run -e bench -t bench_baseline\n" % problem)
+            env.Exit(1)
+        elif regressions:
+            env.Exit(1)
+    return action
+
+
+env.AddCustomTarget("bench", "$BUILD_DIR/${PROGNAME}.elf", _bench(False),
+                    title="AVR benchmark", description="Run cycle benchmarks under simavr")
+env.AddCustomTarget("bench_baseline", "$BUILD_DIR/${PROGNAME}.elf", _bench(True),
+                    title="AVR benchmark baseline", description="Run benchmarks and store bench/baseline.json")
@@ -0,0 +1,55 @@
+# PlatformIO post-build script: SRAM / heap usage report for the AVR firmware.
+#
+# Prints static SRAM usage (.data + .bss), the stack headroom left on the
+# ATmega2560, and whether any dynamic allocation routine was linked into the
+# firmware. With no malloc/new in the ELF, no heap allocation can happen
+# after setup() (or at all).
+
+Import("env")
+
+import subprocess
+
+SRAM_SIZE = 8192
+HEAP_SYMBOLS = ("malloc", "calloc", "realloc", "free", "_Znwj", "_Znaj", "_ZdlPv", "_ZdaPv")
+
+
+def _tool(name):
+    cc = env.subst("$CC")
+    return cc[:-3] + name if cc.endswith("gcc") else name
+
+
+def _section_sizes(elf):
+    output = subprocess.check_output([_tool("size"), "-A", elf], universal_newlines=True)
+    sizes = {}
+    for line in output.splitlines():
+        parts = line.split()
+        if len(parts) >= 2 and parts[0].startswith(".") and parts[1].isdigit():
+            sizes[parts[0]] = int(parts[1])
+    return sizes
+
+
+def _linked_symbols(elf):
+    output = subprocess.check_output([_tool("nm"), "--defined-only", elf], universal_newlines=True)
+    return {line.split()[-1] for line in output.splitlines() if line.strip()}
+
+
+def memory_report(source, target, env):
+    elf = str(target[0])
+    sizes = _section_sizes(elf)
+    static_sram = sizes.get(".data", 0) + sizes.get(".bss", 0)
+    heap_symbols = sorted(s for s in HEAP_SYMBOLS if s in _linked_symbols(elf))
+
+    print("")
+    print("===== SRAM / heap report =====")
+    print("  .data        : %5d bytes" % sizes.get(".data", 0))
+    print("  .bss         : %5d bytes" % sizes.get(".bss", 0))
+    print("  static SRAM  : %5d / %d bytes (%.1f%%)" % (static_sram, SRAM_SIZE, 100.0 * static_sram / SRAM_SIZE))
+    print("  stack + heap : %5d bytes free" % (SRAM_SIZE - static_sram))
+    if heap_symbols:
+        print("  heap         : IN USE (linked: %s)" % ", ".join(heap_symbols))
+    else:
+        print("  heap         : none (no allocator linked, zero heap allocations)")
+    print("==============================")
+
+
+env.AddPostAction("$BUILD_DIR/${PROGNAME}.elf", memory_report)
@@ -0,0 +1,116 @@
+#include "PlantModel.h"
+#include <NativeHAL.h>
+#include <ServoMT.h>
+#include <StockSensor.h>
+#include <FloatSW.h>
+#include "Channels.h"
+
+PlantModel::PlantModel(const PlantConfig& config)
+    : config(config), cupGateOpen(false), refillCount(0), dryPumpUs(0) {
+    for (uint8_t i = 0; i < CHANNEL_COUNT; i++) {
+        levels[i] = 0.0f;
+        dispensed[i] = 0.0f;
+        emptySinceMs[i] = 0;
+        isEmpty[i] = false;
+    }
+}
+
+void PlantModel::begin() {
+    for (uint8_t i = 0; i < CHANNEL_COUNT; i++) {
+        levels[i] = (CHANNELS[i].sensor == SENSOR_FLOAT) ? config.tankCapacity : config.hopperCapacity;
+        dispensed[i] = 0.0f;
+        isEmpty[i] = false;
+    }
+    cupGateOpen = false;
+    refillCount = 0;
+    dryPumpUs = 0;
+    updateSensorPins();
+}
+
+void PlantModel::step(uint32_t elapsedUs) {
+    const float seconds = elapsedUs / 1000000.0f;
+    const uint32_t now = millis();
+
+    for (uint8_t slot = 0; slot < CHANNEL_COUNT; slot++) {
+        const ChannelConfig& channel = CHANNELS[slot];
+
+        if (channel.type == COMMAND_CUP) {
+            // 컵 게이트가 열림 각도 근처에 도달할 때마다 컵 하나가 떨어집니다.
+            bool open = gateOpening(slot) > 0.9f;
+            if (open && !cupGateOpen) {
+                dispensed[slot] += 1.0f;
+            }
+            cupGateOpen = open;
+            continue;
+        }
+
+        float flow;
+        if (channel.actuator == ACTUATOR_PUMP) {
+            flow = config.pumpRate * NativeHAL::getPwmDuty(channel.actuatorPin) / 255.0f;
+            if (flow > 0 && levels[slot] <= 0) {
+                dryPumpUs += elapsedUs;
+            }
+        } else {
+            flow = config.servoRate[slot] * gateOpening(slot);
+        }
+
+        float amount = flow * seconds;
+        if (amount > levels[slot]) {
+            amount = levels[slot];
+        }
+        levels[slot] -= amount;
+        dispensed[slot] += amount;
+
+        // 재고가 떨어지면 refillDelayMs 뒤에 작업자가 가득 채웁니다.
+        float lowLevel = (channel.sensor == SENSOR_FLOAT) ? config.tankLowLevel : config.hopperLowLevel;
+        if (!isEmpty[slot] && levels[slot] < lowLevel) {
+            isEmpty[slot] = true;
+            emptySinceMs[slot] = now;
+        } else if (isEmpty[slot] && config.refillDelayMs > 0 && now - emptySinceMs[slot] >= config.refillDelayMs) {
+            levels[slot] = (channel.sensor == SENSOR_FLOAT) ? config.tankCapacity : config.hopperCapacity;
+            isEmpty[slot] = false;
+            refillCount++;
+        }
+    }
+
+    updateSensorPins();
+}
+
+float PlantModel::gateOpening(uint8_t slot) const {
+    const ChannelConfig& channel = CHANNELS[slot];
+    int pulse = NativeHAL::getServoPulse(channel.actuatorPin);
+    if (pulse == 0 || channel.openAngle == channel.closedAngle) {
+        return 0.0f;
+    }
+
+    float angle = (pulse - SERVO_PULSE_MIN_US) * (float)SERVO_ANGLE_MAX / (SERVO_PULSE_MAX_US - SERVO_PULSE_MIN_US);
+    float opening = (angle - channel.closedAngle) / (float)(channel.openAngle - channel.closedAngle);
+    return opening < 0.0f ? 0.0f : (opening > 1.0f ? 1.0f : opening);
+}
+
+void PlantModel::updateSensorPins() {
+    for (uint8_t slot = 0; slot < CHANNEL_COUNT; slot++) {
+        const ChannelConfig& channel = CHANNELS[slot];
+        if (channel.sensor == SENSOR_STOCK) {
+            NativeHAL::setInputLevel(channel.sensorPin, isEmpty[slot] ? STOCK_STATE_EMPTY : STOCK_STATE_FULL);
+        } else if (channel.sensor == SENSOR_FLOAT) {
+            NativeHAL::setInputLevel(channel.sensorPin, isEmpty[slot] ? FLOAT_STATE_EMPTY : FLOAT_STATE_FULL);
+        }
+    }
+}
+
+float PlantModel::getDispensed(uint8_t slot) const {
+    return slot < CHANNEL_COUNT ? dispensed[slot] : 0.0f;
+}
+
+float PlantModel::getLevel(uint8_t slot) const {
+    return slot < CHANNEL_COUNT ? levels[slot] : 0.0f;
+}
+
+uint16_t PlantModel::getRefillCount() const {
+    return refillCount;
+}
+
+uint32_t PlantModel::getDryPumpMs() const {
+    return dryPumpUs / 1000;
+}
@@ -0,0 +1,88 @@
+#ifndef PLANTMODEL_H
+#define PLANTMODEL_H
+
+#include <Arduino.h>
+#include <SerialCommand.h>
+
+/**
+ * @brief 기계 물리 모델 설정 (초당 분배량, 용량, 보충)
+ */
+struct PlantConfig {
+    float servoRate[CHANNEL_COUNT];   // 서보 채널이 완전히 열렸을 때 초당 분배량 (g/s, 컵 채널은 사용 안 함)
+    float pumpRate;                   // 물 펌프 최대 듀티일 때 초당 분배량 (ml/s)
+    float hopperCapacity;             // 재료 호퍼 용량 (g)
+    float hopperLowLevel;             // 이 양 아래로 내려가면 재고 센서가 "없음" (g)
+    float tankCapacity;               // 물 탱크 용량 (ml)
+    float tankLowLevel;               // 이 양 아래로 내려가면 플로트 스위치가 내려감 (ml)
+    uint32_t refillDelayMs;           // 재고가 떨어진 뒤 작업자가 보충하기까지의 시간 (0: 보충 안 함)
+};
+
+/**
+ * @brief 분배기 물리 모델 (호스트 시뮬레이터 전용)
+ *
+ * NativeHAL 의 서보 펄스/펌프 듀티 출력을 읽어 호퍼와 물 탱크의 양을 줄이고,
+ * 그 양에 따라 재고 센서/플로트 스위치 입력 핀 레벨을 바꿉니다.
+ * 펌웨어 코드는 그대로 실행되며, 이 모델은 핀을 통해서만 펌웨어와 주고받습니다.
+ */
+class PlantModel {
+public:
+    /**
+     * @brief 생성자
+     * @param config 물리 모델 설정
+     */
+    explicit PlantModel(const PlantConfig& config);
+
+    /**
+     * @brief 호퍼/탱크를 가득 채우고 센서 입력 핀 설정 (setup() 전에 호출)
+     */
+    void begin();
+
+    /**
+     * @brief 가상 시간 진행에 맞춰 분배량 적분 및 센서 입력 갱신
+     * @param elapsedUs 지난 호출 이후 진행한 가상 시간 (마이크로초)
+     */
+    void step(uint32_t elapsedUs);
+
+    // ===== 관찰 메서드 =====
+    /**
+     * @brief 채널별 누적 분배량 (g, ml, 컵 채널은 컵 수)
+     */
+    float getDispensed(uint8_t slot) const;
+
+    /**
+     * @brief 채널별 남은 양 (g, ml, 컵 채널은 사용 안 함)
+     */
+    float getLevel(uint8_t slot) const;
+
+    /**
+     * @brief 재고가 떨어진 횟수 (보충 횟수)
+     */
+    uint16_t getRefillCount() const;
+
+    /**
+     * @brief 탱크가 빈 상태로 펌프가 돈 시간 (밀리초)
+     */
+    uint32_t getDryPumpMs() const;
+
+private:
+    /**
+     * @brief 서보 펄스 폭으로 게이트 열림 정도 계산 (0: 닫힘, 1: 열림 각도)
+     */
+    float gateOpening(uint8_t slot) const;
+
+    /**
+     * @brief 남은 양에 맞춰 센서 입력 핀 레벨 설정
+     */
+    void updateSensorPins();
+
+    PlantConfig config;
+    float levels[CHANNEL_COUNT];          // 남은 양
+    float dispensed[CHANNEL_COUNT];       // 누적 분배량
+    bool cupGateOpen;                     // 컵 게이트가 열려 있는지 (열릴 때마다 컵 하나)
+    uint32_t emptySinceMs[CHANNEL_COUNT]; // 재고가 떨어진 시각 (보충 대기)
+    bool isEmpty[CHANNEL_COUNT];          // 재고 없음 상태
+    uint16_t refillCount;
+    uint32_t dryPumpUs;
+};
+
+#endif // PLANTMODEL_H
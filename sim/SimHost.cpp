@@ -0,0 +1,183 @@
+#include "SimHost.h"
+#include <NativeHAL.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+SimHost::SimHost(const HostConfig& config)
+    : config(config), rxLineFreeUs(0), nextArrivalUs(0), randomState(config.seed ? config.seed : 1),
+      nextSequence(1), inFlight(0), completed(0), rejected(0), failed(0), txBytes(0), rxBytes(0) {
+}
+
+void SimHost::begin() {
+    NativeHAL::setSerialSink(onSerialByte, this);
+    nextArrivalUs = NativeHAL::nowMicros();
+}
+
+void SimHost::update() {
+    const uint64_t now = NativeHAL::nowMicros();
+    const bool canAddOrder = config.maxOrders == 0 || orders.size() < config.maxOrders;
+
+    // ===== 주문 도착 =====
+    if (config.ordersPerHour <= 0) {
+        // 포화 상태: 전송 창에 빈자리가 생기는 즉시 다음 주문이 도착합니다.
+        if (waiting.empty() && retries.empty() && inFlight < config.window && canAddOrder) {
+            orders.push_back({ 0, now, 0, 0, 0 });
+            waiting.push_back(orders.size() - 1);
+        }
+    } else {
+        while (now >= nextArrivalUs && (config.maxOrders == 0 || orders.size() < config.maxOrders)) {
+            orders.push_back({ 0, nextArrivalUs, 0, 0, 0 });
+            waiting.push_back(orders.size() - 1);
+            scheduleNextArrival();
+        }
+    }
+
+    // 거부/실패한 주문은 잠시 뒤 대기열 맨 앞으로 돌아옵니다.
+    for (size_t i = 0; i < retries.size();) {
+        if (now >= retries[i].first) {
+            waiting.push_front(retries[i].second);
+            retries.erase(retries.begin() + i);
+        } else {
+            i++;
+        }
+    }
+
+    // ===== 응답 수신 (선로 도착 시각이 지난 바이트만) =====
+    while (!rxLine.empty() && rxLine.front().first <= now) {
+        char c = (char)rxLine.front().second;
+        rxLine.pop_front();
+        if (c == '\n') {
+            handleLine(rxText);
+            rxText.clear();
+        } else if (c != '\r') {
+            rxText += c;
+        }
+    }
+
+    // ===== 주문 전송 =====
+    while (inFlight < config.window && !waiting.empty()) {
+        OrderRecord& order = orders[waiting.front()];
+        waiting.pop_front();
+
+        if (nextSequence == 0) {
+            nextSequence = 1;  // 0 은 순서 번호 없음
+        }
+        order.sequence = nextSequence++;
+        order.sentUs = now;
+        order.attempts++;
+        inFlight++;
+
+        char line[96];
+        int length = snprintf(line, sizeof(line), "%u:%s\n", order.sequence, config.orderText.c_str());
+        NativeHAL::feedSerial(line, (size_t)length);
+        txBytes += (uint64_t)length;
+        if (config.trace) {
+            fprintf(stderr, "[%12.3f ms] >> %s", now / 1000.0, line);
+        }
+    }
+}
+
+bool SimHost::isFinished() const {
+    return config.maxOrders > 0 && completed >= config.maxOrders;
+}
+
+const std::vector<OrderRecord>& SimHost::getOrders() const {
+    return orders;
+}
+
+uint32_t SimHost::getCompletedCount() const {
+    return completed;
+}
+
+uint32_t SimHost::getRejectedCount() const {
+    return rejected;
+}
+
+uint32_t SimHost::getFailedCount() const {
+    return failed;
+}
+
+uint64_t SimHost::getTxBytes() const {
+    return txBytes;
+}
+
+uint64_t SimHost::getRxBytes() const {
+    return rxBytes;
+}
+
+void SimHost::onSerialByte(uint8_t c, void* context) {
+    // 장치가 쓴 바이트는 선로가 빈 뒤 한 바이트 시간이 지나야 호스트에 도착합니다.
+    SimHost* host = static_cast<SimHost*>(context);
+    uint64_t now = NativeHAL::nowMicros();
+    uint64_t start = host->rxLineFreeUs > now ? host->rxLineFreeUs : now;
+    host->rxLineFreeUs = start + host->byteTimeMicros();
+    host->rxLine.push_back(std::make_pair(host->rxLineFreeUs, c));
+    host->rxBytes++;
+}
+
+void SimHost::handleLine(const std::string& line) {
+    const uint64_t now = NativeHAL::nowMicros();
+    if (config.trace) {
+        fprintf(stderr, "[%12.3f ms] << %s\n", now / 1000.0, line.c_str());
+    }
+
+    // 순서 번호 응답만 해석합니다: DONE,n,... / FAIL,n,e / NAK,n,e
+    bool isDone = line.compare(0, 5, "DONE,") == 0;
+    bool isFail = line.compare(0, 5, "FAIL,") == 0;
+    bool isNak = line.compare(0, 4, "NAK,") == 0;
+    if (!isDone && !isFail && !isNak) {
+        return;
+    }
+
+    uint16_t sequence = (uint16_t)strtoul(line.c_str() + (isNak ? 4 : 5), nullptr, 10);
+    OrderRecord* order = findBySequence(sequence);
+    if (order == nullptr) {
+        return;
+    }
+    order->sequence = 0;
+    if (inFlight > 0) {
+        inFlight--;
+    }
+
+    if (isDone) {
+        order->doneUs = now;
+        completed++;
+        return;
+    }
+
+    // 재고 부족(FAIL)이나 대기열 가득 참(NAK)은 잠시 뒤 같은 주문을 다시 보냅니다.
+    if (isFail) {
+        failed++;
+    } else {
+        rejected++;
+    }
+    retries.push_back(std::make_pair(now + config.retryDelayMs * 1000ULL, (size_t)(order - orders.data())));
+}
+
+void SimHost::scheduleNextArrival() {
+    // 포아송 도착: 지수 분포 간격 (xorshift32 난수)
+    randomState ^= randomState << 13;
+    randomState ^= randomState >> 17;
+    randomState ^= randomState << 5;
+    double uniform = (randomState + 1.0) / 4294967297.0;
+    double meanUs = 3600.0e6 / config.ordersPerHour;
+    nextArrivalUs += (uint64_t)(-log(uniform) * meanUs);
+}
+
+OrderRecord* SimHost::findBySequence(uint16_t sequence) {
+    if (sequence == 0) {
+        return nullptr;
+    }
+    for (size_t i = orders.size(); i > 0; i--) {
+        if (orders[i - 1].sequence == sequence) {
+            return &orders[i - 1];
+        }
+    }
+    return nullptr;
+}
+
+uint64_t SimHost::byteTimeMicros() const {
+    // 8N1 프레임: 시작 비트 + 8 데이터 비트 + 정지 비트
+    return 10000000ULL / Serial.getBaudRate();
+}
@@ -0,0 +1,95 @@
+#ifndef SIMHOST_H
+#define SIMHOST_H
+
+#include <Arduino.h>
+#include <deque>
+#include <string>
+#include <vector>
+
+/**
+ * @brief 스크립트 호스트 설정 (주문 방식, 통신 방식)
+ */
+struct HostConfig {
+    std::string orderText;      // 주문 한 건의 명령 (예: "R1", "U1.5;C2+S1+W8;D3")
+    uint8_t window;             // 동시에 보낼 수 있는 주문 수 (1: 완료를 기다린 뒤 다음 주문)
+    float ordersPerHour;        // 주문 도착률 (0: 항상 주문이 대기 중)
+    uint32_t maxOrders;         // 최대 주문 수 (0: 제한 없음)
+    uint32_t retryDelayMs;      // 거부/실패한 주문을 다시 보낼 때까지의 시간
+    uint32_t seed;              // 주문 도착 난수 시드
+    bool trace;                 // 시리얼 송수신 내용을 표준 에러로 출력
+};
+
+/**
+ * @brief 주문 한 건의 기록
+ */
+struct OrderRecord {
+    uint16_t sequence;          // 보낸 순서 번호 (0: 아직 보내지 않음)
+    uint64_t arrivalUs;         // 주문이 들어온 시각
+    uint64_t sentUs;            // 마지막으로 보낸 시각
+    uint64_t doneUs;            // 완료 응답을 받은 시각 (0: 미완료)
+    uint16_t attempts;          // 보낸 횟수
+};
+
+/**
+ * @brief 가상 시리얼 선 위의 스크립트 호스트 (호스트 시뮬레이터 전용)
+ *
+ * 주문을 순서 번호를 붙여 보내고 ACK/NAK/DONE/FAIL 응답으로 주문 상태를 추적합니다.
+ * 장치 → 호스트 방향도 통신 속도에 맞춘 바이트 간격으로 도착시켜, 응답 지연이 실제 선로와 같게 합니다.
+ */
+class SimHost {
+public:
+    /**
+     * @brief 생성자
+     * @param config 호스트 설정
+     */
+    explicit SimHost(const HostConfig& config);
+
+    /**
+     * @brief 시리얼 송신 처리 함수 연결 (setup() 전에 호출)
+     */
+    void begin();
+
+    /**
+     * @brief 주문 도착, 응답 수신, 주문 전송 처리 (loop() 마다 호출)
+     */
+    void update();
+
+    /**
+     * @brief 모든 주문을 마쳤는지 확인 (maxOrders 가 있을 때)
+     */
+    bool isFinished() const;
+
+    // ===== 결과 =====
+    const std::vector<OrderRecord>& getOrders() const;
+    uint32_t getCompletedCount() const;
+    uint32_t getRejectedCount() const;   // NAK (대기열 가득 참 등)
+    uint32_t getFailedCount() const;     // FAIL (재고 부족 등, 다시 보냄)
+    uint64_t getTxBytes() const;
+    uint64_t getRxBytes() const;
+
+private:
+    static void onSerialByte(uint8_t c, void* context);
+    void handleLine(const std::string& line);
+    void scheduleNextArrival();
+    OrderRecord* findBySequence(uint16_t sequence);
+    uint64_t byteTimeMicros() const;
+
+    HostConfig config;
+    std::vector<OrderRecord> orders;          // 들어온 모든 주문
+    std::deque<size_t> waiting;               // 보낼 차례를 기다리는 주문 (orders 인덱스)
+    std::deque<std::pair<uint64_t, uint8_t>> rxLine;  // 장치가 보낸 바이트 (호스트 도착 시각, 값)
+    uint64_t rxLineFreeUs;                    // 장치 → 호스트 선로가 비는 시각
+    std::string rxText;                       // 수신 중인 줄
+    uint64_t nextArrivalUs;                   // 다음 주문 도착 시각
+    uint32_t randomState;                     // 주문 도착 난수 상태
+    uint16_t nextSequence;
+    uint8_t inFlight;                         // 보냈지만 결과를 받지 못한 주문 수
+    uint32_t completed;
+    uint32_t rejected;
+    uint32_t failed;
+    uint64_t txBytes;
+    uint64_t rxBytes;
+    std::vector<std::pair<uint64_t, size_t>> retries;  // 다시 보낼 시각, 주문 인덱스
+};
+
+#endif // SIMHOST_H
@@ -0,0 +1,216 @@
+/**
+ * @brief 기계 시뮬레이터 진입점 (env:sim)
+ *
+ * 펌웨어의 setup()/loop() 를 그대로 가상 시간으로 실행하면서, PlantModel 이 서보/펌프 출력으로
+ * 호퍼와 물 탱크를 움직이고 SimHost 가 시리얼 선으로 주문을 넣습니다.
+ * 기본 걸음(200us)으로 실제 시간보다 약 600 배, --tick-us 1000 으로 약 2500 배 빠르게 돌아가므로
+ * 스케줄링/프로토콜 방식별 시간당 음료 수와 주문 지연 백분위를 장비에 올리기 전에 비교할 수 있습니다.
+ * (loop() 1회 비용이 여러 작업에 고르게 퍼져 있어, 속도는 걸음 크기로 정해집니다.)
+ *
+ * 실행 예)
+ *   .pio/build/sim/program --hours 1 --window 1               (완료를 기다린 뒤 다음 주문)
+ *   .pio/build/sim/program --hours 1 --window 4               (순서 번호로 4건까지 미리 전송)
+ *   .pio/build/sim/program --order "U1.5;C2+S1+W8;D3" --rate 120 --json
+ */
+#include <Arduino.h>
+#include <NativeHAL.h>
+#include <SerialCommand.h>
+#include "Channels.h"
+#include "PlantModel.h"
+#include "SimHost.h"
+
+#include <algorithm>
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+
+void setup();
+void loop();
+
+namespace {
+
+    struct SimOptions {
+        double hours;               // 시뮬레이션할 가상 시간
+        unsigned long tickUs;       // loop() 1회당 진행할 가상 시간
+        bool json;                  // 결과를 JSON 한 줄로 출력
+    };
+
+    void printUsage(const char* program) {
+        fprintf(stderr,
+                "usage: %s [options]\n"
+                "  --hours H        virtual run time in hours (default 1)\n"
+                "  --orders N       stop after N completed orders (default: run for --hours)\n"
+                "  --order TEXT     command line sent per order (default R1)\n"
+                "  --window N       orders in flight at once, 1 = stop-and-wait (default 1)\n"
+                "  --rate R         Poisson order arrivals per hour, 0 = always busy (default 0)\n"
+                "  --retry-ms MS    delay before resending a NAK/FAIL order (default 1000)\n"
+                "  --hopper G       ingredient hopper capacity in grams (default 1000)\n"
+                "  --refill-s S     operator refill delay after a hopper runs low (default 120, 0 = never)\n"
+                "  --tick-us US     virtual time per loop() iteration (default 200)\n"
+                "  --seed N         arrival random seed (default 1)\n"
+                "  --trace          print serial traffic to stderr\n"
+                "  --json           print one JSON result line\n",
+                program);
+    }
+
+    double percentile(std::vector<double>& values, double p) {
+        if (values.empty()) {
+            return 0.0;
+        }
+        size_t index = (size_t)(p / 100.0 * (values.size() - 1) + 0.5);
+        return values[index];
+    }
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    SimOptions options = { 1.0, 200, false };
+    HostConfig host = { "R1", 1, 0.0f, 0, 1000, 1, false };
+    PlantConfig plant;
+    // 채널별 완전히 열렸을 때 초당 분배량 (CHANNELS 순서: 설탕, 물, 커피, 아이스티, 녹차, 컵)
+    const float servoRates[CHANNEL_COUNT] = { 5.0f, 0.0f, 4.0f, 6.0f, 3.0f, 0.0f };
+    memcpy(plant.servoRate, servoRates, sizeof(servoRates));
+    plant.pumpRate = 25.0f;
+    plant.hopperCapacity = 1000.0f;
+    plant.hopperLowLevel = 50.0f;
+    plant.tankCapacity = 20000.0f;
+    plant.tankLowLevel = 300.0f;
+    plant.refillDelayMs = 120000;
+
+    for (int i = 1; i < argc; i++) {
+        const char* arg = argv[i];
+        const char* value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+        bool hasValue = true;
+        if (strcmp(arg, "--hours") == 0 && value) {
+            options.hours = atof(value);
+        } else if (strcmp(arg, "--orders") == 0 && value) {
+            host.maxOrders = (uint32_t)strtoul(value, nullptr, 10);
+        } else if (strcmp(arg, "--order") == 0 && value) {
+            host.orderText = value;
+        } else if (strcmp(arg, "--window") == 0 && value) {
+            host.window = (uint8_t)std::max(1, atoi(value));
+        } else if (strcmp(arg, "--rate") == 0 && value) {
+            host.ordersPerHour = (float)atof(value);
+        } else if (strcmp(arg, "--retry-ms") == 0 && value) {
+            host.retryDelayMs = (uint32_t)strtoul(value, nullptr, 10);
+        } else if (strcmp(arg, "--hopper") == 0 && value) {
+            plant.hopperCapacity = (float)atof(value);
+        } else if (strcmp(arg, "--refill-s") == 0 && value) {
+            plant.refillDelayMs = (uint32_t)(atof(value) * 1000.0);
+        } else if (strcmp(arg, "--tick-us") == 0 && value) {
+            options.tickUs = std::max(1UL, strtoul(value, nullptr, 10));
+        } else if (strcmp(arg, "--seed") == 0 && value) {
+            host.seed = (uint32_t)strtoul(value, nullptr, 10);
+        } else {
+            hasValue = false;
+            if (strcmp(arg, "--trace") == 0) {
+                host.trace = true;
+            } else if (strcmp(arg, "--json") == 0) {
+                options.json = true;
+            } else {
+                printUsage(argv[0]);
+                return 2;
+            }
+        }
+        if (hasValue) {
+            i++;
+        }
+    }
+
+    // ===== 실행 =====
+    NativeHAL::reset();
+    PlantModel plantModel(plant);
+    SimHost simHost(host);
+    plantModel.begin();
+    simHost.begin();
+
+    auto wallStart = std::chrono::steady_clock::now();
+    setup();
+
+    const uint64_t startUs = NativeHAL::nowMicros();
+    const uint64_t endUs = startUs + (uint64_t)(options.hours * 3600.0e6);
+    // 주문 결과가 나올 때마다 그 사이 분배량을 완료/중단 주문으로 나눕니다.
+    // (중단된 레시피가 이미 떨어뜨린 컵과 재료는 주문당 분배량에 넣지 않습니다.)
+    float settled[CHANNEL_COUNT] = {};
+    float completedAmount[CHANNEL_COUNT] = {};
+    float abortedAmount[CHANNEL_COUNT] = {};
+    uint32_t lastCompleted = 0;
+    uint32_t lastFailed = 0;
+
+    while (NativeHAL::nowMicros() < endUs && !simHost.isFinished()) {
+        simHost.update();
+        if (simHost.getCompletedCount() != lastCompleted || simHost.getFailedCount() != lastFailed) {
+            bool aborted = simHost.getCompletedCount() == lastCompleted;
+            for (uint8_t slot = 0; slot < CHANNEL_COUNT; slot++) {
+                float amount = plantModel.getDispensed(slot) - settled[slot];
+                (aborted ? abortedAmount : completedAmount)[slot] += amount;
+                settled[slot] += amount;
+            }
+            lastCompleted = simHost.getCompletedCount();
+            lastFailed = simHost.getFailedCount();
+        }
+        loop();
+        NativeHAL::advanceMicros(options.tickUs);
+        plantModel.step(options.tickUs);
+    }
+
+    double wallSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - wallStart).count();
+    double virtualSeconds = (NativeHAL::nowMicros() - startUs) / 1.0e6;
+
+    // ===== 결과 =====
+    std::vector<double> latencies;   // 주문 도착 → 완료 (초)
+    std::vector<double> services;    // 마지막 전송 → 완료 (초)
+    for (const OrderRecord& order : simHost.getOrders()) {
+        if (order.doneUs != 0) {
+            latencies.push_back((order.doneUs - order.arrivalUs) / 1.0e6);
+            services.push_back((order.doneUs - order.sentUs) / 1.0e6);
+        }
+    }
+    std::sort(latencies.begin(), latencies.end());
+    std::sort(services.begin(), services.end());
+
+    uint32_t completed = simHost.getCompletedCount();
+    double drinksPerHour = virtualSeconds > 0 ? completed * 3600.0 / virtualSeconds : 0.0;
+    double speedup = wallSeconds > 0 ? virtualSeconds / wallSeconds : 0.0;
+
+    if (options.json) {
+        printf("{\"order\":\"%s\",\"window\":%u,\"rate\":%.1f,\"virtual_s\":%.1f,\"completed\":%u,"
+               "\"nak\":%u,\"fail\":%u,\"drinks_per_hour\":%.2f,"
+               "\"latency_s\":{\"p50\":%.3f,\"p90\":%.3f,\"p99\":%.3f,\"max\":%.3f},"
+               "\"service_s\":{\"p50\":%.3f,\"p99\":%.3f},"
+               "\"refills\":%u,\"tx_bytes\":%llu,\"rx_bytes\":%llu,\"speedup\":%.0f}\n",
+               host.orderText.c_str(), host.window, host.ordersPerHour, virtualSeconds, completed,
+               simHost.getRejectedCount(), simHost.getFailedCount(), drinksPerHour,
+               percentile(latencies, 50), percentile(latencies, 90), percentile(latencies, 99),
+               latencies.empty() ? 0.0 : latencies.back(),
+               percentile(services, 50), percentile(services, 99),
+               plantModel.getRefillCount(), (unsigned long long)simHost.getTxBytes(),
+               (unsigned long long)simHost.getRxBytes(), speedup);
+        return 0;
+    }
+
+    printf("order            : %s\n", host.orderText.c_str());
+    printf("window           : %u%s\n", host.window, host.window == 1 ? " (stop-and-wait)" : " (pipelined)");
+    printf("arrivals         : %s\n", host.ordersPerHour > 0 ? "poisson" : "saturated");
+    if (host.ordersPerHour > 0) {
+        printf("arrival rate     : %.1f /h\n", host.ordersPerHour);
+    }
+    printf("virtual time     : %.1f s (wall %.2f s, %.0fx real time)\n", virtualSeconds, wallSeconds, speedup);
+    printf("completed orders : %u (NAK %u, FAIL %u)\n", completed, simHost.getRejectedCount(), simHost.getFailedCount());
+    printf("drinks per hour  : %.2f\n", drinksPerHour);
+    printf("latency (s)      : p50 %.3f  p90 %.3f  p99 %.3f  max %.3f\n",
+           percentile(latencies, 50), percentile(latencies, 90), percentile(latencies, 99),
+           latencies.empty() ? 0.0 : latencies.back());
+    printf("service (s)      : p50 %.3f  p99 %.3f\n", percentile(services, 50), percentile(services, 99));
+    printf("serial bytes     : tx %llu, rx %llu\n",
+           (unsigned long long)simHost.getTxBytes(), (unsigned long long)simHost.getRxBytes());
+    printf("refills          : %u, dry pump %u ms\n", plantModel.getRefillCount(), plantModel.getDryPumpMs());
+    for (uint8_t slot = 0; slot < CHANNEL_COUNT; slot++) {
+        printf("  %-9s dispensed %9.1f %-3s  per order %7.2f  aborted %7.1f\n", CHANNELS[slot].name,
+               plantModel.getDispensed(slot), CHANNELS[slot].unit,
+               completed ? completedAmount[slot] / completed : 0.0, abortedAmount[slot]);
+    }
+    return 0;
+}
@@ -4,258 +4,1044 @@
 #include <StockSensor.h>
 #include <PumpMT.h>
 #include <SerialCommand.h>
+#include <CommandQueue.h>
+#include <RecipeRunner.h>
+#include <BatchRunner.h>
+#include <SensorMonitor.h>
+#include <SensorBank.h>
+#include <DoseTimer.h>
+#include <TimingStats.h>
+#include <Calibration.h>
+#include <DispenseJournal.h>
+#include <TimerWheel.h>
+#include <TaskScheduler.h>
 #include <ArduinoJson.h>
 #include "Pin.h" // Pin.h에 정의된 #define 상수를 사용합니다.
+#include "Channels.h" // 분배 채널 설정 테이블 (핀, 각도, 최대 시간)
+#include "EepromLayout.h" // EEPROM 영역 배치
+#include "Recipes.h" // 레시피 테이블 (main.cpp 수정 없이 레시피 변경)
 
-// ===== 하드웨어 객체 배열 (크기 5: 4개 재료 + 1개 컵) =====
-ServoMT *servoMotors[5]; 
-FloatSW *floatSwitches[1]; 
-StockSensor *stockSensors[4];
-PumpMT *pumps[2]; // pumps[0]: 물 펌프, pumps[1]: DC 모터 릴레이
-SerialCommand *serialCommand;
+// ===== 하드웨어 객체 (정적 할당, 하드웨어 초기화는 setup()의 begin()에서 수행) =====
+SensorBank sensorBank;  // 조도 센서/플로트 스위치 핀 일괄 샘플링 및 디바운스
 
-// ===== 타이밍 및 통신 변수 =====
+// ===== 채널 하드웨어 객체 =====
+// 채널의 서보/펌프/재고 센서/플로트 스위치는 종류별 배열에 두고, setup() 에서 CHANNELS 테이블 순서대로
+// 핀과 이름을 설정합니다. 채널을 추가하거나 핀을 바꿀 때는 Channels.h 만 고치면 됩니다.
+ServoMT servoMotors[SERVO_CHANNEL_COUNT];        // ACTUATOR_SERVO 채널 (설탕, 커피, 아이스티, 녹차, 컵)
+PumpMT pumps[PUMP_CHANNEL_COUNT];                // ACTUATOR_PUMP 채널 (물)
+StockSensor stockSensors[STOCK_CHANNEL_COUNT];   // SENSOR_STOCK 채널
+FloatSW floatSwitches[FLOAT_CHANNEL_COUNT];      // SENSOR_FLOAT 채널
+PumpMT vibrationMotor(PIN_DC_MOTOR, "VibrationMotor");  // DC 모터(진동) 릴레이 (채널 아님)
 
-uint64_t lastSensorReadingTime = 0;
-bool isCommandExecuting = false;
-uint64_t commandStartTime = 0;
-uint64_t commandDuration = 0;
-CommandType currentCommandType = COMMAND_NONE;
+// ===== 채널별 하드웨어 연결 =====
+// CHANNELS 테이블과 같은 순서로, 각 채널이 사용하는 액추에이터와 센서 객체를 가리킵니다 (setup() 에서 연결).
+struct ChannelHardware {
+    ServoMT* servo;             // ACTUATOR_SERVO
+    PumpMT* pump;               // ACTUATOR_PUMP
+    StockSensor* stock;         // SENSOR_STOCK
+    FloatSW* level;             // SENSOR_FLOAT
+};
+
+ChannelHardware channelHardware[CHANNEL_COUNT];  // 채널 인덱스로 조회
+
+SerialCommand serialCommand(CHANNELS, BAUD_RATE_SERIAL, EEPROM_LINK_ADDRESS, PIN_BUS_ENABLE);  // 시리얼 명령 핸들러 (BAUD_RATE_SERIAL 상수는 Pin.h에서 가져옴, 협상한 속도와 노드 주소는 EEPROM 에 저장)
+CommandQueue commandQueue;  // 수신 후 실행을 기다리는 명령 대기열
+RecipeRunner recipeRunner(RECIPES, RECIPE_COUNT);  // 레시피 타임라인 실행기
+BatchRunner batchRunner;  // 여러 단계 명령 줄 실행기 (대기열에는 COMMAND_BATCH 표시만 넣음)
+Calibration calibration(EEPROM_CALIBRATION_ADDRESS, CHANNEL_COUNT);  // 채널별 초당 분배량 (슬롯 = 채널 인덱스)
+DoseTimer doseTimer;  // 분배 채널 종료 시각을 하드웨어 타이머 인터럽트로 처리 (슬롯 = 채널 인덱스)
+DispenseJournal journal(EEPROM_JOURNAL_ADDRESS, EEPROM_JOURNAL_SIZE,
+                        EEPROM_COUNTERS_ADDRESS, EEPROM_COUNTERS_SIZE);  // 분배 기록 + 액추에이터 누적 사용량
+SensorMonitor sensorMonitor(TELEMETRY_CHANNEL_COUNT, 1);  // 센서 변경 감지 (비트 순서: TELEMETRY_ORDER, 디바운스는 sensorBank 가 담당)
+TelemetryMode reportedTelemetryMode = TELEMETRY_SNAPSHOT;  // 마지막 센서 전송 때의 텔레메트리 모드
+
+// ===== 소프트웨어 타이머 (밀리초 단위 주기/만기, loop() 에서 한 번에 확인) =====
+enum TimerSlot {
+    TIMER_SENSOR_BANK,      // 센서 뱅크 디바운스 샘플 (SENSOR_BANK_TICK_MS 주기)
+    TIMER_SENSOR_SAMPLE,    // 센서 변경 확인 (INTERVAL_SENSOR_SAMPLE 주기)
+    TIMER_HEARTBEAT,        // 전체 센서 상태 전송 (마지막 전송 후 INTERVAL_SENSOR_REPORT / INTERVAL_SENSOR_HEARTBEAT)
+    TIMER_ACTUATORS,        // 서보 동작 프로파일/펌프 램프 갱신 (INTERVAL_ACTUATOR_UPDATE 주기)
+    TIMER_STIR,             // DC 모터 교반 종료
+    TIMER_RECIPE            // 다음 레시피 단계 시작 시각
+};
+
+TimerWheel timerWheel;
+TaskScheduler scheduler;  // 협력형 태스크 (센서, 텔레메트리, 명령 수신, 채널별 분배, 대기열, 기록)
+
+// ===== 실행 시간 통계 (마이크로초, T 명령으로 조회 후 초기화) =====
+TimingStats loopStats;          // loop() 반복 주기
+TimingStats commandStats;       // processNewCommand() 실행 시간
+TimingStats telemetryStats;     // sendSensorData() 실행 시간
+TimingStats overshootStats;     // 분배 초과 시간 (실제 종료 시각 - 시작 시각 - 명령 시간)
+
+uint32_t lastLoopStartMicros = 0;   // 직전 loop() 시작 시각
+bool skipNextLoopSample = false;    // 통계 출력이 포함된 반복은 주기 통계에서 제외
+
+// ===== 분배 기록 덤프 (J 명령) =====
+// 송신 버퍼에 여유가 있을 때만 한 줄씩 보내 덤프 중에도 loop() 가 멈추지 않게 합니다.
+// 위치: 0 ~ 용량-1 = 기록 칸 (오래된 순), 이후 채널별 누적 사용량, 진동 릴레이, 완료 응답
+#define JOURNAL_DUMP_IDLE 0xFFFF
+uint16_t journalDumpPosition = JOURNAL_DUMP_IDLE;
+
+// ===== 실행 시간 통계 전송 (T 명령) =====
+// 분배 기록 덤프와 같이 송신 버퍼에 여유가 있을 때만 한 줄씩 보냅니다.
+// 위치: 실행 시간 통계 4줄, 태스크별 한 줄, 송신 대기열별 한 줄, 버스 통계, 끝
+#define STATS_REPORT_IDLE 0xFF
+#define STATS_REPORT_TIMING_LINES 4
+uint8_t statsReportPosition = STATS_REPORT_IDLE;
+
+// ===== 채널별 실행 상태 =====
+// 서로 다른 핀의 액추에이터는 동시에 동작할 수 있도록 명령 타입별로 실행 상태를 관리합니다.
+// 레시피와 여러 단계 명령은 완료 보고용으로 sequence, startMicros 만 사용합니다 (isExecuting 은 항상 false).
+struct ChannelState {
+    bool isExecuting;           // 실행 중 여부
+    uint32_t duration;          // 실행 시간 (밀리초)
+    uint32_t startMicros;       // 실행 시작 시각 (마이크로초, 초과 시간 측정용)
+    uint16_t sequence;          // 호스트가 붙인 순서 번호 (완료 보고용, SEQUENCE_NONE: 없음)
+};
+
+ChannelState channelStates[COMMAND_UNKNOWN];  // CommandType 으로 인덱싱
+uint8_t vibrationUsers = 0;                   // DC 모터(진동)를 사용 중인 채널 수
+volatile uint32_t channelStopMicros[CHANNEL_COUNT];  // 타이머 인터럽트가 채널을 닫은 시각
+float lastRunSeconds[CHANNEL_COUNT];          // 채널별 마지막 분배의 실제 작동 시간 (초, 보정 기준)
 
 // ===== 함수 프로토타입 =====
-void sendSensorData();
-void checkCommandCompletion(uint64_t currentTime);
-void completeCommandExecution();
-void resetCommandState();
+void updateSensors(uint16_t dueEvents);
+uint8_t readSensorBits();
+void sendSensorData(uint8_t reportBits, uint8_t changedBits);
+void updateActuators();
+void sensorTask(Task& task);
+void telemetryTask(Task& task);
+void serialRxTask(Task& task);
+void actuatorTask(Task& task);
+void channelTask(Task& task);
+void stirTask(Task& task);
+void dispatchTask(Task& task);
+void journalTask(Task& task);
+void serialTxTask(Task& task);
+void completeCommandExecution(CommandType commandType, uint32_t actualMicros);
+void resetCommandState(CommandType commandType);
+bool isAnyChannelExecuting();
+bool canStartCommand(CommandType commandType);
+void acquireVibration();
+bool releaseVibration();
 void processNewCommand();
+void updateStatsReport(const Task& task);
+void reportNodeStatus();
+void calibrateChannel(const Command& command);
+void updateJournalDump(const Task& task);
+void reportTimingStats(const char* name, TimingStats& stats);
+void startNextQueuedCommand();
+void updateRecipe(uint32_t currentTime);
+bool loadBatch(const Command& command);
+void startBatch(const Command& command);
+void updateBatch();
+bool startTimedStep(CommandType commandType, float duration);
 void executeCommand(const Command& command);
-void executeSugarCommand(const Command& command);
-void executeWaterCommand(const Command& command);
-void executeCoffeeCommand(const Command& command);
-void executeIcedTeaCommand(const Command& command);
-void executeGreenTeaCommand(const Command& command);
-void executeCupCommand(const Command& command); 
-void startCommandExecution(CommandType commandType, float duration);
+void executeChannelCommand(const Command& command);
+void executeRecipeCommand(const Command& command);
+void setChannelOpen(CommandType commandType, bool open);
+void cutoffChannelFromTimer(uint8_t slot);
+void startCommandExecution(CommandType commandType, float duration, uint16_t sequence);
+void startSequencedRun(CommandType commandType, uint16_t sequence);
+void finishSequencedRun(CommandType commandType, CommandError error);
+uint16_t microsToCentiseconds(uint32_t durationMicros);
 
 /**
  * @brief 시스템 초기화
  */
 void setup() {
-    // ===== 하드웨어 객체 생성 =====
-    // 서보 모터 및 재고 센서 (설탕, 커피, 아이스티, 녹차)
-    servoMotors[0] = new ServoMT(PIN_SUGAR_SERVO, "SugarDispenser");
-    stockSensors[0] = new StockSensor(PIN_SUGAR_LASER, PIN_SUGAR_SENSOR, "SugarStock");
+    // ===== 시리얼 통신 초기화 =====
+    serialCommand.begin();
+    delay(1000);
+
+    // ===== 저장된 보정값, 분배 기록, 누적 사용량 읽기 =====
+    calibration.begin();
+    journal.begin();
+
+    // ===== 하드웨어 초기화 =====
+    // 채널별 서보/펌프와 재고 센서/플로트 스위치 (CHANNELS 테이블 순서)
+    // 종류별 배열의 다음 객체를 채널에 연결하고 채널 설정의 핀과 이름으로 초기화합니다.
+    // 서보는 닫힘 각도에서 시작하여 부팅 중 게이트가 열리지 않게 합니다.
+    for (uint8_t i = 0; i < CHANNEL_COUNT; i++) {
+        const ChannelConfig& config = CHANNELS[i];
+        ChannelHardware& hardware = channelHardware[i];
+        if (config.actuator == ACTUATOR_SERVO) {
+            hardware.servo = &servoMotors[countActuators(ACTUATOR_SERVO, i)];
+            hardware.servo->begin(config);
+        } else {
+            hardware.pump = &pumps[countActuators(ACTUATOR_PUMP, i)];
+            hardware.pump->begin(config);
+        }
+        if (config.sensor == SENSOR_STOCK) {
+            hardware.stock = &stockSensors[countSensors(SENSOR_STOCK, i)];
+            hardware.stock->begin(sensorBank, config);
+        } else if (config.sensor == SENSOR_FLOAT) {
+            hardware.level = &floatSwitches[countSensors(SENSOR_FLOAT, i)];
+            hardware.level->begin(sensorBank, config);
+        }
+    }
+    channelHardware[COMMAND_WATER - CHANNEL_FIRST_COMMAND].pump->setRamps(WATER_PUMP_SOFT_START_MS, WATER_PUMP_SOFT_STOP_MS);
+
+    // DC 모터(진동) 릴레이
+    vibrationMotor.begin();
+
+    for (uint8_t i = 0; i < STOCK_CHANNEL_COUNT; i++) {
+        stockSensors[i].turnOnLaser();
+    }
     
-    servoMotors[1] = new ServoMT(PIN_COFFEE_SERVO, "CoffeeDispenser");
-    stockSensors[1] = new StockSensor(PIN_COFFEE_LASER, PIN_COFFEE_SENSOR, "CoffeeStock");
+    // 레이저가 켜진 상태에서 센서 뱅크의 첫 스냅샷을 만듭니다.
+    sensorBank.begin();
     
-    servoMotors[2] = new ServoMT(PIN_ICEDTEA_SERVO, "IcedTeaDispenser");
-    stockSensors[2] = new StockSensor(PIN_ICEDTEA_LASER, PIN_ICEDTEA_SENSOR, "IcedTeaStock");
+    // 모든 채널을 닫힘 상태(서보 닫힘 각도, 펌프 OFF)로 설정
+    for (uint8_t i = 0; i < CHANNEL_COUNT; i++) {
+        setChannelOpen(CHANNELS[i].type, false);
+    }
     
-    servoMotors[3] = new ServoMT(PIN_GREENTEA_SERVO, "GreenTeaDispenser");
-    stockSensors[3] = new StockSensor(PIN_GREENTEA_LASER, PIN_GREENTEA_SENSOR, "GreenTeaStock");
+    // DC 모터 릴레이 초기화: DC 모터는 꺼진 상태로 시작
+    vibrationMotor.turnOff(); 
     
-    // 물 펌프 및 플로트 스위치
-    pumps[0] = new PumpMT(PIN_WATER_PUMP, "WaterPump");
-    floatSwitches[0] = new FloatSW(PIN_WATER_FLOAT_SWITCH, "WaterFloatSwitch");
+    // 분배 종료 타이머 시작 (채널은 인터럽트에서 닫히고, 완료 응답은 loop()에서 전송)
+    doseTimer.begin(cutoffChannelFromTimer);
 
-    // DC 모터(진동) 릴레이 제어 (pumps[1])
-    pumps[1] = new PumpMT(PIN_DC_MOTOR, "VibrationMotor");
+    Serial.println(F("CafeFirmware initialized successfully"));
 
-    // ===== 컵 디스펜서 서보 모터 추가 =====
-    servoMotors[4] = new ServoMT(PIN_CUP_SERVO, "CupDispenser");
+    // 초기 센서 상태를 기준으로 삼고 전체 상태를 한 번 전송합니다.
+    sensorMonitor.begin(readSensorBits());
+    sendSensorData(sensorMonitor.getSensorMask(), 0);
     
-    // 시리얼 명령 핸들러 (BAUD_RATE_SERIAL 상수는 Pin.h에서 가져옴)
-    serialCommand = new SerialCommand(BAUD_RATE_SERIAL);
+    // 주기 작업과 하트비트를 타이머에 등록합니다 (주기 상수는 Pin.h, SensorBank.h에서 가져옴).
+    timerWheel.begin(millis());
+    timerWheel.schedulePeriodic(TIMER_SENSOR_BANK, SENSOR_BANK_TICK_MS);
+    timerWheel.schedulePeriodic(TIMER_SENSOR_SAMPLE, INTERVAL_SENSOR_SAMPLE);
+    timerWheel.schedule(TIMER_HEARTBEAT, INTERVAL_SENSOR_REPORT);
+    timerWheel.schedulePeriodic(TIMER_ACTUATORS, INTERVAL_ACTUATOR_UPDATE);
     
-    // ===== 시리얼 통신 초기화 =====
-    serialCommand->begin();
-    delay(1000);
-
-    for (int i = 0; i < 4; i++) {
-        stockSensors[i]->turnOnLaser();
+    // 태스크 등록 (등록 순서대로 매 loop() 마다 한 번씩 실행)
+    scheduler.add(sensorTask, "sensor", TASK_BUDGET_SENSOR);
+    scheduler.add(telemetryTask, "telemetry", TASK_BUDGET_TELEMETRY);
+    scheduler.add(serialRxTask, "serial_rx", TASK_BUDGET_SERIAL_RX);
+    scheduler.add(actuatorTask, "actuators", TASK_BUDGET_ACTUATORS);
+    for (uint8_t i = 0; i < CHANNEL_COUNT; i++) {
+        scheduler.add(channelTask, CHANNELS[i].name, TASK_BUDGET_CHANNEL, i);
     }
+    scheduler.add(stirTask, "stir", TASK_BUDGET_CHANNEL);
+    scheduler.add(dispatchTask, "dispatch", TASK_BUDGET_DISPATCH);
+    scheduler.add(journalTask, "journal", TASK_BUDGET_JOURNAL);
+    scheduler.add(serialTxTask, "serial_tx", TASK_BUDGET_SERIAL_TX);
+    lastLoopStartMicros = micros();
+}
+
+/**
+ * @brief 메인 루프
+ */
+void loop() {
+    uint32_t currentTime = millis();
     
-    // 서보 모터 초기 닫힘 각도 설정
-    servoMotors[0]->setAngle(30); 
-    servoMotors[1]->setAngle(30);
-    servoMotors[2]->setAngle(30);
-    servoMotors[3]->setAngle(20);
-    servoMotors[4]->setAngle(0);
+    // ===== 반복 주기 측정 =====
+    uint32_t loopStartMicros = micros();
+    if (!skipNextLoopSample) {
+        loopStats.record((int32_t)(loopStartMicros - lastLoopStartMicros));
+    }
+    skipNextLoopSample = false;
+    lastLoopStartMicros = loopStartMicros;
     
-    // DC 모터 릴레이 초기화: DC 모터는 꺼진 상태로 시작
-    pumps[1]->turnOff(); 
+    // ===== 만기된 타이머 확인 후 태스크 실행 =====
+    // 만기가 없으면 poll() 은 비교 한 번으로 끝나고, 이벤트를 기다리는 태스크는 건너뜁니다.
+    scheduler.run(timerWheel.poll(currentTime));
+}
 
-    Serial.println("CafeFirmware initialized successfully");
+// ===== 태스크 =====
+// 각 태스크는 짧게 실행하고 반환합니다. 상태가 필요한 태스크는 TASK_BEGIN/TASK_END 코루틴으로
+// 대기 지점을 기억하므로, 채널별 진행 상태를 전역 플래그로 따로 두지 않습니다.
+
+/**
+ * @brief 센서 뱅크 디바운스 샘플 (TIMER_SENSOR_BANK 마다)
+ */
+void sensorTask(Task& task) {
+    TASK_BEGIN(task);
+    while (true) {
+        TASK_WAIT_EVENT(task, TIMER_EVENT(TIMER_SENSOR_BANK));
+        sensorBank.sample();
+    }
+    TASK_END(task);
 }
 
 /**
- * @brief 메인 루프
+ * @brief 센서 스냅샷/변경/하트비트 전송 (TIMER_SENSOR_SAMPLE, TIMER_HEARTBEAT 마다)
  */
-void loop() {
-    uint64_t currentTime = millis();
+void telemetryTask(Task& task) {
+    TASK_BEGIN(task);
+    while (true) {
+        TASK_WAIT_EVENT(task, TIMER_EVENT(TIMER_SENSOR_SAMPLE) | TIMER_EVENT(TIMER_HEARTBEAT));
+        updateSensors(task.events);
+    }
+    TASK_END(task);
+}
+
+/**
+ * @brief 명령 수신 (매 회차, 시간 예산 안에서 도착한 줄을 모두 처리)
+ *
+ * 실행 중에도 명령을 계속 수신하여 대기열에 보관합니다.
+ */
+void serialRxTask(Task& task) {
+    do {
+        processNewCommand();
+    } while (Serial.available() && !task.isOverBudget());
+    commandStats.record((int32_t)(micros() - task.startMicros));
+}
+
+/**
+ * @brief 서보 게이트 이동과 펌프 램프 진행 (TIMER_ACTUATORS 마다)
+ */
+void actuatorTask(Task& task) {
+    TASK_BEGIN(task);
+    while (true) {
+        TASK_WAIT_EVENT(task, TIMER_EVENT(TIMER_ACTUATORS));
+        updateActuators();
+    }
+    TASK_END(task);
+}
+
+/**
+ * @brief 분배 채널 하나의 실행 과정 (task.arg = 채널 인덱스)
+ *
+ * 명령 시작 → (서보) 게이트가 열림 각도에 도착 → 타이머 시작 → 인터럽트가 닫음 → 완료 보고.
+ * 게이트가 실제로 열린 시점부터 분배 시간을 잽니다.
+ */
+void channelTask(Task& task) {
+    const uint8_t slot = task.arg;
+    const CommandType type = (CommandType)(CHANNEL_FIRST_COMMAND + slot);
+    ChannelState& channel = channelStates[type];
     
-    // ===== 센서 데이터 주기적 전송 (INTERVAL_SENSOR_READING 상수는 Pin.h에서 가져옴) =====
-    if (currentTime - lastSensorReadingTime >= INTERVAL_SENSOR_READING) {
-        lastSensorReadingTime = currentTime;
-        sendSensorData();
+    TASK_BEGIN(task);
+    while (true) {
+        TASK_WAIT_UNTIL(task, channel.isExecuting);
+        if (CHANNELS[slot].actuator == ACTUATOR_SERVO) {
+            TASK_WAIT_UNTIL(task, channelHardware[slot].servo->isInPosition());
+        }
+        channel.startMicros = micros();
+        doseTimer.arm(slot, channel.duration);
+        
+        TASK_WAIT_UNTIL(task, doseTimer.takeExpired(slot));
+        uint32_t actualMicros = channelStopMicros[slot] - channel.startMicros;
+        overshootStats.record((int32_t)(actualMicros - channel.duration * 1000UL));
+        completeCommandExecution(type, actualMicros);
     }
+    TASK_END(task);
+}
 
-    if (isCommandExecuting) {
-        checkCommandCompletion(currentTime);
+/**
+ * @brief DC 모터 교반 단계 종료 (TIMER_STIR 만기)
+ */
+void stirTask(Task& task) {
+    TASK_BEGIN(task);
+    while (true) {
+        TASK_WAIT_EVENT(task, TIMER_EVENT(TIMER_STIR));
+        ChannelState& channel = channelStates[COMMAND_DC_MOTOR];
+        if (channel.isExecuting) {
+            uint32_t actualMicros = micros() - channel.startMicros;
+            overshootStats.record((int32_t)(actualMicros - channel.duration * 1000UL));
+            completeCommandExecution(COMMAND_DC_MOTOR, actualMicros);
+        }
+    }
+    TASK_END(task);
+}
+
+/**
+ * @brief 레시피/여러 단계 명령 진행과 대기열 명령 시작 (매 회차)
+ *
+ * 레시피는 다음 단계 시각이 되었거나 채널이 비었을 때(TIMER_RECIPE)만 진행합니다.
+ */
+void dispatchTask(Task& task) {
+    if (task.events & TIMER_EVENT(TIMER_RECIPE)) {
+        updateRecipe(millis());
+    }
+    updateBatch();
+    startNextQueuedCommand();
+}
+
+/**
+ * @brief 분배 기록의 EEPROM 쓰기와 덤프/통계 전송 (매 회차, 조금씩 나누어 진행)
+ */
+void journalTask(Task& task) {
+    journal.update();
+    updateJournalDump(task);
+    updateStatsReport(task);
+}
+
+/**
+ * @brief 송신 대기열을 하드웨어 송신 버퍼로 옮기기 (매 회차, 마지막에 실행)
+ *
+ * 하드웨어 버퍼에 남은 자리만큼만 옮기므로 기다리지 않습니다. 이번 회차에 쌓인 응답이 바로 나가도록 마지막에 등록합니다.
+ */
+void serialTxTask(Task& task) {
+    (void)task;
+    // 통계/기록 덤프를 나누어 보내는 동안에는 멀티드롭 차례를 끝내지 않습니다.
+    serialCommand.holdBusTurn(statsReportPosition != STATS_REPORT_IDLE || journalDumpPosition != JOURNAL_DUMP_IDLE);
+    serialCommand.update();
+}
+
+/**
+ * @brief 센서 샘플링 및 전송
+ *
+ * INTERVAL_SENSOR_SAMPLE 마다 디바운스된 센서 상태의 변경을 확인합니다.
+ * 스냅샷 모드(기본)에서는 INTERVAL_SENSOR_REPORT 마다 전체 상태를 전송합니다.
+ * 이벤트 모드에서는 안정 상태가 바뀐 센서만 즉시 전송하고, 마지막 전송 후 INTERVAL_SENSOR_HEARTBEAT 동안
+ * 변경이 없으면 전체 상태를 전송하여 연결 상태를 확인시킵니다. 모드가 바뀌면 바로 전체 상태를 전송합니다.
+ * @param dueEvents 이번 반복에 만기된 타이머 (TIMER_SENSOR_SAMPLE, TIMER_HEARTBEAT)
+ */
+void updateSensors(uint16_t dueEvents) {
+    uint8_t changedBits = 0;
+    if (dueEvents & TIMER_EVENT(TIMER_SENSOR_SAMPLE)) {
+        changedBits = sensorMonitor.update(readSensorBits());
+    }
+    
+    TelemetryMode mode = serialCommand.getTelemetryMode();
+    bool modeChanged = (mode != reportedTelemetryMode);
+    reportedTelemetryMode = mode;
+    
+    uint8_t reportBits;
+    if (modeChanged || (dueEvents & TIMER_EVENT(TIMER_HEARTBEAT))) {
+        reportBits = sensorMonitor.getSensorMask();
+    } else if (mode == TELEMETRY_EVENT && changedBits != 0) {
+        reportBits = changedBits;
     } else {
-        processNewCommand();
+        return;
     }
+    
+    uint32_t sendStartMicros = micros();
+    sendSensorData(reportBits, changedBits);
+    telemetryStats.record((int32_t)(micros() - sendStartMicros));
+    timerWheel.schedule(TIMER_HEARTBEAT, mode == TELEMETRY_EVENT ? INTERVAL_SENSOR_HEARTBEAT : INTERVAL_SENSOR_REPORT);
 }
 
 /**
- * @brief 센서 데이터 전송
+ * @brief 센서별 "HIGH" 상태를 비트로 묶어 읽기 (비트 i = TELEMETRY_ORDER[i])
+ *
+ * 재고 센서: 재고 없음, 플로트 스위치: 액체 있음
  */
-void sendSensorData() {
+uint8_t readSensorBits() {
+    uint8_t stateBits = 0;
+    for (uint8_t bit = 0; bit < TELEMETRY_CHANNEL_COUNT; bit++) {
+        const ChannelHardware& hardware = channelHardware[TELEMETRY_ORDER[bit] - CHANNEL_FIRST_COMMAND];
+        bool isHigh = hardware.stock != nullptr ? hardware.stock->isStockEmpty()
+                                                : hardware.level->isLiquidPresent();
+        if (isHigh) {
+            stateBits |= (1 << bit);
+        }
+    }
+    return stateBits;
+}
+
+/**
+ * @brief 센서 데이터 전송 (디바운스된 안정 상태 기준)
+ * @param reportBits 전송할 센서 비트 (스냅샷/하트비트는 전체)
+ * @param changedBits 상태가 바뀐 센서 비트 (바이너리 이벤트 모드에서만 전송)
+ */
+void sendSensorData(uint8_t reportBits, uint8_t changedBits) {
+    if (serialCommand.isMultiDrop()) {
+        return;  // 버스에서는 호스트가 부를 때만 송신하므로 상태 폴링(P)으로 대신합니다.
+    }
+    
+    uint8_t stableBits = sensorMonitor.getStableBits();
+    
+    if (serialCommand.isBinaryMode()) {
+        // 바이너리 모드: 전체 상태 비트마스크 (이벤트 모드는 변경 비트마스크도) 를 한 프레임으로 전송
+        serialCommand.sendTelemetryFrame(stableBits, changedBits);
+        return;
+    }
+
+    // 텍스트 모드: 이벤트 모드의 변경은 바뀐 키만, 스냅샷/하트비트는 모든 키를 담은 JSON 전송
     StaticJsonDocument<256> doc; 
-    doc["sugar"] = stockSensors[0]->getStockStateString();
-    doc["coffee_powder"] = stockSensors[1]->getStockStateString();
-    doc["iced_tea_powder"] = stockSensors[2]->getStockStateString();
-    doc["green_tea"] = stockSensors[3]->getStockStateString();
-    doc["water"] = floatSwitches[0]->getStateString();
+    for (uint8_t bit = 0; bit < TELEMETRY_CHANNEL_COUNT; bit++) {
+        if (!(reportBits & (1 << bit))) {
+            continue;
+        }
+        const ChannelConfig& config = channelConfig(TELEMETRY_ORDER[bit]);
+        bool isHigh = stableBits & (1 << bit);
+        if (config.sensor == SENSOR_STOCK) {
+            doc[config.telemetryKey] = isHigh ? STR_STOCK_STATE_EMPTY : STR_STOCK_STATE_FULL;
+        } else {
+            doc[config.telemetryKey] = isHigh ? STR_FLOAT_HIGH : STR_FLOAT_LOW;
+        }
+    }
 
-    serializeJson(doc, Serial);
-    Serial.println(); 
+    TxQueue& output = serialCommand.getOutput();
+    serializeJson(doc, output.begin(TX_LANE_TELEMETRY));
+    output.println();
+    output.end();
 }
 
 /**
- * @brief 명령 완료 확인
- * @param currentTime 현재 시간
+ * @brief 서보 동작 프로파일과 펌프 램프/시간 제어 진행
+ *
+ * 분배 종료 인터럽트는 목표 각도/듀티만 바꾸므로, 닫힘과 소프트 스톱도 여기서 진행됩니다.
  */
-void checkCommandCompletion(uint64_t currentTime) {
-    if (currentTime - commandStartTime >= commandDuration) {
-        completeCommandExecution();
+void updateActuators() {
+    for (uint8_t i = 0; i < SERVO_CHANNEL_COUNT; i++) {
+        servoMotors[i].update();
     }
+    for (uint8_t i = 0; i < PUMP_CHANNEL_COUNT; i++) {
+        pumps[i].update();
+    }
+    vibrationMotor.update();
 }
 
 /**
  * @brief 명령 실행 완료 처리
+ *
+ * 분배 채널은 요청 시간, 실제 시간, 진동 릴레이 전환 여부를 분배 기록에 남깁니다.
+ * @param commandType 완료된 채널의 명령 타입
+ * @param actualMicros 실제 작동 시간 (마이크로초)
  */
-void completeCommandExecution() {
-    // 재료 분배 명령이 완료되면 DC 모터를 끕니다.
-    switch (currentCommandType) {
-        case COMMAND_SUGAR:
-        case COMMAND_WATER:
-        case COMMAND_COFFEE:
-        case COMMAND_ICEDTEA:
-        case COMMAND_GREENTEA:
-            // 🚨 모든 재료 분배가 완료되면 DC 모터(진동) OFF
-            pumps[1]->turnOff(); 
-            break;
-        default:
-            break;
+void completeCommandExecution(CommandType commandType, uint32_t actualMicros) {
+    const ChannelConfig* config = serialCommand.getChannelConfig(commandType);
+    
+    if (config != nullptr) {
+        setChannelOpen(commandType, false);
+        lastRunSeconds[commandType - CHANNEL_FIRST_COMMAND] = actualMicros / 1e6f;
+        // 🚨 진동을 사용하는 마지막 채널이 끝날 때만 DC 모터(진동) OFF
+        bool vibrationStopped = config->needsVibration && releaseVibration();
+        
+        journal.record(commandType, (uint16_t)(channelStates[commandType].duration / 10),
+                       microsToCentiseconds(actualMicros), vibrationStopped, millis() / 1000UL);
+    } else if (commandType == COMMAND_DC_MOTOR) {
+        releaseVibration();
+    }
+    
+    serialCommand.reportCompleted(commandType);
+    serialCommand.reportDone(channelStates[commandType].sequence, commandType,
+                             (uint16_t)(channelStates[commandType].duration / 10), microsToCentiseconds(actualMicros));
+    
+    resetCommandState(commandType);
+    
+    // 채널이 비었으니 레시피의 다음 단계를 바로 확인합니다.
+    if (recipeRunner.isRunning()) {
+        timerWheel.schedule(TIMER_RECIPE, 0);
     }
+}
 
-    switch (currentCommandType) {
-        case COMMAND_SUGAR:
-            servoMotors[0]->setAngle(30); 
-            serialCommand->printSuccess("Sugar dispensing completed");
-            break;
-            
-        case COMMAND_WATER:
-            pumps[0]->turnOff(); 
-            serialCommand->printSuccess("Water pumping completed");
-            break;
-            
-        case COMMAND_COFFEE:
-            servoMotors[1]->setAngle(30); 
-            serialCommand->printSuccess("Coffee dispensing completed");
-            break;
-            
-        case COMMAND_ICEDTEA:
-            servoMotors[2]->setAngle(30); 
-            serialCommand->printSuccess("IcedTea dispensing completed");
-            break;
-            
-        case COMMAND_GREENTEA:
-            servoMotors[3]->setAngle(20); 
-            serialCommand->printSuccess("GreenTea dispensing completed");
-            break;
+/**
+ * @brief 채널 실행 상태 초기화
+ * @param commandType 초기화할 채널의 명령 타입
+ */
+void resetCommandState(CommandType commandType) {
+    ChannelState& channel = channelStates[commandType];
+    channel.isExecuting = false;
+    channel.duration = 0;
+    channel.sequence = SEQUENCE_NONE;
+}
 
-        case COMMAND_DC_MOTOR: 
-            pumps[1]->turnOff(); 
-            serialCommand->printSuccess("DC Motor operation completed");
-            break;
+/**
+ * @brief 실행 중인 채널이 있는지 확인
+ */
+bool isAnyChannelExecuting() {
+    for (int type = 0; type < COMMAND_UNKNOWN; type++) {
+        if (channelStates[type].isExecuting) {
+            return true;
+        }
+    }
+    return false;
+}
 
-        case COMMAND_CUP: 
-            servoMotors[4]->setAngle(0); 
-            serialCommand->printSuccess("Cup dispensing completed");
-            break;
-            
-        default:
-            break;
+/**
+ * @brief 명령을 지금 시작할 수 있는지 확인
+ *
+ * 채널이 비어 있으면 다른 채널과 동시에 시작합니다.
+ * 컵 디스펜스는 재료가 컵보다 먼저 떨어지지 않도록 단독으로 실행합니다.
+ * 레시피와 여러 단계 명령은 모든 채널이 비었을 때 시작합니다.
+ * @param commandType 시작할 명령 타입
+ */
+bool canStartCommand(CommandType commandType) {
+    if (channelStates[COMMAND_CUP].isExecuting) {
+        return false;
+    }
+    if (commandType == COMMAND_CUP || commandType == COMMAND_RECIPE || commandType == COMMAND_BATCH) {
+        return !isAnyChannelExecuting();
+    }
+    if (commandType > COMMAND_NONE && commandType < COMMAND_UNKNOWN) {
+        return !channelStates[commandType].isExecuting;
+    }
+    return true;
+}
+
+/**
+ * @brief DC 모터(진동) 사용 시작 (참조 카운트)
+ */
+void acquireVibration() {
+    if (vibrationUsers++ == 0) {
+        vibrationMotor.turnOn();
     }
-    
-    resetCommandState();
 }
 
 /**
- * @brief 명령 실행 상태 초기화
+ * @brief DC 모터(진동) 사용 종료 (참조 카운트)
+ * @return true: 마지막 사용자가 끝나 릴레이를 껐음
  */
-void resetCommandState() {
-    isCommandExecuting = false;
-    currentCommandType = COMMAND_NONE;
-    commandDuration = 0;
+bool releaseVibration() {
+    if (vibrationUsers > 0 && --vibrationUsers == 0) {
+        vibrationMotor.turnOff();
+        return true;
+    }
+    return false;
 }
 
 /**
- * @brief 새로운 명령 처리
+ * @brief 새로운 명령 수신 및 대기열 추가
  */
 void processNewCommand() {
-    Command command = serialCommand->readCommand();
+    Command command = serialCommand.readCommand();
     
     if (command.type != COMMAND_NONE) {
         if (!command.isValid) {
-            serialCommand->printError(command.errorMessage);
+            serialCommand.reportCommandError(command);
+            serialCommand.reportNak(command.sequence, command.error, command.type);
+            return;
+        }
+        
+        // 통계/상태 조회는 대기열을 거치지 않습니다.
+        // 통계는 loop() 마다 한 줄씩 전송합니다 (진행 중이면 처음부터 다시).
+        if (command.type == COMMAND_STATS) {
+            serialCommand.reportAck(command.sequence, command.type);
+            if (serialCommand.isBinaryMode()) {
+                serialCommand.reportError(ERROR_UNSUPPORTED, COMMAND_STATS);
+            } else {
+                statsReportPosition = 0;
+            }
+            return;
+        }
+        if (command.type == COMMAND_STATUS) {
+            serialCommand.reportAck(command.sequence, command.type);
+            reportNodeStatus();
+            return;
+        }
+        
+        // 보정은 마지막으로 끝난 분배를 기준으로 하므로 대기열을 거치지 않습니다.
+        if (command.type == COMMAND_CALIBRATE) {
+            serialCommand.reportAck(command.sequence, command.type);
+            calibrateChannel(command);
             return;
         }
         
+        // 기록 덤프는 loop() 마다 조금씩 전송합니다 (진행 중이면 처음부터 다시).
+        if (command.type == COMMAND_JOURNAL) {
+            serialCommand.reportAck(command.sequence, command.type);
+            journalDumpPosition = 0;
+            return;
+        }
+        
+        // 여러 단계 명령은 단계를 batchRunner 에 보관하고, 대기열에는 순서를 지키기 위한 표시만 넣습니다.
+        if (command.type == COMMAND_BATCH && !loadBatch(command)) {
+            return;
+        }
+        
+        if (!commandQueue.push(command)) {
+            serialCommand.reportError(ERROR_QUEUE_FULL, command.type, command.value, command.rawCommand);
+            serialCommand.reportNak(command.sequence, ERROR_QUEUE_FULL, command.type);
+            if (command.type == COMMAND_BATCH) {
+                batchRunner.clear();
+            }
+            return;
+        }
+        serialCommand.reportAck(command.sequence, command.type);
+    }
+}
+
+/**
+ * @brief 분배량 보정 (보정 명령 처리)
+ *
+ * "KS12.5" 처럼 마지막 시간 분배에서 실제로 나온 양을 받아 초당 분배량을 계산하고 저장합니다.
+ * 대상 채널이 없으면 ("K") 모든 채널의 보정값을 보고합니다.
+ * @param command 보정 명령 (target: 대상 채널, value: 측정된 분배량)
+ */
+void calibrateChannel(const Command& command) {
+    if (command.target == COMMAND_NONE) {
+        for (uint8_t i = 0; i < CHANNEL_COUNT; i++) {
+            serialCommand.reportCalibration(CHANNELS[i].type, calibration.getRate(i));
+        }
+        return;
+    }
+    
+    uint8_t slot = command.target - CHANNEL_FIRST_COMMAND;
+    if (lastRunSeconds[slot] <= 0) {
+        serialCommand.reportError(ERROR_NO_REFERENCE_RUN, command.target);
+        return;
+    }
+    
+    if (!calibration.setRate(slot, command.value / lastRunSeconds[slot])) {
+        serialCommand.reportError(ERROR_INVALID_QUANTITY, command.target);
+        return;
+    }
+    serialCommand.reportCalibration(command.target, calibration.getRate(slot));
+}
+
+/**
+ * @brief 분배 기록 덤프 진행 (J 명령)
+ *
+ * 응답 대기열에 JOURNAL_DUMP_LINE_RESERVE 바이트 이상 여유가 있는 동안 한 줄(프레임)씩 쌓으므로
+ * 대기열을 채워 다른 응답을 기다리게 하지 않고, 태스크의 시간 예산을 다 쓰면 다음 회차로 넘깁니다.
+ * 기록을 오래된 순으로 보낸 뒤 채널별 누적 사용량과 진동 릴레이 전환 횟수를 보내고 완료를 알립니다.
+ * @param task 기록 태스크 (시간 예산 확인용)
+ */
+void updateJournalDump(const Task& task) {
+    const uint16_t capacity = journal.getCapacity();
+    const LifetimeCounters& counters = journal.getCounters();
+    
+    while (journalDumpPosition != JOURNAL_DUMP_IDLE && serialCommand.getOutput().getFree(TX_LANE_EVENT) >= JOURNAL_DUMP_LINE_RESERVE
+           && !task.isOverBudget()) {
+        uint16_t position = journalDumpPosition++;
+        
+        if (position < capacity) {
+            JournalEntry entry;
+            if (journal.readEntry(position, entry)) {
+                serialCommand.reportJournalEntry(entry.sequence, entry.bootCount, (CommandType)entry.type,
+                                                 entry.uptimeSeconds, entry.requestedCs, entry.actualCs);
+            }
+        } else if (position < capacity + CHANNEL_COUNT) {
+            uint8_t slot = position - capacity;
+            serialCommand.reportLifetimeCounter(CHANNELS[slot].type, counters.cycles[slot], counters.onTimeCs[slot]);
+        } else if (position == capacity + CHANNEL_COUNT) {
+            serialCommand.reportLifetimeCounter(COMMAND_DC_MOTOR, counters.vibrationCycles, 0);
+        } else {
+            serialCommand.reportCompleted(COMMAND_JOURNAL);
+            journalDumpPosition = JOURNAL_DUMP_IDLE;
+        }
+    }
+}
+
+/**
+ * @brief 실행 시간 통계 전송 진행 (T 명령, 텍스트 모드 전용)
+ *
+ * 통계마다 한 줄의 JSON 을 보냅니다. 값의 단위는 마이크로초이며,
+ * hist 는 TimingStats 의 로그 스케일 버킷 카운트입니다.
+ * 응답 대기열에 STATS_REPORT_LINE_RESERVE 바이트 이상 여유가 있을 때만 한 줄씩 쌓고,
+ * 보낸 통계는 그 줄을 보낼 때 초기화합니다.
+ * @param task 기록 태스크 (시간 예산 확인용)
+ */
+void updateStatsReport(const Task& task) {
+    TxQueue& output = serialCommand.getOutput();
+    const uint8_t taskLines = scheduler.getTaskCount();
+    const uint8_t laneStart = STATS_REPORT_TIMING_LINES + taskLines;
+    const uint8_t busLine = laneStart + TX_LANE_COUNT;
+    
+    while (statsReportPosition != STATS_REPORT_IDLE && output.getFree(TX_LANE_EVENT) >= STATS_REPORT_LINE_RESERVE
+           && !task.isOverBudget()) {
+        uint8_t position = statsReportPosition++;
+        // 출력에 걸린 시간이 다음 주기 통계에 섞이지 않도록 출력한 반복은 제외합니다.
+        skipNextLoopSample = true;
+        
+        if (position < STATS_REPORT_TIMING_LINES) {
+            static const char* const statNames[STATS_REPORT_TIMING_LINES] = { "loop", "command", "telemetry", "overshoot" };
+            TimingStats* const stats[STATS_REPORT_TIMING_LINES] = { &loopStats, &commandStats, &telemetryStats, &overshootStats };
+            reportTimingStats(statNames[position], *stats[position]);
+        } else if (position < laneStart) {
+            // 태스크별 최장 실행 시간과 시간 예산 초과 횟수
+            uint8_t index = position - STATS_REPORT_TIMING_LINES;
+            const Task& target = scheduler.getTask(index);
+            StaticJsonDocument<96> doc;
+            doc["task"] = target.name;
+            doc["max"] = target.maxRunMicros;
+            doc["budget"] = target.budgetUs;
+            doc["overruns"] = target.overruns;
+            serializeJson(doc, output.begin(TX_LANE_EVENT));
+            output.println();
+            output.end();
+            if (index == taskLines - 1) {
+                scheduler.resetStats();
+            }
+        } else if (position < busLine) {
+            // 송신 대기열별 최대 사용량, 버린/밀린 메시지 수
+            static const char* const laneNames[TX_LANE_COUNT] = { "event", "telemetry" };
+            uint8_t lane = position - laneStart;
+            const TxLaneStats& stats = output.getStats((TxLane)lane);
+            StaticJsonDocument<96> doc;
+            doc["tx"] = laneNames[lane];
+            doc["peak"] = stats.peakBytes;
+            doc["dropped"] = stats.dropped;
+            doc["lost"] = stats.lost;
+            doc["deferred"] = stats.deferred;
+            serializeJson(doc, output.begin(TX_LANE_EVENT));
+            output.println();
+            output.end();
+            if (lane == TX_LANE_COUNT - 1) {
+                output.resetStats();
+            }
+        } else if (position == busLine && serialCommand.isMultiDrop()) {
+            // 멀티드롭 버스: 응답 창, 상태 슬롯, 늦어서 건너뛴 슬롯, 다른 노드 앞 요청 수
+            const BusStats& bus = serialCommand.getBusStats();
+            StaticJsonDocument<96> doc;
+            doc["bus"] = serialCommand.getNodeAddress();
+            doc["windows"] = bus.windows;
+            doc["slots"] = bus.slots;
+            doc["late"] = bus.lateSlots;
+            doc["filtered"] = bus.filtered;
+            serializeJson(doc, output.begin(TX_LANE_EVENT));
+            output.println();
+            output.end();
+            serialCommand.resetBusStats();
+        } else if (position > busLine) {
+            statsReportPosition = STATS_REPORT_IDLE;
+        }
+    }
+}
+
+/**
+ * @brief 노드 상태 응답 (P 명령, 멀티드롭 버스 폴링)
+ *
+ * 분배 중인 채널, 디바운스된 센서 상태, 대기 명령 수를 짧게 보냅니다.
+ */
+void reportNodeStatus() {
+    NodeStatus status;
+    status.flags = 0;
+    status.busyChannels = 0;
+    for (uint8_t i = 0; i < CHANNEL_COUNT; i++) {
+        if (channelStates[CHANNELS[i].type].isExecuting) {
+            status.busyChannels |= (1 << i);
+        }
+    }
+    if (status.busyChannels != 0 || channelStates[COMMAND_DC_MOTOR].isExecuting
+        || recipeRunner.isRunning() || batchRunner.isRunning()) {
+        status.flags |= NODE_STATUS_BUSY;
+    }
+    status.sensorBits = sensorMonitor.getStableBits();
+    status.queued = commandQueue.size();
+    serialCommand.reportStatus(status);
+}
+
+/**
+ * @brief 통계 하나를 JSON 한 줄로 전송하고 초기화
+ * @param name 통계 이름
+ * @param stats 전송할 통계
+ */
+void reportTimingStats(const char* name, TimingStats& stats) {
+    StaticJsonDocument<384> doc;
+    doc["stat"] = name;
+    doc["n"] = stats.getCount();
+    doc["min"] = stats.getMin();
+    doc["max"] = stats.getMax();
+    doc["mean"] = stats.getMean();
+    JsonArray hist = doc.createNestedArray("hist");
+    for (uint8_t i = 0; i < TIMING_STATS_BUCKETS; i++) {
+        hist.add(stats.getBucket(i));
+    }
+    
+    TxQueue& output = serialCommand.getOutput();
+    serializeJson(doc, output.begin(TX_LANE_EVENT));
+    output.println();
+    output.end();
+    stats.reset();
+}
+
+/**
+ * @brief 대기열의 다음 명령 실행
+ *
+ * 맨 앞 명령의 채널이 비어 있는 동안 차례대로 시작하므로,
+ * 서로 다른 채널의 명령은 겹쳐서 실행되고 같은 채널의 명령은 순서를 지킵니다.
+ * 재고 부족 등으로 실행되지 못한 명령은 건너뛰고 다음 명령을 시도합니다.
+ */
+void startNextQueuedCommand() {
+    Command command;
+    
+    // 레시피/여러 단계 명령 실행 중에는 대기열 명령이 단계 사이에 끼어들지 않도록 기다립니다.
+    while (!recipeRunner.isRunning() && !batchRunner.isRunning()
+           && !commandQueue.isEmpty() && canStartCommand(commandQueue.peek()->type)) {
+        commandQueue.pop(command);
         executeCommand(command);
     }
 }
 
+/**
+ * @brief 레시피 타임라인 진행
+ *
+ * 시작 시각이 된 단계를 채널이 비는 대로 시작하고,
+ * 모든 단계가 끝나면 레시피 완료를 알립니다.
+ * @param currentTime 현재 시간
+ */
+void updateRecipe(uint32_t currentTime) {
+    if (!recipeRunner.isRunning()) {
+        return;
+    }
+    
+    RecipeStep step;
+    while (recipeRunner.getDueStep(currentTime, step) && canStartCommand((CommandType)step.type)) {
+        recipeRunner.advance();
+        
+        if (!startTimedStep((CommandType)step.type, step.durationCs / 100.0f)) {
+            serialCommand.reportError(ERROR_RECIPE_ABORTED, COMMAND_RECIPE, recipeRunner.getRecipeId());
+            finishSequencedRun(COMMAND_RECIPE, ERROR_RECIPE_ABORTED);
+            recipeRunner.stop();
+            return;
+        }
+    }
+    
+    if (recipeRunner.isAllStepsStarted()) {
+        if (!isAnyChannelExecuting()) {
+            serialCommand.reportCompleted(COMMAND_RECIPE, recipeRunner.getRecipeId());
+            finishSequencedRun(COMMAND_RECIPE, ERROR_NONE);
+            recipeRunner.stop();
+        }
+        return;
+    }
+    
+    // 다음 단계 시각에 다시 확인합니다 (시각이 지났지만 채널이 바쁘면 채널 완료 시 확인).
+    uint32_t nextStepTime = recipeRunner.getNextStepTime();
+    if (!TimerWheel::isDue(currentTime, nextStepTime)) {
+        timerWheel.scheduleAt(TIMER_RECIPE, nextStepTime);
+    }
+}
+
+/**
+ * @brief 여러 단계 명령 줄의 단계 보관 (수신 시)
+ *
+ * 분배량 단계는 보정값으로 작동 시간을 계산하여 시간 단계와 같은 범위를 확인합니다.
+ * 한 단계라도 실패하면 아무것도 보관하지 않고 전체를 거부합니다.
+ * @param command 파싱된 COMMAND_BATCH 명령
+ * @return true: 보관됨 (대기열에 넣을 수 있음)
+ */
+bool loadBatch(const Command& command) {
+    if (batchRunner.isLoaded()) {
+        // 한 번에 한 줄만 보관합니다 (앞 줄이 끝난 뒤 다시 보내야 함).
+        serialCommand.reportError(ERROR_QUEUE_FULL, COMMAND_BATCH, command.value, command.rawCommand);
+        serialCommand.reportNak(command.sequence, ERROR_QUEUE_FULL, COMMAND_BATCH);
+        return false;
+    }
+    
+    for (uint8_t i = 0; i < serialCommand.getBatchStepCount(); i++) {
+        BatchStep step = serialCommand.getBatchStep(i);
+        
+        if (step.isQuantity) {
+            uint8_t slot = step.type - CHANNEL_FIRST_COMMAND;
+            Command timedCommand;
+            timedCommand.type = (CommandType)step.type;
+            timedCommand.value = calibration.toDuration(slot, step.value);
+            timedCommand.target = COMMAND_NONE;
+            timedCommand.isQuantity = false;
+            timedCommand.error = calibration.isCalibrated(slot) ? ERROR_NONE : ERROR_NOT_CALIBRATED;
+            
+            if (timedCommand.error != ERROR_NONE || !serialCommand.validateCommand(timedCommand)) {
+                serialCommand.reportError(timedCommand.error, timedCommand.type);
+                serialCommand.reportError(ERROR_BATCH_REJECTED, COMMAND_BATCH, i + 1);
+                serialCommand.reportNak(command.sequence, timedCommand.error, COMMAND_BATCH);
+                batchRunner.clear();
+                return false;
+            }
+            step.value = timedCommand.value;
+            step.isQuantity = false;
+        }
+        
+        batchRunner.addStep(step);
+    }
+    return true;
+}
+
+/**
+ * @brief 여러 단계 명령 시작 (대기열에서 차례가 되어 모든 채널이 비었을 때)
+ *
+ * 액추에이터를 움직이기 전에 모든 단계의 재고를 확인하여, 재료가 하나라도 없으면
+ * 아무것도 분배하지 않고 전체를 거부합니다 (만들다 만 음료 방지).
+ */
+void startBatch(const Command& command) {
+    for (uint8_t i = 0; i < batchRunner.getStepCount(); i++) {
+        CommandType commandType = (CommandType)batchRunner.getStep(i).type;
+        const ChannelConfig* config = serialCommand.getChannelConfig(commandType);
+        
+        if (config != nullptr && config->checksStock
+            && channelHardware[commandType - CHANNEL_FIRST_COMMAND].stock->isStockEmpty()) {
+            serialCommand.reportError(ERROR_OUT_OF_STOCK, commandType);
+            serialCommand.reportError(ERROR_BATCH_REJECTED, COMMAND_BATCH, i + 1);
+            serialCommand.reportFailed(command.sequence, ERROR_OUT_OF_STOCK, COMMAND_BATCH);
+            batchRunner.clear();
+            return;
+        }
+    }
+    
+    serialCommand.reportAccepted(COMMAND_BATCH, batchRunner.getStepCount());
+    startSequencedRun(COMMAND_BATCH, command.sequence);
+    batchRunner.start();
+    updateBatch();
+}
+
+/**
+ * @brief 여러 단계 명령 진행
+ *
+ * 현재 그룹의 단계를 채널이 비는 대로 시작하고, 그룹의 단계가 모두 끝나면 다음 그룹을 시작합니다.
+ * 모든 단계가 끝나면 완료를 알립니다.
+ */
+void updateBatch() {
+    if (!batchRunner.isRunning()) {
+        return;
+    }
+    
+    BatchStep step;
+    while (batchRunner.getDueStep(!isAnyChannelExecuting(), step) && canStartCommand((CommandType)step.type)) {
+        batchRunner.advance();
+        
+        if (!startTimedStep((CommandType)step.type, step.value)) {
+            // 실행 중에 재고가 떨어진 경우: 남은 단계는 시작하지 않습니다.
+            serialCommand.reportError(ERROR_BATCH_ABORTED, COMMAND_BATCH, batchRunner.getNextStepIndex());
+            finishSequencedRun(COMMAND_BATCH, ERROR_BATCH_ABORTED);
+            batchRunner.stop();
+            return;
+        }
+    }
+    
+    if (batchRunner.isAllStepsStarted() && !isAnyChannelExecuting()) {
+        serialCommand.reportCompleted(COMMAND_BATCH, batchRunner.getStepCount());
+        finishSequencedRun(COMMAND_BATCH, ERROR_NONE);
+        batchRunner.stop();
+    }
+}
+
+/**
+ * @brief 레시피/여러 단계 명령의 단계 시작
+ * @param commandType 분배 채널 또는 COMMAND_DC_MOTOR (교반)
+ * @param duration 실행 시간 (초)
+ * @return true: 시작됨, false: 재고 부족 등으로 시작 실패
+ */
+bool startTimedStep(CommandType commandType, float duration) {
+    if (commandType == COMMAND_DC_MOTOR) {
+        // 교반 단계: 진동 모터만 단독으로 작동
+        acquireVibration();
+        startCommandExecution(COMMAND_DC_MOTOR, duration, SEQUENCE_NONE);
+        return true;
+    }
+    
+    Command command;
+    command.type = commandType;
+    command.value = duration;
+    command.target = COMMAND_NONE;
+    command.isQuantity = false;
+    command.sequence = SEQUENCE_NONE;  // 단계별 완료는 레시피/여러 단계 명령의 완료로 보고
+    command.isValid = true;
+    command.error = ERROR_NONE;
+    command.rawCommand[0] = '\0';
+    executeCommand(command);
+    
+    return channelStates[commandType].isExecuting;
+}
+
 /**
  * @brief 명령 실행
  * @param command 실행할 명령
  */
 void executeCommand(const Command& command) {
+    if (serialCommand.getChannelConfig(command.type) != nullptr) {
+        executeChannelCommand(command);
+        return;
+    }
+    
     switch (command.type) {
-        case COMMAND_SUGAR:
-            executeSugarCommand(command);
-            break;
-            
-        case COMMAND_WATER:
-            executeWaterCommand(command);
-            break;
-            
-        case COMMAND_COFFEE:
-            executeCoffeeCommand(command);
+        case COMMAND_RECIPE:
+            executeRecipeCommand(command);
             break;
             
-        case COMMAND_ICEDTEA:
-            executeIcedTeaCommand(command);
-            break;
-            
-        case COMMAND_GREENTEA:
-            executeGreenTeaCommand(command);
-            break;
-            
-        case COMMAND_CUP:
-            executeCupCommand(command);
+        case COMMAND_BATCH:
+            startBatch(command);
             break;
 
-        case COMMAND_DC_MOTOR: 
-            // DC 모터 명령은 재료 분배에 통합되었으므로 이 코드는 실행되지 않도록 합니다.
-            serialCommand->printError("DC Motor command is now integrated into ingredient dispensing.");
-            break;
-            
         case COMMAND_UNKNOWN:
-            serialCommand->printError("Unknown command: " + command.rawCommand);
+            serialCommand.reportCommandError(command);
             break;
             
         default:
@@ -263,125 +1049,157 @@ void executeCommand(const Command& command) {
     }
 }
 
-// 🚨 재고 상태가 "LOW" 또는 "EMPTY"일 때 중단되는 로직 적용
-
 /**
- * @brief 설탕 분배 명령 실행
- * @param command 설탕 명령
+ * @brief 분배 채널 명령 실행 (설탕, 물, 커피, 아이스티, 녹차, 컵)
+ * @param command 분배 명령
  */
-void executeSugarCommand(const Command& command) {
-    String stockState = stockSensors[0]->getStockStateString();
-
-    if (stockState == "LOW" || stockState == "EMPTY") {
-        serialCommand->printError("Sugar stock is too low to dispense!");
+void executeChannelCommand(const Command& command) {
+    const ChannelConfig& config = channelConfig(command.type);
+    const ChannelHardware& hardware = channelHardware[command.type - CHANNEL_FIRST_COMMAND];
+    uint8_t slot = command.type - CHANNEL_FIRST_COMMAND;
+    float duration = command.value;
+    
+    // 분배량 명령은 보정값으로 작동 시간을 계산한 뒤 시간 명령과 같은 범위를 확인합니다.
+    if (command.isQuantity) {
+        if (!calibration.isCalibrated(slot)) {
+            serialCommand.reportError(ERROR_NOT_CALIBRATED, command.type);
+            serialCommand.reportFailed(command.sequence, ERROR_NOT_CALIBRATED, command.type);
+            return;
+        }
+        
+        Command timedCommand = command;
+        timedCommand.value = calibration.toDuration(slot, command.value);
+        timedCommand.isQuantity = false;
+        if (!serialCommand.validateCommand(timedCommand)) {
+            serialCommand.reportCommandError(timedCommand);
+            serialCommand.reportFailed(command.sequence, timedCommand.error, command.type);
+            return;
+        }
+        duration = timedCommand.value;
+    }
+    
+    // 🚨 재고 센서가 "HIGH"(재고 없음, 레이저 빛 감지) 상태이면 분배하지 않습니다.
+    // (물 재고 확인 로직은 임시 무시 상태 유지: 플로트 스위치 채널은 checksStock = false)
+    if (config.checksStock && hardware.stock->isStockEmpty()) {
+        serialCommand.reportError(ERROR_OUT_OF_STOCK, command.type);
+        serialCommand.reportFailed(command.sequence, ERROR_OUT_OF_STOCK, command.type);
         return;
     }
     
     // DC 모터 ON
-    pumps[1]->turnOn(); 
+    if (config.needsVibration) {
+        acquireVibration();
+    }
     
-    serialCommand->printSuccess("Sugar command received: " + String(command.value) + "s");
-    startCommandExecution(COMMAND_SUGAR, command.value);
-    servoMotors[0]->setAngle(0);
+    serialCommand.reportAccepted(command.type, duration);
+    startCommandExecution(command.type, duration, command.sequence);
+    if (config.actuator == ACTUATOR_PUMP) {
+        // 펌프는 마무리 구간에서 유량을 줄여 튀지 않게 채웁니다 (정지는 타이머 인터럽트가 담당).
+        hardware.pump->runFor(channelStates[command.type].duration, WATER_PUMP_FINISH_DUTY, WATER_PUMP_FINISH_MS);
+    } else {
+        setChannelOpen(command.type, true);
+    }
+    // 분배 타이머는 채널 태스크가 게이트가 열린 뒤 시작합니다 (channelTask).
 }
 
 /**
- * @brief 물 펌핑 명령 실행
- * @param command 물 명령
+ * @brief 채널 액추에이터 열기/닫기
+ * @param commandType 분배 채널 명령 타입
+ * @param open true: 열림 각도 또는 펌프 ON, false: 닫힘 각도 또는 펌프 OFF
  */
-void executeWaterCommand(const Command& command) {
-    // --- [참고] 물 재고 확인 로직은 임시 무시 상태 유지 ---
-    // if (floatSwitches[0]->isLiquidEmpty()) { 
-    //     serialCommand->printError("Water tank is empty!");
-    //     return;
-    // }
+void setChannelOpen(CommandType commandType, bool open) {
+    const ChannelConfig& config = channelConfig(commandType);
+    const ChannelHardware& hardware = channelHardware[commandType - CHANNEL_FIRST_COMMAND];
     
-    // DC 모터 ON
-    pumps[1]->turnOn();
-
-    serialCommand->printSuccess("Water command received: " + String(command.value) + "s");
-    startCommandExecution(COMMAND_WATER, command.value);
-    pumps[0]->turnOn();
+    if (config.actuator == ACTUATOR_SERVO) {
+        hardware.servo->setAngle(open ? config.openAngle : config.closedAngle);
+    } else if (open) {
+        hardware.pump->turnOn();
+    } else {
+        hardware.pump->turnOff();
+    }
 }
 
 /**
- * @brief 커피 분배 명령 실행
- * @param command 커피 명령
+ * @brief 타이머 인터럽트의 채널 종료 처리 (인터럽트 컨텍스트, 시리얼 출력 금지)
+ * @param slot 채널 인덱스 (CHANNELS 순서)
  */
-void executeCoffeeCommand(const Command& command) {
-    String stockState = stockSensors[1]->getStockStateString();
-
-    if (stockState == "LOW" || stockState == "EMPTY") {
-        serialCommand->printError("Coffee stock is too low to dispense!");
-        return;
+void cutoffChannelFromTimer(uint8_t slot) {
+    // 펌프는 소프트 스톱 없이, 서보는 프로파일 없이 바로 닫아 종료 시각에 분배가 멈추게 합니다.
+    if (CHANNELS[slot].actuator == ACTUATOR_PUMP) {
+        channelHardware[slot].pump->cutOff();
+    } else {
+        channelHardware[slot].servo->cutOff(CHANNELS[slot].closedAngle);
     }
-    
-    // DC 모터 ON
-    pumps[1]->turnOn(); 
-
-    serialCommand->printSuccess("Coffee command received: " + String(command.value) + "s");
-    startCommandExecution(COMMAND_COFFEE, command.value);
-    servoMotors[1]->setAngle(0); 
+    channelStopMicros[slot] = micros();
 }
 
 /**
- * @brief 아이스티 분배 명령 실행
- * @param command 아이스티 명령
+ * @brief 레시피 명령 실행
+ * @param command 레시피 명령 (값: 레시피 번호)
  */
-void executeIcedTeaCommand(const Command& command) {
-    String stockState = stockSensors[2]->getStockStateString();
-
-    if (stockState == "LOW" || stockState == "EMPTY") {
-        serialCommand->printError("IcedTea stock is too low to dispense!");
+void executeRecipeCommand(const Command& command) {
+    uint8_t recipeId = (uint8_t)command.value;
+    
+    if (!recipeRunner.start(recipeId, millis())) {
+        serialCommand.reportError(ERROR_UNKNOWN_RECIPE, COMMAND_RECIPE, recipeId);
+        serialCommand.reportFailed(command.sequence, ERROR_UNKNOWN_RECIPE, COMMAND_RECIPE);
         return;
     }
     
-    // DC 모터 ON
-    pumps[1]->turnOn(); 
-
-    serialCommand->printSuccess("IcedTea command received: " + String(command.value) + "s");
-    startCommandExecution(COMMAND_ICEDTEA, command.value);
-    servoMotors[2]->setAngle(0);
+    serialCommand.reportAccepted(COMMAND_RECIPE, recipeId);
+    startSequencedRun(COMMAND_RECIPE, command.sequence);
+    updateRecipe(millis());
 }
 
 /**
- * @brief 녹차 분배 명령 실행
- * @param command 녹차 명령
+ * @brief 명령 실행 시작
+ * @param commandType 명령 타입
+ * @param duration 실행 시간 (초)
+ * @param sequence 호스트가 붙인 순서 번호 (완료 보고용)
  */
-void executeGreenTeaCommand(const Command& command) {
-    String stockState = stockSensors[3]->getStockStateString();
-
-    if (stockState == "LOW" || stockState == "EMPTY") {
-        serialCommand->printError("GreenTea stock is too low to dispense!");
-        return;
-    }
+void startCommandExecution(CommandType commandType, float duration, uint16_t sequence) {
+    ChannelState& channel = channelStates[commandType];
+    channel.isExecuting = true;
+    channel.duration = (uint32_t)(duration * 1000);
+    channel.startMicros = micros();
+    channel.sequence = sequence;
     
-    // DC 모터 ON
-    pumps[1]->turnOn(); 
+    if (serialCommand.getChannelConfig(commandType) == nullptr) {
+        // 분배 채널은 DoseTimer 가, 나머지(DC 모터 교반)는 소프트웨어 타이머가 종료 시각을 관리합니다.
+        timerWheel.schedule(TIMER_STIR, channel.duration);
+    }
+}
 
-    serialCommand->printSuccess("GreenTea command received: " + String(command.value) + "s");
-    startCommandExecution(COMMAND_GREENTEA, command.value);
-    servoMotors[3]->setAngle(0);
+/**
+ * @brief 레시피/여러 단계 명령의 완료 보고 준비 (시작 시각과 순서 번호 보관)
+ * @param commandType COMMAND_RECIPE 또는 COMMAND_BATCH
+ * @param sequence 호스트가 붙인 순서 번호
+ */
+void startSequencedRun(CommandType commandType, uint16_t sequence) {
+    channelStates[commandType].sequence = sequence;
+    channelStates[commandType].startMicros = micros();
 }
 
 /**
- * @brief 컵 디스펜서 명령 실행
- * @param command 컵 명령
+ * @brief 레시피/여러 단계 명령의 완료 또는 중단 보고 (순서 번호가 있을 때만)
+ * @param commandType COMMAND_RECIPE 또는 COMMAND_BATCH
+ * @param error ERROR_NONE: 완료 (시작부터 걸린 시간 보고), 그 외: 중단 사유
  */
-void executeCupCommand(const Command& command) {
-    serialCommand->printSuccess("Cup command received: " + String(command.value) + "s");
-    startCommandExecution(COMMAND_CUP, command.value);
-    servoMotors[4]->setAngle(180); 
+void finishSequencedRun(CommandType commandType, CommandError error) {
+    ChannelState& run = channelStates[commandType];
+    if (error == ERROR_NONE) {
+        serialCommand.reportDone(run.sequence, commandType, 0, microsToCentiseconds(micros() - run.startMicros));
+    } else {
+        serialCommand.reportFailed(run.sequence, error, commandType);
+    }
+    run.sequence = SEQUENCE_NONE;
 }
 
 /**
- * @brief 명령 실행 시작
- * @param commandType 명령 타입
- * @param duration 실행 시간 (초)
+ * @brief 마이크로초를 1/100초로 반올림 (uint16 범위로 제한)
  */
-void startCommandExecution(CommandType commandType, float duration) {
-    isCommandExecuting = true;
-    currentCommandType = commandType;
-    commandStartTime = millis();
-    commandDuration = (uint64_t)(duration * 1000);
-}
\ No newline at end of file
+uint16_t microsToCentiseconds(uint32_t durationMicros) {
+    uint32_t centiseconds = (durationMicros + 5000UL) / 10000UL;
+    return centiseconds > 0xFFFF ? 0xFFFF : (uint16_t)centiseconds;
+}
@@ -0,0 +1,126 @@
+/**
+ * @brief 여러 단계 명령 줄 파싱 단위 테스트 (env:native)
+ *
+ * ';' 로 나눈 그룹 순서, '+' 로 묶은 동시 실행 단계, 분배량 단계와
+ * 문제 단계 하나로 줄 전체를 거부하는 규칙을 확인합니다.
+ * 실행) pio test -e native -f test_batch_parse
+ */
+#include <Arduino.h>
+#include <NativeHAL.h>
+#include <SerialCommand.h>
+#include "Channels.h"
+#include <unity.h>
+#include <string.h>
+
+void setUp(void) {
+    NativeHAL::reset();
+}
+
+void tearDown(void) {
+}
+
+void test_groups_and_parallel_steps(void) {
+    SerialCommand serial(CHANNELS);
+    Command batch = serial.parseBatch("S2+W3;C1.5;U1");
+
+    TEST_ASSERT_TRUE(batch.isValid);
+    TEST_ASSERT_EQUAL(COMMAND_BATCH, batch.type);
+    TEST_ASSERT_EQUAL_FLOAT(4.0f, batch.value);
+    TEST_ASSERT_EQUAL_UINT8(4, serial.getBatchStepCount());
+
+    const uint8_t types[] = { COMMAND_SUGAR, COMMAND_WATER, COMMAND_COFFEE, COMMAND_CUP };
+    const uint8_t groups[] = { 0, 0, 1, 2 };
+    const float values[] = { 2.0f, 3.0f, 1.5f, 1.0f };
+    for (uint8_t i = 0; i < 4; i++) {
+        const BatchStep& step = serial.getBatchStep(i);
+        TEST_ASSERT_EQUAL_UINT8(types[i], step.type);
+        TEST_ASSERT_EQUAL_UINT8(groups[i], step.group);
+        TEST_ASSERT_EQUAL_FLOAT(values[i], step.value);
+        TEST_ASSERT_FALSE(step.isQuantity);
+    }
+}
+
+void test_quantity_and_stir_steps(void) {
+    SerialCommand serial(CHANNELS);
+    Command batch = serial.parseBatch("QS5 + QW120 ; D2");
+
+    TEST_ASSERT_TRUE(batch.isValid);
+    TEST_ASSERT_EQUAL_UINT8(3, serial.getBatchStepCount());
+    TEST_ASSERT_TRUE(serial.getBatchStep(0).isQuantity);
+    TEST_ASSERT_EQUAL_FLOAT(5.0f, serial.getBatchStep(0).value);
+    TEST_ASSERT_TRUE(serial.getBatchStep(1).isQuantity);
+    TEST_ASSERT_EQUAL_FLOAT(120.0f, serial.getBatchStep(1).value);
+    TEST_ASSERT_EQUAL_UINT8(COMMAND_DC_MOTOR, serial.getBatchStep(2).type);
+    TEST_ASSERT_EQUAL_UINT8(1, serial.getBatchStep(2).group);
+}
+
+void test_invalid_step_rejects_line(void) {
+    SerialCommand serial(CHANNELS);
+
+    // 최대 시간을 넘는 단계: 그 단계의 타입, 에러, 번호를 돌려주고 앞 단계도 버립니다.
+    Command batch = serial.parseBatch("S2;W99");
+    TEST_ASSERT_FALSE(batch.isValid);
+    TEST_ASSERT_EQUAL(COMMAND_WATER, batch.target);
+    TEST_ASSERT_EQUAL(ERROR_DURATION_TOO_LONG, batch.error);
+    TEST_ASSERT_EQUAL_FLOAT(2.0f, batch.value);
+    TEST_ASSERT_EQUAL_STRING("W99", batch.rawCommand);
+    TEST_ASSERT_EQUAL_UINT8(0, serial.getBatchStepCount());
+
+    batch = serial.parseBatch("S2+X1");
+    TEST_ASSERT_FALSE(batch.isValid);
+    TEST_ASSERT_EQUAL(ERROR_UNKNOWN_COMMAND, batch.error);
+    TEST_ASSERT_EQUAL_FLOAT(2.0f, batch.value);
+}
+
+void test_format_errors(void) {
+    SerialCommand serial(CHANNELS);
+
+    // 빈 단계
+    Command batch = serial.parseBatch("S2;;W1");
+    TEST_ASSERT_FALSE(batch.isValid);
+    TEST_ASSERT_EQUAL(COMMAND_BATCH, batch.target);
+    TEST_ASSERT_EQUAL(ERROR_UNKNOWN_COMMAND, batch.error);
+
+    // 분배 단계가 아닌 명령 (통계 조회)
+    batch = serial.parseBatch("S2;T");
+    TEST_ASSERT_FALSE(batch.isValid);
+    TEST_ASSERT_EQUAL(ERROR_UNSUPPORTED, batch.error);
+
+    // BATCH_MAX_STEPS 초과
+    batch = serial.parseBatch("S1;S1;S1;S1;S1;S1;S1;S1;S1");
+    TEST_ASSERT_FALSE(batch.isValid);
+    TEST_ASSERT_EQUAL(COMMAND_BATCH, batch.target);
+    TEST_ASSERT_EQUAL_FLOAT(BATCH_MAX_STEPS + 1, batch.value);
+}
+
+void test_batch_line_from_serial(void) {
+    SerialCommand serial(CHANNELS);
+    serial.begin();
+
+    // 순서 번호는 줄 전체에 붙고, 단독으로는 거부되는 진동(D) 단계도 허용됩니다.
+    NativeHAL::feedSerial("42:S1+D2;U1\n", 12);
+    Command command;
+    command.type = COMMAND_NONE;
+    for (uint16_t i = 0; i < 1000 && command.type == COMMAND_NONE; i++) {
+        NativeHAL::advanceMicros(100);
+        command = serial.readCommand();
+    }
+
+    TEST_ASSERT_EQUAL(COMMAND_BATCH, command.type);
+    TEST_ASSERT_TRUE(command.isValid);
+    TEST_ASSERT_EQUAL_UINT16(42, command.sequence);
+    TEST_ASSERT_EQUAL_UINT8(3, serial.getBatchStepCount());
+    TEST_ASSERT_EQUAL_UINT8(COMMAND_DC_MOTOR, serial.getBatchStep(1).type);
+}
+
+int main(int argc, char** argv) {
+    (void)argc;
+    (void)argv;
+    UNITY_BEGIN();
+    RUN_TEST(test_groups_and_parallel_steps);
+    RUN_TEST(test_quantity_and_stir_steps);
+    RUN_TEST(test_invalid_step_rejects_line);
+    RUN_TEST(test_format_errors);
+    RUN_TEST(test_batch_line_from_serial);
+    return UNITY_END();
+}
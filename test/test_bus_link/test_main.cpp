@@ -0,0 +1,163 @@
+/**
+ * @brief 멀티드롭 버스 수신 주소 필터 단위 테스트 (env:native)
+ *
+ * 노드 주소가 있으면 자기 주소와 방송("@*") 앞으로 온 요청만 명령으로 꺼내고,
+ * 다른 노드 앞 요청과 주소 없는 줄(다른 노드의 응답 등)은 응답 없이 버리며 세는지 확인합니다.
+ * 실행) pio test -e native -f test_bus_link
+ */
+#include <Arduino.h>
+#include <NativeHAL.h>
+#include <SerialCommand.h>
+#include "Channels.h"
+#include "Pin.h"
+#include <unity.h>
+#include <string>
+#include <vector>
+
+namespace {
+
+    std::string sent;     // 펌웨어가 선로에 내보낸 바이트
+
+    void captureByte(uint8_t c, void* context) {
+        (void)context;
+        sent.push_back((char)c);
+    }
+
+    /**
+     * @brief 바이트를 시리얼 선으로 보내고 명령이 나올 때까지 진행 (최대 100ms)
+     */
+    Command deliver(SerialCommand& serial, const uint8_t* data, size_t length) {
+        NativeHAL::feedSerial(reinterpret_cast<const char*>(data), length);
+        for (uint16_t i = 0; i < 1000; i++) {
+            Command command = serial.readCommand();
+            serial.update();
+            NativeHAL::advanceMicros(100);
+            if (command.type != COMMAND_NONE) {
+                return command;
+            }
+        }
+        Command none;
+        none.type = COMMAND_NONE;
+        return none;
+    }
+
+    Command request(SerialCommand& serial, const char* line) {
+        return deliver(serial, reinterpret_cast<const uint8_t*>(line), strlen(line));
+    }
+
+    /**
+     * @brief 페이로드에 CRC 를 붙이고 COBS 로 인코딩한 뒤 구분자까지 붙인 프레임
+     */
+    std::vector<uint8_t> makeFrame(const std::vector<uint8_t>& payload) {
+        std::vector<uint8_t> raw(payload);
+        raw.push_back(SerialCommand::crc8(payload.data(), (uint8_t)payload.size()));
+        std::vector<uint8_t> frame(raw.size() + 2);
+        uint8_t length = SerialCommand::cobsEncode(raw.data(), (uint8_t)raw.size(), frame.data());
+        frame.resize(length);
+        frame.push_back(FRAME_DELIMITER);
+        return frame;
+    }
+
+    /**
+     * @brief 1:1 연결로 노드 주소 3 을 정해 버스에 참여 (설정 응답은 버림)
+     */
+    void joinBus(SerialCommand& serial) {
+        serial.begin();
+        request(serial, "A3\n");
+        TEST_ASSERT_TRUE(serial.isMultiDrop());
+        serial.resetBusStats();
+        sent.clear();
+    }
+
+}  // namespace
+
+void setUp(void) {
+    NativeHAL::reset();
+    NativeHAL::setSerialSink(captureByte, nullptr);
+    sent.clear();
+}
+
+void tearDown(void) {
+    NativeHAL::setSerialSink(nullptr, nullptr);
+}
+
+void test_accepts_own_address_and_broadcast(void) {
+    BusLink link(Serial);
+    link.setAddress(3);
+    TEST_ASSERT_TRUE(link.isMultiDrop());
+    TEST_ASSERT_TRUE(link.accepts(3));
+    TEST_ASSERT_TRUE(link.accepts(BUS_ADDRESS_BROADCAST));
+    TEST_ASSERT_FALSE(link.accepts(4));
+
+    link.setAddress(BUS_ADDRESS_NONE);
+    TEST_ASSERT_FALSE(link.isMultiDrop());
+}
+
+void test_other_node_requests_are_filtered(void) {
+    SerialCommand serial(CHANNELS, BAUD_RATE_SERIAL, -1, PIN_BUS_ENABLE);
+    joinBus(serial);
+
+    // 다른 노드 앞 요청: 명령도 응답(에러 포함)도 없이 버립니다.
+    TEST_ASSERT_EQUAL(COMMAND_NONE, request(serial, "@5 1:S1\n").type);
+    TEST_ASSERT_EQUAL(COMMAND_NONE, request(serial, "@5 1:X\n").type);
+    TEST_ASSERT_EQUAL_UINT16(2, serial.getBusStats().filtered);
+    TEST_ASSERT_EQUAL_STRING("", sent.c_str());
+
+    Command command = request(serial, "@3 2:S1\n");
+    TEST_ASSERT_EQUAL(COMMAND_SUGAR, command.type);
+    TEST_ASSERT_EQUAL_UINT16(2, command.sequence);
+
+    command = request(serial, "@* 3:C1\n");
+    TEST_ASSERT_EQUAL(COMMAND_COFFEE, command.type);
+    TEST_ASSERT_EQUAL_UINT16(3, command.sequence);
+    TEST_ASSERT_EQUAL_UINT16(2, serial.getBusStats().filtered);
+}
+
+void test_unaddressed_lines_are_ignored(void) {
+    SerialCommand serial(CHANNELS, BAUD_RATE_SERIAL, -1, PIN_BUS_ENABLE);
+    joinBus(serial);
+
+    // 다른 노드의 응답 줄과 주소 없는 명령은 버퍼에 담지 않고 줄 끝까지 건너뜁니다.
+    TEST_ASSERT_EQUAL(COMMAND_NONE, request(serial, "#5,ACK,1\r\n").type);
+    TEST_ASSERT_EQUAL(COMMAND_NONE, request(serial, "S1\n").type);
+    TEST_ASSERT_EQUAL_UINT16(2, serial.getBusStats().filtered);
+    TEST_ASSERT_EQUAL_STRING("", sent.c_str());
+
+    // 잘못된 주소("@0", 범위 밖)는 주소 없는 줄처럼 다룹니다.
+    TEST_ASSERT_EQUAL(COMMAND_NONE, request(serial, "@0 S1\n").type);
+    TEST_ASSERT_EQUAL(COMMAND_NONE, request(serial, "@300 S1\n").type);
+    TEST_ASSERT_EQUAL_UINT16(4, serial.getBusStats().filtered);
+}
+
+void test_binary_frames_are_filtered_by_address(void) {
+    SerialCommand serial(CHANNELS, BAUD_RATE_SERIAL, -1, PIN_BUS_ENABLE);
+    joinBus(serial);
+    request(serial, "@3 B1\n");
+    TEST_ASSERT_EQUAL(PROTOCOL_BINARY, serial.getProtocolMode());
+    serial.resetBusStats();
+
+    // [주소][opcode][type][value_cs lo][value_cs hi]
+    std::vector<uint8_t> other = makeFrame({ 5, FRAME_OP_COMMAND, COMMAND_SUGAR, 100, 0 });
+    TEST_ASSERT_EQUAL(COMMAND_NONE, deliver(serial, other.data(), other.size()).type);
+    // 다른 노드의 응답 프레임 (opcode 최상위 비트)
+    std::vector<uint8_t> reply = makeFrame({ 3, FRAME_OP_ACK, 1, 0, COMMAND_SUGAR });
+    TEST_ASSERT_EQUAL(COMMAND_NONE, deliver(serial, reply.data(), reply.size()).type);
+    TEST_ASSERT_EQUAL_UINT16(2, serial.getBusStats().filtered);
+
+    std::vector<uint8_t> own = makeFrame({ 3, FRAME_OP_COMMAND, COMMAND_SUGAR, 100, 0 });
+    Command command = deliver(serial, own.data(), own.size());
+    TEST_ASSERT_EQUAL(COMMAND_SUGAR, command.type);
+    TEST_ASSERT_EQUAL_FLOAT(1.0f, command.value);
+    TEST_ASSERT_EQUAL_UINT16(2, serial.getBusStats().filtered);
+}
+
+int main(int argc, char** argv) {
+    (void)argc;
+    (void)argv;
+    UNITY_BEGIN();
+    RUN_TEST(test_accepts_own_address_and_broadcast);
+    RUN_TEST(test_other_node_requests_are_filtered);
+    RUN_TEST(test_unaddressed_lines_are_ignored);
+    RUN_TEST(test_binary_frames_are_filtered_by_address);
+    return UNITY_END();
+}
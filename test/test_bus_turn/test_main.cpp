@@ -0,0 +1,167 @@
+/**
+ * @brief 멀티드롭 버스 차례 단위 테스트 (env:native)
+ *
+ * 노드가 자기 차례의 응답을 모두 보낸 뒤에만 차례 끝 표시("#3,END")를 보내고,
+ * 그 뒤로는 다음 차례가 올 때까지 한 바이트도 보내지 않는지 확인합니다.
+ * 방송으로 통신 속도를 바꿀 때 응답이 대기열에 남아 새 속도로 나가지 않는지도 확인합니다.
+ * 실행) pio test -e native -f test_bus_turn
+ */
+#include <Arduino.h>
+#include <NativeHAL.h>
+#include <SerialCommand.h>
+#include "Channels.h"
+#include "Pin.h"
+#include <unity.h>
+#include <string>
+
+namespace {
+
+    std::string sent;     // 펌웨어가 선로에 내보낸 바이트
+
+    void captureByte(uint8_t c, void* context) {
+        (void)context;
+        sent.push_back((char)c);
+    }
+
+    /**
+     * @brief loop() 한 바퀴처럼 수신 명령을 읽고 송신을 진행한 뒤 가상 시간 100us 진행
+     */
+    Command step(SerialCommand& serial) {
+        Command command = serial.readCommand();
+        serial.update();
+        NativeHAL::advanceMicros(100);
+        return command;
+    }
+
+    void run(SerialCommand& serial, uint32_t ms) {
+        for (uint32_t i = 0; i < ms * 10; i++) {
+            step(serial);
+        }
+    }
+
+    /**
+     * @brief 요청 줄을 보내고 명령이 나올 때까지 진행
+     */
+    Command request(SerialCommand& serial, const char* line) {
+        NativeHAL::feedSerial(line, strlen(line));
+        for (uint16_t i = 0; i < 2000; i++) {
+            Command command = step(serial);
+            if (command.type != COMMAND_NONE) {
+                return command;
+            }
+        }
+        Command none;
+        none.type = COMMAND_NONE;
+        return none;
+    }
+
+    /**
+     * @brief 1:1 연결로 노드 주소 3 을 정해 버스에 참여 (설정 응답은 버림)
+     */
+    void joinBus(SerialCommand& serial) {
+        serial.begin();
+        NativeHAL::feedSerial("A3\n", 3);
+        run(serial, 200);
+        TEST_ASSERT_TRUE(serial.isMultiDrop());
+        sent.clear();
+    }
+
+    void queueLine(SerialCommand& serial, const char* text) {
+        serial.getOutput().begin(TX_LANE_EVENT).println(text);
+        serial.getOutput().end();
+    }
+
+    /**
+     * @brief 차례 끝 표시 뒤에 나간 바이트 (표시가 없으면 빈 문자열이 아니라 "-")
+     */
+    std::string afterEnd(const char* endLine) {
+        size_t position = sent.find(endLine);
+        return position == std::string::npos ? std::string("-") : sent.substr(position + strlen(endLine));
+    }
+
+}  // namespace
+
+void setUp(void) {
+    NativeHAL::reset();
+    NativeHAL::setSerialSink(captureByte, nullptr);
+    sent.clear();
+}
+
+void tearDown(void) {
+    NativeHAL::setSerialSink(nullptr, nullptr);
+}
+
+void test_end_waits_for_held_report(void) {
+    SerialCommand serial(CHANNELS, BAUD_RATE_SERIAL, -1, PIN_BUS_ENABLE);
+    joinBus(serial);
+
+    Command command = request(serial, "@3 1:T\n");
+    TEST_ASSERT_EQUAL(COMMAND_STATS, command.type);
+    serial.reportAck(command.sequence, command.type);
+    serial.holdBusTurn(true);
+
+    // 보고 줄 사이에 대기열이 비어도 차례를 끝내지 않습니다.
+    for (uint8_t i = 0; i < 3; i++) {
+        queueLine(serial, "{\"stat\":\"loop\"}");
+        run(serial, 50);
+        TEST_ASSERT_TRUE(serial.getOutput().isEmpty());
+        TEST_ASSERT_EQUAL_STRING("-", afterEnd("#3,END\r\n").c_str());
+    }
+
+    serial.holdBusTurn(false);
+    run(serial, 20);
+    TEST_ASSERT_EQUAL_STRING("", afterEnd("#3,END\r\n").c_str());
+    TEST_ASSERT_EQUAL(0, sent.find("ACK,1\r\n"));
+}
+
+void test_no_bytes_after_end(void) {
+    SerialCommand serial(CHANNELS, BAUD_RATE_SERIAL, -1, PIN_BUS_ENABLE);
+    joinBus(serial);
+
+    NativeHAL::feedSerial("@3 1:A\n", 7);
+    // 응답을 모두 하드웨어 송신 버퍼로 넘긴 직후에 쌓인 완료 보고는 차례 끝 표시 앞에 끼거나 다음 차례까지 기다립니다.
+    while (NativeHAL::getOutputLevel(PIN_BUS_ENABLE) == LOW || !serial.getOutput().isEmpty()) {
+        step(serial);
+    }
+    serial.reportDone(7, COMMAND_SUGAR, 100, 100);
+    queueLine(serial, "SUCCESS: Sugar dispensing completed");
+    run(serial, 100);
+    TEST_ASSERT_EQUAL_STRING("", afterEnd("#3,END\r\n").c_str());
+    TEST_ASSERT_EQUAL(LOW, NativeHAL::getOutputLevel(PIN_BUS_ENABLE));
+
+    // 다음 차례에 보내고 다시 차례 끝 표시로 마칩니다.
+    sent.clear();
+    request(serial, "@3 2:A\n");
+    run(serial, 100);
+    TEST_ASSERT_TRUE(sent.find("DONE,7,Sugar,100,100\r\n") != std::string::npos);
+    TEST_ASSERT_EQUAL_STRING("", afterEnd("#3,END\r\n").c_str());
+}
+
+void test_broadcast_baud_switch_leaves_no_reply(void) {
+    SerialCommand serial(CHANNELS, BAUD_RATE_SERIAL, -1, PIN_BUS_ENABLE);
+    joinBus(serial);
+
+    NativeHAL::feedSerial("@* 1:Y57600\n", 12);
+    run(serial, 50);
+    TEST_ASSERT_EQUAL_UINT32(57600, serial.getBaudRate());
+    TEST_ASSERT_TRUE(serial.getOutput().isEmpty());
+    TEST_ASSERT_EQUAL_STRING("", sent.c_str());
+
+    // 새 속도의 첫 차례에는 그 차례의 응답만 나갑니다.
+    request(serial, "@3 2:A\n");
+    run(serial, 100);
+    TEST_ASSERT_EQUAL(std::string::npos, sent.find("Baud rate"));
+    TEST_ASSERT_EQUAL(std::string::npos, sent.find("ACK,1\r\n"));
+    TEST_ASSERT_TRUE(sent.find("ACK,2\r\n") != std::string::npos);
+    TEST_ASSERT_EQUAL_STRING("", afterEnd("#3,END\r\n").c_str());
+}
+
+int main(int argc, char** argv) {
+    (void)argc;
+    (void)argv;
+    UNITY_BEGIN();
+    RUN_TEST(test_end_waits_for_held_report);
+    RUN_TEST(test_no_bytes_after_end);
+    RUN_TEST(test_broadcast_baud_switch_leaves_no_reply);
+    return UNITY_END();
+}
@@ -0,0 +1,170 @@
+/**
+ * @brief DispenseJournal 단위 테스트 (env:native)
+ *
+ * 기록 링의 쓰기 위치 복원, 링 덮어쓰기, 쓰다 끊긴 칸 건너뛰기, 스냅샷 + 이후 기록으로
+ * 누적 사용량 복원을 재부팅(새 객체의 begin())으로 확인합니다.
+ * 실행) pio test -e native -f test_dispense_journal
+ */
+#include <Arduino.h>
+#include <EEPROM.h>
+#include <NativeHAL.h>
+#include <DispenseJournal.h>
+#include <unity.h>
+
+namespace {
+
+    // 작은 링으로 덮어쓰기와 스냅샷 경계를 빠르게 지나갑니다 (기록 40칸, 스냅샷 2칸).
+    const int JOURNAL_ADDRESS = 0;
+    const uint16_t JOURNAL_SIZE = 40 * sizeof(JournalEntry);
+    const int SNAPSHOT_ADDRESS = 1024;
+    const uint16_t SNAPSHOT_SIZE = 2 * JOURNAL_SNAPSHOT_SLOT_SIZE;
+
+    DispenseJournal makeJournal() {
+        return DispenseJournal(JOURNAL_ADDRESS, JOURNAL_SIZE, SNAPSHOT_ADDRESS, SNAPSHOT_SIZE);
+    }
+
+    void drain(DispenseJournal& journal) {
+        while (journal.hasPendingWrite()) {
+            journal.update();
+        }
+    }
+
+    /**
+     * @brief 설탕 count 건 기록 (건마다 actualCs = 10, 짝수 번째는 진동 릴레이 꺼짐)
+     */
+    void recordSugar(DispenseJournal& journal, uint16_t count) {
+        for (uint16_t i = 0; i < count; i++) {
+            journal.record(COMMAND_SUGAR, 10, 10, (i % 2) == 0, i);
+            drain(journal);
+        }
+    }
+
+}  // namespace
+
+void setUp(void) {
+    NativeHAL::reset();   // EEPROM 을 지워진 상태로
+}
+
+void tearDown(void) {
+}
+
+void test_empty_eeprom_starts_fresh(void) {
+    DispenseJournal journal = makeJournal();
+    journal.begin();
+    TEST_ASSERT_EQUAL_UINT16(40, journal.getCapacity());
+    TEST_ASSERT_EQUAL_UINT16(0, journal.getEntryCount());
+    TEST_ASSERT_EQUAL_UINT8(1, journal.getBootCount());
+    TEST_ASSERT_EQUAL_UINT32(0, journal.getCounters().cycles[0]);
+}
+
+void test_head_and_counters_recovered_after_reboot(void) {
+    DispenseJournal journal = makeJournal();
+    journal.begin();
+    recordSugar(journal, 5);
+    journal.record(COMMAND_WATER, 300, 298, false, 9);
+    drain(journal);
+
+    DispenseJournal rebooted = makeJournal();
+    rebooted.begin();
+    TEST_ASSERT_EQUAL_UINT16(6, rebooted.getEntryCount());
+    TEST_ASSERT_EQUAL_UINT8(2, rebooted.getBootCount());
+    TEST_ASSERT_EQUAL_UINT32(5, rebooted.getCounters().cycles[0]);
+    TEST_ASSERT_EQUAL_UINT32(50, rebooted.getCounters().onTimeCs[0]);
+    TEST_ASSERT_EQUAL_UINT32(1, rebooted.getCounters().cycles[1]);
+    TEST_ASSERT_EQUAL_UINT32(298, rebooted.getCounters().onTimeCs[1]);
+    TEST_ASSERT_EQUAL_UINT32(3, rebooted.getCounters().vibrationCycles);
+
+    // 다음 기록은 이어지는 일련번호로 가장 최근 칸에 들어갑니다.
+    rebooted.record(COMMAND_CUP, 150, 150, false, 1);
+    drain(rebooted);
+    JournalEntry newest;
+    TEST_ASSERT_TRUE(rebooted.readEntry(rebooted.getCapacity() - 1, newest));
+    TEST_ASSERT_EQUAL_UINT32(7, newest.sequence);
+    TEST_ASSERT_EQUAL_UINT8(2, newest.bootCount);
+}
+
+void test_ring_wraps_and_snapshot_restores_counters(void) {
+    // 링(40칸)을 두 바퀴 넘게 돌아 스냅샷 이전 기록이 지워져도 누적 사용량은 유지됩니다.
+    DispenseJournal journal = makeJournal();
+    journal.begin();
+    recordSugar(journal, 100);
+
+    DispenseJournal rebooted = makeJournal();
+    rebooted.begin();
+    TEST_ASSERT_EQUAL_UINT16(40, rebooted.getEntryCount());
+    TEST_ASSERT_EQUAL_UINT32(100, rebooted.getCounters().cycles[0]);
+    TEST_ASSERT_EQUAL_UINT32(1000, rebooted.getCounters().onTimeCs[0]);
+    TEST_ASSERT_EQUAL_UINT32(50, rebooted.getCounters().vibrationCycles);
+
+    JournalEntry oldest;
+    JournalEntry newest;
+    TEST_ASSERT_TRUE(rebooted.readEntry(0, oldest));
+    TEST_ASSERT_TRUE(rebooted.readEntry(rebooted.getCapacity() - 1, newest));
+    TEST_ASSERT_EQUAL_UINT32(61, oldest.sequence);
+    TEST_ASSERT_EQUAL_UINT32(100, newest.sequence);
+}
+
+void test_torn_entry_is_skipped(void) {
+    DispenseJournal journal = makeJournal();
+    journal.begin();
+    recordSugar(journal, 3);
+
+    // 네 번째 기록을 절반만 쓰고 전원이 꺼짐
+    journal.record(COMMAND_SUGAR, 10, 10, false, 3);
+    for (uint8_t i = 0; i < sizeof(JournalEntry) / 2; i++) {
+        journal.update();
+    }
+
+    DispenseJournal rebooted = makeJournal();
+    rebooted.begin();
+    TEST_ASSERT_EQUAL_UINT16(3, rebooted.getEntryCount());
+    TEST_ASSERT_EQUAL_UINT32(3, rebooted.getCounters().cycles[0]);
+
+    // 끊긴 칸을 덮어쓰며 이어갑니다.
+    rebooted.record(COMMAND_SUGAR, 10, 10, false, 0);
+    drain(rebooted);
+    DispenseJournal again = makeJournal();
+    again.begin();
+    TEST_ASSERT_EQUAL_UINT16(4, again.getEntryCount());
+    TEST_ASSERT_EQUAL_UINT32(4, again.getCounters().cycles[0]);
+}
+
+void test_queued_records_drain_without_blocking(void) {
+    DispenseJournal journal = makeJournal();
+    journal.begin();
+
+    // 쓰기 대기열을 넘지 않는 만큼은 record() 가 EEPROM 에 쓰지 않습니다.
+    unsigned long writesBefore = EEPROM.getWriteCount();
+    for (uint8_t i = 0; i < JOURNAL_PENDING_SIZE; i++) {
+        journal.record(COMMAND_COFFEE, 20, 21, false, i);
+    }
+    TEST_ASSERT_EQUAL_UINT32(writesBefore, EEPROM.getWriteCount());
+    TEST_ASSERT_TRUE(journal.hasPendingWrite());
+
+    // 아직 쓰이지 않은 기록도 조회에는 보입니다.
+    JournalEntry newest;
+    TEST_ASSERT_TRUE(journal.readEntry(journal.getCapacity() - 1, newest));
+    TEST_ASSERT_EQUAL_UINT32(JOURNAL_PENDING_SIZE, newest.sequence);
+
+    // update() 한 번에 한 바이트씩
+    journal.update();
+    TEST_ASSERT_EQUAL_UINT32(writesBefore + 1, EEPROM.getWriteCount());
+    drain(journal);
+
+    DispenseJournal rebooted = makeJournal();
+    rebooted.begin();
+    TEST_ASSERT_EQUAL_UINT16(JOURNAL_PENDING_SIZE, rebooted.getEntryCount());
+    TEST_ASSERT_EQUAL_UINT32(JOURNAL_PENDING_SIZE * 21, rebooted.getCounters().onTimeCs[2]);
+}
+
+int main(int argc, char** argv) {
+    (void)argc;
+    (void)argv;
+    UNITY_BEGIN();
+    RUN_TEST(test_empty_eeprom_starts_fresh);
+    RUN_TEST(test_head_and_counters_recovered_after_reboot);
+    RUN_TEST(test_ring_wraps_and_snapshot_restores_counters);
+    RUN_TEST(test_torn_entry_is_skipped);
+    RUN_TEST(test_queued_records_drain_without_blocking);
+    return UNITY_END();
+}
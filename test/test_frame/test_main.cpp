@@ -0,0 +1,182 @@
+/**
+ * @brief 바이너리 프레임(COBS + CRC-8) 단위 테스트 (env:native)
+ *
+ * CRC-8/COBS 기본 동작과, 시리얼 선으로 들어온 프레임의 해석 및 응답 프레임 형식을 확인합니다.
+ * 실행) pio test -e native -f test_frame
+ */
+#include <Arduino.h>
+#include <NativeHAL.h>
+#include <SerialCommand.h>
+#include "Channels.h"
+#include <unity.h>
+#include <vector>
+
+namespace {
+
+    std::vector<uint8_t> sent;     // 펌웨어가 시리얼로 보낸 바이트
+
+    void captureByte(uint8_t c, void* context) {
+        (void)context;
+        sent.push_back(c);
+    }
+
+    /**
+     * @brief 페이로드에 CRC 를 붙이고 COBS 로 인코딩한 뒤 구분자까지 붙인 프레임
+     */
+    std::vector<uint8_t> makeFrame(const std::vector<uint8_t>& payload) {
+        std::vector<uint8_t> raw(payload);
+        raw.push_back(SerialCommand::crc8(payload.data(), (uint8_t)payload.size()));
+        std::vector<uint8_t> frame(raw.size() + 2);
+        uint8_t length = SerialCommand::cobsEncode(raw.data(), (uint8_t)raw.size(), frame.data());
+        frame.resize(length);
+        frame.push_back(FRAME_DELIMITER);
+        return frame;
+    }
+
+    /**
+     * @brief 바이트를 시리얼 선으로 보내고 명령이 나올 때까지 읽기 (도착 시간만큼 가상 시간 진행)
+     */
+    Command deliver(SerialCommand& serial, const uint8_t* data, size_t length) {
+        NativeHAL::feedSerial(reinterpret_cast<const char*>(data), length);
+        for (uint16_t i = 0; i < 1000; i++) {
+            NativeHAL::advanceMicros(100);
+            Command command = serial.readCommand();
+            if (command.type != COMMAND_NONE) {
+                return command;
+            }
+        }
+        Command none;
+        none.type = COMMAND_NONE;
+        return none;
+    }
+
+    /**
+     * @brief 응답 대기열을 모두 내보내고 마지막 바이트가 선로를 떠날 때까지 기다리기
+     */
+    void transmit(SerialCommand& serial) {
+        do {
+            serial.update();
+            Serial.flush();
+        } while (!serial.getOutput().isEmpty());
+    }
+
+    void enterBinaryMode(SerialCommand& serial) {
+        const char line[] = "B1\n";
+        deliver(serial, reinterpret_cast<const uint8_t*>(line), sizeof(line) - 1);
+        transmit(serial);
+        sent.clear();
+    }
+
+}  // namespace
+
+void setUp(void) {
+    NativeHAL::reset();
+    NativeHAL::setSerialSink(captureByte, nullptr);
+    sent.clear();
+}
+
+void tearDown(void) {
+    NativeHAL::setSerialSink(nullptr, nullptr);
+}
+
+void test_crc8_check_value(void) {
+    // CRC-8 (다항식 0x07, 초기값 0x00) 의 표준 확인값
+    const uint8_t data[] = { '1', '2', '3', '4', '5', '6', '7', '8', '9' };
+    TEST_ASSERT_EQUAL_HEX8(0xF4, SerialCommand::crc8(data, sizeof(data)));
+    TEST_ASSERT_EQUAL_HEX8(0x00, SerialCommand::crc8(data, 0));
+}
+
+void test_cobs_encode_removes_zeros(void) {
+    const uint8_t input[] = { 0x11, 0x22, 0x00, 0x33 };
+    const uint8_t expected[] = { 0x03, 0x11, 0x22, 0x02, 0x33 };
+    uint8_t output[8];
+    TEST_ASSERT_EQUAL_UINT8(sizeof(expected), SerialCommand::cobsEncode(input, sizeof(input), output));
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, output, sizeof(expected));
+
+    const uint8_t zeros[] = { 0x00, 0x00 };
+    const uint8_t expectedZeros[] = { 0x01, 0x01, 0x01 };
+    TEST_ASSERT_EQUAL_UINT8(sizeof(expectedZeros), SerialCommand::cobsEncode(zeros, sizeof(zeros), output));
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(expectedZeros, output, sizeof(expectedZeros));
+}
+
+void test_cobs_round_trip(void) {
+    uint8_t input[FRAME_MAX_PAYLOAD + 1];
+    for (uint8_t i = 0; i < sizeof(input); i++) {
+        input[i] = (uint8_t)((i % 3 == 0) ? 0x00 : i * 37);
+    }
+    uint8_t encoded[sizeof(input) + 2];
+    uint8_t decoded[sizeof(encoded)];
+    uint8_t length = SerialCommand::cobsEncode(input, sizeof(input), encoded);
+    for (uint8_t i = 0; i < length; i++) {
+        TEST_ASSERT_TRUE(encoded[i] != FRAME_DELIMITER);
+    }
+    TEST_ASSERT_EQUAL_UINT8(sizeof(input), SerialCommand::cobsDecode(encoded, length, decoded));
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(input, decoded, sizeof(input));
+}
+
+void test_cobs_decode_rejects_overrun(void) {
+    // 코드 바이트가 남은 길이보다 멀리 가리키면 형식 오류
+    const uint8_t broken[] = { 0x05, 0x11, 0x22 };
+    uint8_t output[8];
+    TEST_ASSERT_EQUAL_UINT8(0, SerialCommand::cobsDecode(broken, sizeof(broken), output));
+}
+
+void test_command_frame_is_parsed(void) {
+    SerialCommand serial(CHANNELS);
+    serial.begin();
+    enterBinaryMode(serial);
+    TEST_ASSERT_EQUAL(PROTOCOL_BINARY, serial.getProtocolMode());
+
+    // 설탕 2.50초, 순서 번호 0x0102 (값 바이트에 0x00 이 있어 COBS 코드가 필요)
+    std::vector<uint8_t> frame = makeFrame({ FRAME_OP_COMMAND, COMMAND_SUGAR, 250, 0x00, 0x02, 0x01 });
+    Command command = deliver(serial, frame.data(), frame.size());
+    TEST_ASSERT_EQUAL(COMMAND_SUGAR, command.type);
+    TEST_ASSERT_TRUE(command.isValid);
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 2.5f, command.value);
+    TEST_ASSERT_EQUAL_HEX16(0x0102, command.sequence);
+}
+
+void test_corrupted_frame_is_reported(void) {
+    SerialCommand serial(CHANNELS);
+    serial.begin();
+    enterBinaryMode(serial);
+
+    std::vector<uint8_t> frame = makeFrame({ FRAME_OP_COMMAND, COMMAND_WATER, 100, 0x00 });
+    frame[2] ^= 0x40;   // 전송 중 비트 하나가 바뀜
+    Command command = deliver(serial, frame.data(), frame.size());
+    TEST_ASSERT_EQUAL(COMMAND_UNKNOWN, command.type);
+    TEST_ASSERT_EQUAL(ERROR_BAD_FRAME, command.error);
+    TEST_ASSERT_FALSE(command.isValid);
+}
+
+void test_response_frame_round_trip(void) {
+    SerialCommand serial(CHANNELS);
+    serial.begin();
+    enterBinaryMode(serial);
+
+    serial.reportAck(0x0203, COMMAND_COFFEE);
+    transmit(serial);
+    TEST_ASSERT_TRUE(sent.size() > 1);
+    TEST_ASSERT_EQUAL_HEX8(FRAME_DELIMITER, sent.back());
+
+    uint8_t decoded[FRAME_MAX_ENCODED];
+    uint8_t length = SerialCommand::cobsDecode(sent.data(), (uint8_t)(sent.size() - 1), decoded);
+    const uint8_t expected[] = { FRAME_OP_ACK, 0x03, 0x02, COMMAND_COFFEE };
+    TEST_ASSERT_EQUAL_UINT8(sizeof(expected) + 1, length);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, decoded, sizeof(expected));
+    TEST_ASSERT_EQUAL_HEX8(SerialCommand::crc8(decoded, sizeof(expected)), decoded[sizeof(expected)]);
+}
+
+int main(int argc, char** argv) {
+    (void)argc;
+    (void)argv;
+    UNITY_BEGIN();
+    RUN_TEST(test_crc8_check_value);
+    RUN_TEST(test_cobs_encode_removes_zeros);
+    RUN_TEST(test_cobs_round_trip);
+    RUN_TEST(test_cobs_decode_rejects_overrun);
+    RUN_TEST(test_command_frame_is_parsed);
+    RUN_TEST(test_corrupted_frame_is_reported);
+    RUN_TEST(test_response_frame_round_trip);
+    return UNITY_END();
+}
@@ -0,0 +1,176 @@
+/**
+ * @brief TaskScheduler 단위 테스트 (env:native)
+ *
+ * 코루틴 매크로의 양보/조건 대기/이벤트 대기 재개 위치와 실행 시간 통계를 확인합니다.
+ * 실행) pio test -e native -f test_task_scheduler
+ */
+#include <Arduino.h>
+#include <NativeHAL.h>
+#include <TaskScheduler.h>
+#include <unity.h>
+
+namespace {
+
+    // 태스크 함수는 반환했다가 이어서 실행되므로 진행 상황을 전역에 남깁니다.
+    uint8_t yieldSteps = 0;
+    bool waitCondition = false;
+    uint8_t waitPassed = 0;
+    uint8_t eventRuns = 0;
+    uint16_t lastEvents = 0;
+    unsigned long busyMicros = 0;
+
+    void yieldTask(Task& task) {
+        TASK_BEGIN(task);
+        yieldSteps = 1;
+        TASK_YIELD(task);
+        yieldSteps = 2;
+        TASK_YIELD(task);
+        yieldSteps = 3;
+        TASK_END(task);
+    }
+
+    void waitTask(Task& task) {
+        TASK_BEGIN(task);
+        while (true) {
+            TASK_WAIT_UNTIL(task, waitCondition);
+            waitCondition = false;
+            waitPassed++;
+        }
+        TASK_END(task);
+    }
+
+    void eventTask(Task& task) {
+        TASK_BEGIN(task);
+        while (true) {
+            TASK_WAIT_EVENT(task, 0x0004);
+            eventRuns++;
+            lastEvents = task.events;
+        }
+        TASK_END(task);
+    }
+
+    void busyTask(Task& task) {
+        (void)task;
+        NativeHAL::advanceMicros(busyMicros);
+    }
+
+}  // namespace
+
+void setUp(void) {
+    NativeHAL::reset();
+    yieldSteps = 0;
+    waitCondition = false;
+    waitPassed = 0;
+    eventRuns = 0;
+    lastEvents = 0;
+    busyMicros = 0;
+}
+
+void tearDown(void) {
+}
+
+void test_yield_resumes_after_each_yield_point(void) {
+    TaskScheduler scheduler;
+    scheduler.add(yieldTask, "yield", 1000);
+
+    scheduler.run(0);
+    TEST_ASSERT_EQUAL_UINT8(1, yieldSteps);
+    scheduler.run(0);
+    TEST_ASSERT_EQUAL_UINT8(2, yieldSteps);
+    scheduler.run(0);
+    TEST_ASSERT_EQUAL_UINT8(3, yieldSteps);
+    TEST_ASSERT_EQUAL_UINT16(0, scheduler.getTask(0).resumePoint);
+
+    // TASK_END 뒤에는 처음부터 다시 실행합니다.
+    scheduler.run(0);
+    TEST_ASSERT_EQUAL_UINT8(1, yieldSteps);
+}
+
+void test_wait_until_blocks_until_condition(void) {
+    TaskScheduler scheduler;
+    scheduler.add(waitTask, "wait", 1000);
+
+    scheduler.run(0);
+    scheduler.run(0);
+    TEST_ASSERT_EQUAL_UINT8(0, waitPassed);
+
+    waitCondition = true;
+    scheduler.run(0);
+    TEST_ASSERT_EQUAL_UINT8(1, waitPassed);
+    TEST_ASSERT_FALSE(waitCondition);
+
+    // 조건을 다시 기다리는 동안에는 진행하지 않습니다.
+    scheduler.run(0);
+    TEST_ASSERT_EQUAL_UINT8(1, waitPassed);
+}
+
+void test_wait_event_runs_only_when_event_is_due(void) {
+    TaskScheduler scheduler;
+    scheduler.add(eventTask, "event", 1000);
+
+    scheduler.run(0);              // 첫 실행에서 대기 지점에 들어감
+    TEST_ASSERT_EQUAL_UINT16(0x0004, scheduler.getTask(0).waitEvents);
+
+    scheduler.run(0x0003);         // 다른 이벤트만 있으면 호출되지 않음
+    TEST_ASSERT_EQUAL_UINT8(0, eventRuns);
+
+    scheduler.run(0x0005);
+    TEST_ASSERT_EQUAL_UINT8(1, eventRuns);
+    TEST_ASSERT_EQUAL_HEX16(0x0005, lastEvents);
+    TEST_ASSERT_EQUAL_UINT16(0x0004, scheduler.getTask(0).waitEvents);  // 다시 대기
+
+    scheduler.run(0);
+    TEST_ASSERT_EQUAL_UINT8(1, eventRuns);
+}
+
+void test_tasks_run_in_registration_order_with_args(void) {
+    TaskScheduler scheduler;
+    TEST_ASSERT_EQUAL_INT8(0, scheduler.add(yieldTask, "first", 1000));
+    TEST_ASSERT_EQUAL_INT8(1, scheduler.add(waitTask, "second", 1000, 7));
+    TEST_ASSERT_EQUAL_UINT8(2, scheduler.getTaskCount());
+    TEST_ASSERT_EQUAL_UINT8(7, scheduler.getTask(1).arg);
+    TEST_ASSERT_EQUAL_STRING("second", scheduler.getTask(1).name);
+}
+
+void test_add_rejects_when_full(void) {
+    TaskScheduler scheduler;
+    for (uint8_t i = 0; i < TASK_SCHEDULER_MAX_TASKS; i++) {
+        TEST_ASSERT_EQUAL_INT8(i, scheduler.add(busyTask, "busy", 1000));
+    }
+    TEST_ASSERT_EQUAL_INT8(-1, scheduler.add(busyTask, "extra", 1000));
+    TEST_ASSERT_EQUAL_INT8(-1, TaskScheduler().add(nullptr, "null", 1000));
+}
+
+void test_overrun_statistics(void) {
+    TaskScheduler scheduler;
+    scheduler.add(busyTask, "busy", 500);
+
+    busyMicros = 300;
+    scheduler.run(0);
+    TEST_ASSERT_EQUAL_UINT32(300, scheduler.getTask(0).maxRunMicros);
+    TEST_ASSERT_EQUAL_UINT16(0, scheduler.getTask(0).overruns);
+
+    busyMicros = 800;
+    scheduler.run(0);
+    busyMicros = 600;
+    scheduler.run(0);
+    TEST_ASSERT_EQUAL_UINT32(800, scheduler.getTask(0).maxRunMicros);
+    TEST_ASSERT_EQUAL_UINT16(2, scheduler.getTask(0).overruns);
+
+    scheduler.resetStats();
+    TEST_ASSERT_EQUAL_UINT32(0, scheduler.getTask(0).maxRunMicros);
+    TEST_ASSERT_EQUAL_UINT16(0, scheduler.getTask(0).overruns);
+}
+
+int main(int argc, char** argv) {
+    (void)argc;
+    (void)argv;
+    UNITY_BEGIN();
+    RUN_TEST(test_yield_resumes_after_each_yield_point);
+    RUN_TEST(test_wait_until_blocks_until_condition);
+    RUN_TEST(test_wait_event_runs_only_when_event_is_due);
+    RUN_TEST(test_tasks_run_in_registration_order_with_args);
+    RUN_TEST(test_add_rejects_when_full);
+    RUN_TEST(test_overrun_statistics);
+    return UNITY_END();
+}
@@ -0,0 +1,106 @@
+/**
+ * @brief TimerWheel 단위 테스트 (env:native)
+ *
+ * millis() 가 32비트에서 0으로 돌아가는 구간(약 49.7일)을 지나도 만기 판정, 주기 위상,
+ * 가장 이른 만기 선택이 맞는지 확인합니다. 시각은 poll() 인자로 직접 넣습니다.
+ * 실행) pio test -e native -f test_timer_wheel
+ */
+#include <Arduino.h>
+#include <TimerWheel.h>
+#include <unity.h>
+
+namespace {
+
+    const uint32_t BEFORE_ROLLOVER = 0xFFFFFF00UL;   // 오버플로 256ms 전
+
+}  // namespace
+
+void setUp(void) {
+}
+
+void tearDown(void) {
+}
+
+void test_one_shot_across_rollover(void) {
+    TimerWheel wheel;
+    wheel.begin(BEFORE_ROLLOVER);
+    wheel.schedule(0, 0x200);                       // 만기: 0x00000100 (오버플로 뒤)
+    TEST_ASSERT_EQUAL_HEX16(0, wheel.poll(0xFFFFFFF0UL));
+    TEST_ASSERT_EQUAL_HEX16(0, wheel.poll(0x000000FFUL));
+    TEST_ASSERT_EQUAL_HEX16(TIMER_EVENT(0), wheel.poll(0x00000100UL));
+    TEST_ASSERT_FALSE(wheel.isScheduled(0));
+    TEST_ASSERT_EQUAL_HEX16(0, wheel.poll(0x00000200UL));
+}
+
+void test_periodic_keeps_phase_across_rollover(void) {
+    TimerWheel wheel;
+    wheel.begin(0xFFFFFF9CUL);                      // 오버플로 100ms 전
+    wheel.schedulePeriodic(3, 50);
+
+    TEST_ASSERT_EQUAL_HEX16(TIMER_EVENT(3), wheel.poll(0xFFFFFFCEUL));   // 1ms 늦게 확인
+    TEST_ASSERT_EQUAL_UINT32(0x00000000UL, wheel.getDeadline(3));        // 위상 유지
+    TEST_ASSERT_EQUAL_HEX16(0, wheel.poll(0xFFFFFFFFUL));
+    TEST_ASSERT_EQUAL_HEX16(TIMER_EVENT(3), wheel.poll(0x00000000UL));
+    TEST_ASSERT_EQUAL_UINT32(50, wheel.getDeadline(3));
+    TEST_ASSERT_TRUE(wheel.isScheduled(3));
+}
+
+void test_late_periodic_restarts_from_now(void) {
+    TimerWheel wheel;
+    wheel.begin(BEFORE_ROLLOVER);
+    wheel.schedulePeriodic(1, 10);
+
+    // 여러 주기를 놓치면 밀린 횟수만큼 몰아서 만기되지 않고 지금부터 다시 셉니다.
+    TEST_ASSERT_EQUAL_HEX16(TIMER_EVENT(1), wheel.poll(0x00000010UL));
+    TEST_ASSERT_EQUAL_UINT32(0x0000001AUL, wheel.getDeadline(1));
+    TEST_ASSERT_EQUAL_HEX16(0, wheel.poll(0x00000011UL));
+}
+
+void test_nearest_deadline_across_rollover(void) {
+    TimerWheel wheel;
+    wheel.begin(BEFORE_ROLLOVER);
+    wheel.scheduleAt(5, 0x00000010UL);              // 부호 없는 값은 작지만 더 늦은 만기
+    wheel.scheduleAt(6, 0xFFFFFFF0UL);              // 먼저 만기
+
+    TEST_ASSERT_EQUAL_HEX16(TIMER_EVENT(6), wheel.poll(0xFFFFFFF0UL));
+    TEST_ASSERT_TRUE(wheel.isScheduled(5));
+    TEST_ASSERT_EQUAL_HEX16(0, wheel.poll(0x0000000FUL));
+    TEST_ASSERT_EQUAL_HEX16(TIMER_EVENT(5), wheel.poll(0x00000010UL));
+}
+
+void test_several_slots_due_together(void) {
+    TimerWheel wheel;
+    wheel.begin(BEFORE_ROLLOVER);
+    wheel.schedule(2, 0x100);                       // 만기: 0x00000000
+    wheel.schedule(4, 0x100);
+    wheel.schedule(7, 0x180);
+    TEST_ASSERT_EQUAL_HEX16(TIMER_EVENT(2) | TIMER_EVENT(4), wheel.poll(0x00000000UL));
+    TEST_ASSERT_EQUAL_HEX16(TIMER_EVENT(7), wheel.poll(0x00000080UL));
+}
+
+void test_cancel_and_invalid_slot(void) {
+    TimerWheel wheel;
+    wheel.begin(BEFORE_ROLLOVER);
+    wheel.schedule(0, 0x200);
+    wheel.cancel(0);
+    TEST_ASSERT_FALSE(wheel.isScheduled(0));
+    TEST_ASSERT_EQUAL_HEX16(0, wheel.poll(0x00001000UL));
+
+    wheel.schedule(TIMER_WHEEL_SLOTS, 1);           // 범위 밖 슬롯은 무시
+    wheel.schedulePeriodic(0, 0);                   // 주기 0 은 무시
+    TEST_ASSERT_FALSE(wheel.isScheduled(0));
+    TEST_ASSERT_EQUAL_HEX16(0, wheel.poll(0x00002000UL));
+}
+
+int main(int argc, char** argv) {
+    (void)argc;
+    (void)argv;
+    UNITY_BEGIN();
+    RUN_TEST(test_one_shot_across_rollover);
+    RUN_TEST(test_periodic_keeps_phase_across_rollover);
+    RUN_TEST(test_late_periodic_restarts_from_now);
+    RUN_TEST(test_nearest_deadline_across_rollover);
+    RUN_TEST(test_several_slots_due_together);
+    RUN_TEST(test_cancel_and_invalid_slot);
+    return UNITY_END();
+}
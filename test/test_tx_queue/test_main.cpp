@@ -0,0 +1,183 @@
+/**
+ * @brief 송신 대기열(TxQueue) 단위 테스트 (env:native)
+ *
+ * 우선순위별 대기열의 전송 순서, 메시지 단위 전송과 버림, 예약 자리(ACK/NAK/DONE/FAIL),
+ * 송신 멈춤을 확인합니다. 하드웨어 송신 버퍼 대신 남은 자리를 정할 수 있는 포트에 보냅니다.
+ * 실행) pio test -e native -f test_tx_queue
+ */
+#include <Arduino.h>
+#include <TxQueue.h>
+#include <unity.h>
+#include <string>
+
+namespace {
+
+    /**
+     * @brief 보낸 바이트를 모으는 송신 포트 (availableForWrite() 는 space)
+     */
+    class CapturePort : public Print {
+    public:
+        std::string sent;
+        int space = 64;
+
+        size_t write(uint8_t c) override {
+            sent.push_back((char)c);
+            return 1;
+        }
+        using Print::write;
+
+        int availableForWrite() override {
+            return space;
+        }
+    };
+
+    void queueLine(TxQueue& queue, TxLane lane, const char* text, bool reserved = false) {
+        queue.begin(lane, reserved).println(text);
+        queue.end();
+    }
+
+    /**
+     * @brief 대기열이 빌 때까지 송신 (매번 포트 자리만큼)
+     */
+    void drain(TxQueue& queue) {
+        for (uint16_t i = 0; i < 1000 && !queue.isEmpty(); i++) {
+            queue.update();
+        }
+    }
+
+}  // namespace
+
+void setUp(void) {
+}
+
+void tearDown(void) {
+}
+
+void test_event_lane_goes_first(void) {
+    CapturePort port;
+    TxQueue queue(port);
+
+    queueLine(queue, TX_LANE_TELEMETRY, "{\"sugar\":\"LOW\"}");
+    queueLine(queue, TX_LANE_EVENT, "ACK,1");
+    drain(queue);
+
+    TEST_ASSERT_EQUAL_STRING("ACK,1\r\n{\"sugar\":\"LOW\"}\r\n", port.sent.c_str());
+    TEST_ASSERT_EQUAL_UINT16(1, queue.getStats(TX_LANE_TELEMETRY).deferred);
+}
+
+void test_messages_are_not_interleaved(void) {
+    CapturePort port;
+    TxQueue queue(port);
+    port.space = 4;
+
+    // 보내는 중인 텔레메트리를 끝낸 뒤에 응답을 보냅니다.
+    queueLine(queue, TX_LANE_TELEMETRY, "{\"water\":\"HIGH\"}");
+    queue.update();
+    queueLine(queue, TX_LANE_EVENT, "ACK,2");
+    drain(queue);
+
+    TEST_ASSERT_EQUAL_STRING("{\"water\":\"HIGH\"}\r\nACK,2\r\n", port.sent.c_str());
+}
+
+void test_long_message_spans_chunks(void) {
+    CapturePort port;
+    TxQueue queue(port);
+
+    std::string line(300, 'x');
+    queueLine(queue, TX_LANE_EVENT, line.c_str());
+    TEST_ASSERT_EQUAL_UINT16(TX_QUEUE_EVENT_SIZE - TX_QUEUE_EVENT_RESERVE - 300 - 2 - 3, queue.getFree(TX_LANE_EVENT));
+    drain(queue);
+
+    TEST_ASSERT_EQUAL_STRING((line + "\r\n").c_str(), port.sent.c_str());
+}
+
+void test_full_lane_drops_whole_messages(void) {
+    CapturePort port;
+    TxQueue queue(port);
+    queue.setPaused(true);
+
+    // 헤더 1 + 18바이트 줄: 256바이트 텔레메트리 대기열에 13개까지 들어갑니다.
+    for (uint8_t i = 0; i < 16; i++) {
+        queueLine(queue, TX_LANE_TELEMETRY, "{\"coffee\":\"LOW\"}");
+    }
+    TEST_ASSERT_EQUAL_UINT16(3, queue.getStats(TX_LANE_TELEMETRY).dropped);
+    TEST_ASSERT_EQUAL_STRING("", port.sent.c_str());
+
+    queue.setPaused(false);
+    drain(queue);
+    std::string expected;
+    for (uint8_t i = 0; i < 13; i++) {
+        expected += "{\"coffee\":\"LOW\"}\r\n";
+    }
+    TEST_ASSERT_EQUAL_STRING(expected.c_str(), port.sent.c_str());
+}
+
+void test_reserved_room_keeps_acks(void) {
+    CapturePort port;
+    TxQueue queue(port);
+    queue.setPaused(true);
+
+    // 일반 메시지는 예약 자리 앞에서 버려지고, 예약 메시지는 그 자리에 들어갑니다.
+    std::string report(60, 'r');
+    while (queue.getStats(TX_LANE_EVENT).dropped == 0) {
+        queueLine(queue, TX_LANE_EVENT, report.c_str());
+    }
+    TEST_ASSERT_TRUE(queue.getFree(TX_LANE_EVENT) < report.size() + 3);
+
+    for (uint8_t i = 0; i < 5; i++) {
+        queueLine(queue, TX_LANE_EVENT, "DONE,12345,GreenTea,1000,1000", true);
+    }
+    TEST_ASSERT_EQUAL_UINT16(0, queue.getStats(TX_LANE_EVENT).lost);
+
+    queue.setPaused(false);
+    drain(queue);
+    std::string tail = port.sent.substr(port.sent.size() - 5 * 31);
+    for (uint8_t i = 0; i < 5; i++) {
+        TEST_ASSERT_EQUAL_STRING("DONE,12345,GreenTea,1000,1000\r\n", tail.substr(i * 31, 31).c_str());
+    }
+}
+
+void test_reserved_messages_lost_when_reserve_full(void) {
+    CapturePort port;
+    TxQueue queue(port);
+    queue.setPaused(true);
+
+    while (queue.getStats(TX_LANE_EVENT).lost == 0) {
+        queueLine(queue, TX_LANE_EVENT, "FAIL,7,Water,12", true);
+    }
+    TEST_ASSERT_EQUAL_UINT16(0, queue.getStats(TX_LANE_EVENT).dropped);
+    TEST_ASSERT_EQUAL_UINT16(0, queue.getFree(TX_LANE_EVENT));
+
+    queue.resetStats();
+    TEST_ASSERT_EQUAL_UINT16(0, queue.getStats(TX_LANE_EVENT).lost);
+}
+
+void test_paused_queue_holds_output(void) {
+    CapturePort port;
+    TxQueue queue(port);
+
+    queue.setPaused(true);
+    queueLine(queue, TX_LANE_EVENT, "ACK,3");
+    queue.update();
+    TEST_ASSERT_EQUAL_STRING("", port.sent.c_str());
+    TEST_ASSERT_FALSE(queue.isEmpty());
+
+    queue.setPaused(false);
+    queue.update();
+    TEST_ASSERT_EQUAL_STRING("ACK,3\r\n", port.sent.c_str());
+    TEST_ASSERT_TRUE(queue.isEmpty());
+}
+
+int main(int argc, char** argv) {
+    (void)argc;
+    (void)argv;
+    UNITY_BEGIN();
+    RUN_TEST(test_event_lane_goes_first);
+    RUN_TEST(test_messages_are_not_interleaved);
+    RUN_TEST(test_long_message_spans_chunks);
+    RUN_TEST(test_full_lane_drops_whole_messages);
+    RUN_TEST(test_reserved_room_keeps_acks);
+    RUN_TEST(test_reserved_messages_lost_when_reserve_full);
+    RUN_TEST(test_paused_queue_holds_output);
+    return UNITY_END();
+}